@@ -0,0 +1,94 @@
+#version 420 core
+
+layout(location = 0) out vec4 FragColor;
+layout(location = 0) in vec2 TexCoords;
+
+layout(binding = 0) uniform sampler2D u_Source;
+
+layout (std140, binding = 1) uniform YUVConversionData
+{
+    vec2 u_VideoSize;       //always even
+    float u_SourceHeight;
+    float u_FlipVertically; //1.0 if the rows of u_Source are stored bottom to top
+};
+
+//packs a yuv420p frame into an rgba8 target, every texel holds 4 consecutive bytes of a plane:
+//the first u_VideoSize.y rows are the y plane, then the u plane and then the v plane,
+//chroma rows are half as wide so every target row holds two of them (the left half and the right half)
+
+//this reproduces swscale's (5.x) rgba to yuv420p conversion bit for bit (SWS_BILINEAR, default BT.601 limited range),
+//so encoded videos are the same whichever side converts them, tests/YUV420ConversionTest.cpp checks it:
+//every sample goes through the same fixed point steps as swscale, a 15 bit intermediate between the
+//horizontal and the vertical pass and the same rounding constants
+
+//swscale's input_rgb2yuv_table for the default colorspace (RGB2YUV_SHIFT = 15)
+const ivec3 c_YCoefficients = ivec3(8414, 16519, 3208);
+const ivec3 c_UCoefficients = ivec3(-4857, -9535, 14392);
+const ivec3 c_VCoefficients = ivec3(14392, -12052, -2341);
+
+//the vertical chroma filter swscale makes for halving the height with SWS_BILINEAR (12 bit, rows 2y-1 to 2y+2)
+const ivec4 c_ChromaFilter = ivec4(512, 1536, 1536, 512);
+
+ivec3 Fetch(ivec2 position)
+{
+    //swscale repeats the edge rows for the taps of the chroma filter that are outside of the image
+    position = clamp(position, ivec2(0), ivec2(u_VideoSize) - 1);
+    if (u_FlipVertically > 0.5)
+        position.y = int(u_SourceHeight) - 1 - position.y;
+
+    return ivec3(round(texelFetch(u_Source, position, 0).rgb * 255.0));
+}
+
+int Dot(ivec3 a, ivec3 b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+//rgb32ToY followed by the unscaled horizontal pass (hScale14To15)
+int Luma15(ivec2 position)
+{
+    int luma14 = (Dot(c_YCoefficients, Fetch(position)) + (32 << 14) + (1 << 8)) >> 9;
+    return min(luma14 * 2, 32767);
+}
+
+//rgb32ToUV_half (which sums every two pixels of a row) followed by the unscaled horizontal pass
+ivec2 Chroma15(ivec2 position)
+{
+    ivec3 rgb = Fetch(position) + Fetch(position + ivec2(1, 0));
+    ivec2 chroma14 = ivec2(Dot(c_UCoefficients, rgb), Dot(c_VCoefficients, rgb)) + (256 << 15) + (1 << 9);
+    return min((chroma14 >> 10) * 2, ivec2(32767));
+}
+
+void main()
+{
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    int videoHeight = int(u_VideoSize.y);
+
+    if (texel.y < videoHeight)
+    {
+        //yuv2plane1 without dithering
+        for (int i = 0; i < 4; i++)
+            FragColor[i] = float(clamp((Luma15(ivec2(texel.x * 4 + i, texel.y)) + 64) >> 7, 0, 255)) / 255.0;
+        return;
+    }
+
+    int chromaRowTexels = (int(u_VideoSize.x) + 7) / 8;
+    int planeRows = (videoHeight / 2 + 1) / 2;
+
+    int row = texel.y - videoHeight;
+    int plane = row < planeRows ? 0 : 1;
+    row -= plane * planeRows;
+
+    int rowHalf = texel.x < chromaRowTexels ? 0 : 1;
+    ivec2 chromaPosition = ivec2((texel.x - rowHalf * chromaRowTexels) * 4, row * 2 + rowHalf);
+
+    for (int i = 0; i < 4; i++)
+    {
+        //yuv2planeX without dithering over the 4 rows around the chroma sample
+        ivec2 position = ivec2(chromaPosition.x + i, chromaPosition.y) * 2;
+        int sum = 64 << 12;
+        for (int j = 0; j < 4; j++)
+            sum += c_ChromaFilter[j] * Chroma15(position + ivec2(0, j - 1))[plane];
+        FragColor[i] = float(clamp(sum >> 19, 0, 255)) / 255.0;
+    }
+}
@@ -5,8 +5,14 @@ std::shared_ptr<spdlog::logger> AinanLogger;
 
 void InitAinanLogger()
 {
-	AinanLogger = spdlog::stdout_color_mt("AinanLogger");
+	//stderr keeps stdout free for video streamed to "-"
+	AinanLogger = spdlog::stderr_color_mt("AinanLogger");
 	AinanLogger->set_pattern("[%T] [%s:%#] %l: %^%v%$");
-	spdlog::sinks::stdout_color_sink_mt* color_sink = (spdlog::sinks::stdout_color_sink_mt*)&(*AinanLogger->sinks()[0]);
+	spdlog::sinks::stderr_color_sink_mt* color_sink = (spdlog::sinks::stderr_color_sink_mt*)&(*AinanLogger->sinks()[0]);
+	//the windows console sink takes color attributes, the ansi one takes escape codes
+#ifdef PLATFORM_WINDOWS
 	color_sink->set_color(spdlog::level::info, color_sink->CYAN);
+#else
+	color_sink->set_color(spdlog::level::info, color_sink->cyan);
+#endif // PLATFORM_WINDOWS
 }
@@ -0,0 +1,195 @@
+#include "renderer/Renderer.h"
+#include "renderer/null/NullRendererAPI.h"
+
+//measures the cpu cost of submitting work through the Renderer (command queue, batching, uniform packing)
+//by running it on the null backend, which records every call without doing any gpu or rasterization work
+//usage: RendererBenchmark [quads per frame] [frames]
+
+using namespace Ainan;
+
+struct BenchmarkResult
+{
+	std::string Name;
+	double MillisecondsPerFrame = 0.0;
+	double ItemsPerSecond = 0.0;
+	Null::NullRendererStats StatsPerFrame;
+};
+
+static Null::NullRendererStats GetStatsPerFrame(const Null::NullRendererStats& before, const Null::NullRendererStats& after, uint64_t frames)
+{
+	Null::NullRendererStats result;
+	result.DrawCalls = (after.DrawCalls - before.DrawCalls) / frames;
+	result.IndexedDrawCalls = (after.IndexedDrawCalls - before.IndexedDrawCalls) / frames;
+	result.VerticesDrawn = (after.VerticesDrawn - before.VerticesDrawn) / frames;
+	result.VertexBytesUploaded = (after.VertexBytesUploaded - before.VertexBytesUploaded) / frames;
+	result.UniformBytesUploaded = (after.UniformBytesUploaded - before.UniformBytesUploaded) / frames;
+	result.TextureBinds = (after.TextureBinds - before.TextureBinds) / frames;
+	result.UniformBufferBinds = (after.UniformBufferBinds - before.UniformBufferBinds) / frames;
+	return result;
+}
+
+//runs drawFunc between BeginScene and EndScene for every frame and times the whole loop, including waiting for the renderer thread
+template<typename Func>
+static BenchmarkResult RunBenchmark(const std::string& name, SceneDescription& desc, uint32_t frames, uint32_t itemsPerFrame, Func drawFunc)
+{
+	//warm up so the first frame allocations aren't measured
+	Renderer::BeginScene(desc);
+	drawFunc();
+	Renderer::EndScene();
+	Renderer::Present();
+
+	Null::NullRendererStats before = Null::NullRendererAPI::Singleton().Stats;
+	auto start = std::chrono::high_resolution_clock::now();
+
+	for (uint32_t i = 0; i < frames; i++)
+	{
+		Renderer::BeginScene(desc);
+		drawFunc();
+		Renderer::EndScene();
+		Renderer::Present();
+	}
+
+	auto end = std::chrono::high_resolution_clock::now();
+	Null::NullRendererStats after = Null::NullRendererAPI::Singleton().Stats;
+
+	double seconds = std::chrono::duration<double>(end - start).count();
+
+	BenchmarkResult result;
+	result.Name = name;
+	result.MillisecondsPerFrame = seconds * 1000.0 / frames;
+	result.ItemsPerSecond = (double)itemsPerFrame * frames / seconds;
+	result.StatsPerFrame = GetStatsPerFrame(before, after, frames);
+	return result;
+}
+
+static void PrintResult(const BenchmarkResult& result)
+{
+	printf("%-24s %10.3f ms/frame %14.0f items/s %8llu draws %10llu vertices %12llu vertex bytes %8llu uniform bytes %8llu texture binds\n",
+		result.Name.c_str(),
+		result.MillisecondsPerFrame,
+		result.ItemsPerSecond,
+		(unsigned long long)result.StatsPerFrame.DrawCalls,
+		(unsigned long long)result.StatsPerFrame.VerticesDrawn,
+		(unsigned long long)result.StatsPerFrame.VertexBytesUploaded,
+		(unsigned long long)result.StatsPerFrame.UniformBytesUploaded,
+		(unsigned long long)result.StatsPerFrame.TextureBinds);
+}
+
+int main(int argc, char** argv)
+{
+	uint32_t quadCount = 100000;
+	uint32_t frameCount = 200;
+
+	if (argc > 1)
+		quadCount = std::max(1, atoi(argv[1]));
+	if (argc > 2)
+		frameCount = std::max(1, atoi(argv[2]));
+
+#ifndef NDEBUG
+	InitAinanLogger();
+#endif // !NDEBUG
+
+	Renderer::Init(RendererType::Null);
+
+	const glm::vec2 c_TargetSize = glm::vec2(1920, 1080);
+	auto target = Renderer::CreateFrameBuffer(c_TargetSize);
+
+	Rectangle viewport = { 0, 0, (int32_t)c_TargetSize.x, (int32_t)c_TargetSize.y };
+	Renderer::SetViewport(viewport);
+
+	SceneDescription desc;
+	desc.SceneCamera.Update(0.0f, viewport);
+	desc.SceneDrawTarget = &target;
+	desc.Blur = false;
+
+	//generate the same pseudo random quads every run
+	std::mt19937 rng(1234);
+	std::uniform_real_distribution<float> positionDist(-1000.0f, 1000.0f);
+	std::uniform_real_distribution<float> unitDist(0.0f, 1.0f);
+
+	std::vector<glm::vec2> positions(quadCount);
+	std::vector<glm::vec4> colors(quadCount);
+	std::vector<float> scales(quadCount);
+	std::vector<float> rotations(quadCount);
+	for (uint32_t i = 0; i < quadCount; i++)
+	{
+		positions[i] = glm::vec2(positionDist(rng), positionDist(rng));
+		colors[i] = glm::vec4(unitDist(rng), unitDist(rng), unitDist(rng), 1.0f);
+		scales[i] = 1.0f + unitDist(rng) * 20.0f;
+		rotations[i] = unitDist(rng) * 6.28318f;
+	}
+
+	uint8_t texturePixels[4 * 4 * 4];
+	memset(texturePixels, 255, sizeof(texturePixels));
+	auto texture = Renderer::CreateTexture(glm::vec2(4, 4), TextureFormat::RGBA, texturePixels);
+
+	//line strip drawn with Renderer::Draw, the same way the grid and the editor outlines are drawn
+	const uint32_t c_LineVertexCount = 2048;
+	std::vector<glm::vec2> lineVertices(c_LineVertexCount);
+	for (uint32_t i = 0; i < c_LineVertexCount; i++)
+		lineVertices[i] = glm::vec2(positionDist(rng), positionDist(rng));
+
+	VertexLayout lineLayout(1);
+	lineLayout[0] = VertexLayoutElement("POSITION", 0, ShaderVariableType::Vec2);
+	auto& lineShader = Renderer::ShaderLibrary()["LineShader"];
+	auto lineVertexBuffer = Renderer::CreateVertexBuffer(lineVertices.data(), sizeof(glm::vec2) * c_LineVertexCount, lineLayout, lineShader, true);
+
+	glm::vec4 lineColor = glm::vec4(1.0f);
+	VertexLayout colorLayout(1);
+	colorLayout[0] = VertexLayoutElement("u_Color", 0, ShaderVariableType::Vec4);
+	auto lineUniformBuffer = Renderer::CreateUniformBuffer("ObjectColor", 1, colorLayout, (void*)&lineColor);
+
+	const uint32_t c_LineDrawsPerFrame = 256;
+
+	printf("Renderer submission benchmark: %u quads per frame, %u frames\n\n", quadCount, frameCount);
+
+	std::vector<BenchmarkResult> results;
+
+	results.push_back(RunBenchmark("DrawQuad", desc, frameCount, quadCount, [&]()
+		{
+			for (uint32_t i = 0; i < quadCount; i++)
+				Renderer::DrawQuad(positions[i], colors[i], scales[i]);
+		}));
+
+	results.push_back(RunBenchmark("DrawQuad textured", desc, frameCount, quadCount, [&]()
+		{
+			for (uint32_t i = 0; i < quadCount; i++)
+				Renderer::DrawQuad(positions[i], colors[i], scales[i], texture);
+		}));
+
+	results.push_back(RunBenchmark("DrawQuad rotated", desc, frameCount, quadCount, [&]()
+		{
+			for (uint32_t i = 0; i < quadCount; i++)
+				Renderer::DrawQuad(positions[i], colors[i], scales[i], rotations[i], texture);
+		}));
+
+	results.push_back(RunBenchmark("DrawQuadv", desc, frameCount, quadCount, [&]()
+		{
+			Renderer::DrawQuadv(positions.data(), colors.data(), scales.data(), quadCount);
+		}));
+
+	results.push_back(RunBenchmark("DrawQuadv textured", desc, frameCount, quadCount, [&]()
+		{
+			Renderer::DrawQuadv(positions.data(), colors.data(), scales.data(), quadCount, texture);
+		}));
+
+	results.push_back(RunBenchmark("Draw lines", desc, frameCount, c_LineDrawsPerFrame, [&]()
+		{
+			for (uint32_t i = 0; i < c_LineDrawsPerFrame; i++)
+			{
+				lineShader->BindUniformBuffer(lineUniformBuffer, 1, RenderingStage::FragmentShader);
+				Renderer::Draw(lineVertexBuffer, lineShader, Primitive::Lines, c_LineVertexCount);
+			}
+		}));
+
+	for (auto& result : results)
+		PrintResult(result);
+
+	texture.reset();
+	lineVertexBuffer.reset();
+	lineUniformBuffer.reset();
+	target.reset();
+
+	Renderer::Terminate();
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <deque>
+
+namespace Ainan {
+
+	//thread safe fifo that blocks producers while it is full and consumers while it is empty,
+	//used to connect the stages of the exporters so a fast stage can't run too far ahead of a slow one
+	template<typename T>
+	class BoundedQueue
+	{
+	public:
+		BoundedQueue(size_t capacity) :
+			m_Capacity(capacity)
+		{}
+
+		//returns false if the queue was closed while waiting, the item is dropped in that case
+		bool Push(T item)
+		{
+			std::unique_lock lock(m_Mutex);
+			m_NotFull.wait(lock, [this]() { return m_Closed || m_Items.size() < m_Capacity; });
+			if (m_Closed)
+				return false;
+
+			m_Items.push_back(std::move(item));
+			m_NotEmpty.notify_one();
+			return true;
+		}
+
+		//returns false once the queue is closed and everything in it was popped
+		bool Pop(T& item)
+		{
+			std::unique_lock lock(m_Mutex);
+			m_NotEmpty.wait(lock, [this]() { return m_Closed || m_Items.size() > 0; });
+			if (m_Items.size() == 0)
+				return false;
+
+			item = std::move(m_Items.front());
+			m_Items.pop_front();
+			m_NotFull.notify_one();
+			return true;
+		}
+
+		//wakes every waiting thread, pushing fails after this but the remaining items can still be popped
+		void Close()
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Closed = true;
+			m_NotFull.notify_all();
+			m_NotEmpty.notify_all();
+		}
+
+		size_t Size()
+		{
+			std::lock_guard lock(m_Mutex);
+			return m_Items.size();
+		}
+
+	private:
+		std::mutex m_Mutex;
+		std::condition_variable m_NotFull;
+		std::condition_variable m_NotEmpty;
+		std::deque<T> m_Items;
+		size_t m_Capacity;
+		bool m_Closed = false;
+	};
+}
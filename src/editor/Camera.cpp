@@ -38,6 +38,15 @@ namespace Ainan {
 		ViewMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(Position.x, Position.y, 0.0f));
 	}
 
+	void Camera::CropProjection(const glm::vec2& bottomLeft, const glm::vec2& topRight)
+	{
+		//maps the region from its place in NDC to all of NDC
+		glm::vec2 scale = 1.0f / (topRight - bottomLeft);
+		glm::vec2 offset = (1.0f - 2.0f * bottomLeft) * scale - 1.0f;
+		glm::mat4 crop = glm::translate(glm::mat4(1.0f), glm::vec3(offset, 0.0f)) * glm::scale(glm::mat4(1.0f), glm::vec3(scale, 1.0f));
+		ProjectionMatrix = crop * ProjectionMatrix;
+	}
+
 	glm::vec2 Camera::WorldSpaceToViewportNDC(glm::vec2 pos) const
 	{
 		glm::mat4 view = glm::translate(glm::mat4(1.0f), glm::vec3(Position.x, Position.y, 0.0f) / c_GlobalScaleFactor);
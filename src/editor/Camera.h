@@ -24,6 +24,9 @@ namespace Ainan {
 		//this only sets the camera size to the screen size
 		void Update(float deltaTime, const Rectangle& viewport);
 		void SetPosition(const glm::vec2& newPos);
+		//makes the projection show only part of what it currently shows, given as fractions of the view (0,0 is bottom left and 1,1 top right),
+		//they can be outside 0 to 1 to also show a border around the view, used to render big images in tiles
+		void CropProjection(const glm::vec2& bottomLeft, const glm::vec2& topRight);
 
 		//returns the position in Normalized Dvice Coordinates relative to the viewport window and NOT the monitor
 		glm::vec2 WorldSpaceToViewportNDC(glm::vec2 pos) const;
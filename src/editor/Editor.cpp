@@ -8,23 +8,27 @@ namespace Ainan
 		m_Preferences(EditorPreferences::LoadFromDefaultPath())
 	{
 		m_LoadEnvironmentBrowser.Filter.push_back(".env");
+		m_LoadEnvironmentBrowser.Filter.push_back(".json");
+		m_LoadEnvironmentBrowser.Filter.push_back(c_AssetPackExtension);
 		m_LoadEnvironmentBrowser.OnCloseWindow = []() 
 		{
 			Window::SetSize(c_StartMenuWidth, c_StartMenuHeight);
 			Window::CenterWindow();
 		};
 
-		m_PlayButtonTexture = Renderer::CreateTexture(Image::LoadFromFile("res/PlayButton.png"));
-		m_PauseButtonTexture = Renderer::CreateTexture(Image::LoadFromFile("res/PauseButton.png"));
-		m_StopButtonTexture = Renderer::CreateTexture(Image::LoadFromFile("res/StopButton.png"));
-		m_SpriteIconTexture = Renderer::CreateTexture(Image::LoadFromFile("res/Sprite.png", TextureFormat::RGBA));
-		m_LitSpriteIconTexture = Renderer::CreateTexture(Image::LoadFromFile("res/LitSprite.png", TextureFormat::RGBA));
-		m_ParticleSystemIconTexture = Renderer::CreateTexture(Image::LoadFromFile("res/ParticleSystem.png", TextureFormat::RGBA));
-		m_RadialLightIconTexture = Renderer::CreateTexture(Image::LoadFromFile("res/RadialLight.png", TextureFormat::RGBA));
-		m_SpotLightIconTexture = Renderer::CreateTexture(Image::LoadFromFile("res/SpotLight.png", TextureFormat::RGBA));
+		m_PlayButtonTexture = TextureCache::Get("res/PlayButton.png");
+		m_PauseButtonTexture = TextureCache::Get("res/PauseButton.png");
+		m_StopButtonTexture = TextureCache::Get("res/StopButton.png");
+		m_SpriteIconTexture = TextureCache::Get("res/Sprite.png", TextureFormat::RGBA);
+		m_LitSpriteIconTexture = TextureCache::Get("res/LitSprite.png", TextureFormat::RGBA);
+		m_ParticleSystemIconTexture = TextureCache::Get("res/ParticleSystem.png", TextureFormat::RGBA);
+		m_RadialLightIconTexture = TextureCache::Get("res/RadialLight.png", TextureFormat::RGBA);
+		m_SpotLightIconTexture = TextureCache::Get("res/SpotLight.png", TextureFormat::RGBA);
 
 		UpdateTitle();
 		SetEditorStyle(m_Preferences.Style);
+		Renderer::SetFramePacing(m_Preferences.FramePacing, m_Preferences.TargetFramerate);
+		m_ShaderIndex = std::make_unique<AssetIndex>("shaders");
 
 		//initlize worker threads
 		for (auto& thread : WorkerThreads)
@@ -50,6 +54,30 @@ namespace Ainan
 	}
 
 	void Editor::Update()
+	{
+		Update((float)LastFrameDeltaTime);
+		//not part of Update(deltaTime), the exporters call that with simulated time but autosaving goes by the real clock
+		UpdateSaving((float)LastFrameDeltaTime);
+
+		m_Exporter.ExportIfScheduled(*this);
+		ReloadChangedAssets();
+	}
+
+	void Editor::ReloadChangedAssets()
+	{
+		auto changedShaderFiles = m_ShaderIndex->TakeChangedFiles();
+		if (!changedShaderFiles.empty())
+			Renderer::ReloadShaders(changedShaderFiles);
+
+		if (m_State == State_NoEnvLoaded)
+			return;
+
+		auto changedFiles = AssetManager::TakeChangedFiles();
+		if (!changedFiles.empty())
+			TextureCache::Reload(changedFiles);
+	}
+
+	void Editor::Update(float deltaTime)
 	{
 		if (m_ShouldDeleteEnv)
 		{
@@ -59,24 +87,52 @@ namespace Ainan
 			m_ShouldDeleteEnv = false;
 		}
 
-		m_SimulationDeltaTime = LastFrameDeltaTime * m_SimulationSpeedFactor;
+		m_SimulationDeltaTime = deltaTime * m_SimulationSpeedFactor;
 
 		switch (m_State)
 		{
 		case State_EditorMode:
-			Update_EditorMode(LastFrameDeltaTime);
+			Update_EditorMode(deltaTime);
 			break;
 
 		case State_PlayMode:
-			Update_PlayMode(LastFrameDeltaTime);
+			Update_PlayMode(deltaTime);
 			break;
 
 		case State_PauseMode:
-			Update_PauseMode(LastFrameDeltaTime);
+			Update_PauseMode(deltaTime);
 			break;
 		}
+	}
 
-		m_Exporter.ExportIfScheduled(*this);
+	void Editor::SaveEnvironmentAsync(bool autosave)
+	{
+		std::string name = m_EnvironmentFolderPath.u8string() + "\\" + m_Env->Name + (autosave ? "_autosave.env" : ".env");
+		m_Saver.SaveAsync(*m_Env, name, autosave);
+		m_TimeSinceAutosave = 0.0f;
+
+		if (!autosave)
+			m_AppStatusWindow.SetText("Saving Environment To: " + name, 10.0f);
+	}
+
+	void Editor::UpdateSaving(float deltaTime)
+	{
+		for (auto& result : m_Saver.TakeResults())
+		{
+			if (!result.Succeeded)
+				m_AppStatusWindow.SetText("Could not save environment to: " + result.Path, 3.0f);
+			else if (result.Autosave)
+				m_AppStatusWindow.SetText("Autosaved Environment To: " + result.Path);
+			else
+				m_AppStatusWindow.SetText("Saved Environment To: " + result.Path);
+		}
+
+		if (!m_Env || m_State == State_NoEnvLoaded || m_State == State_CreateEnv || m_Preferences.AutosaveInterval <= 0)
+			return;
+
+		m_TimeSinceAutosave += deltaTime;
+		if (m_TimeSinceAutosave >= m_Preferences.AutosaveInterval * 60.0f && !m_Saver.IsSaving())
+			SaveEnvironmentAsync(true);
 	}
 
 	void Editor::Draw()
@@ -221,7 +277,7 @@ namespace Ainan
 		//move everything back
 		std::memmove(m_DeltaTimeHistory.data(), m_DeltaTimeHistory.data() + 1, (m_DeltaTimeHistory.size() - 1) * sizeof(float));
 		//register the new time
-		m_DeltaTimeHistory[m_DeltaTimeHistory.size() - 1] = LastFrameDeltaTime;
+		m_DeltaTimeHistory[m_DeltaTimeHistory.size() - 1] = deltaTime;
 	}
 
 	void Editor::Update_PauseMode(float deltaTime)
@@ -312,7 +368,7 @@ namespace Ainan
 		m_LoadEnvironmentBrowser.DisplayGUI([this](const std::filesystem::path path)
 			{
 				//check if file is selected
-				if (path.extension().u8string() == ".env") 
+				if (path.extension().u8string() == ".env" || path.extension().u8string() == ".json" || path.extension().u8string() == c_AssetPackExtension) 
 				{
 					//remove minimizing event on file browser window close
 					m_LoadEnvironmentBrowser.OnCloseWindow = nullptr;
@@ -666,7 +722,7 @@ namespace Ainan
 
 		ImGui::End();
 
-		m_Exporter.DisplayGUI();
+		m_Exporter.DisplayGUI(*m_Env);
 
 		for (pEnvironmentObject& obj : m_Env->Objects)
 		{
@@ -682,7 +738,9 @@ namespace Ainan
 
 	void Editor::OnEnvironmentLoad()
 	{
-		AssetManager::Init(m_EnvironmentFolderPath.u8string());
+		//loading the environment already did this, doing it again would unmount a pack it was loaded from
+		if (AssetManager::s_EnvironmentDirectory != m_EnvironmentFolderPath)
+			AssetManager::Init(m_EnvironmentFolderPath.u8string());
 
 		if (m_Preferences.WindowMaximized)
 			Window::Maximize();
@@ -715,9 +773,35 @@ namespace Ainan
 			{
 				if (ImGui::MenuItem("Save")) 
 				{
-					std::string name = m_EnvironmentFolderPath.u8string() + "\\" + m_Env->Name + ".env";
-					SaveEnvironment(*m_Env, name);
-					m_AppStatusWindow.SetText("Saved Environment To: " + name);
+					SaveEnvironmentAsync(false);
+				}
+
+				if (ImGui::MenuItem("Export As JSON"))
+				{
+					std::string name = m_EnvironmentFolderPath.u8string() + "\\" + m_Env->Name + ".json";
+					ExportEnvironmentToJson(*m_Env, name);
+					m_AppStatusWindow.SetText("Exported Environment To: " + name);
+				}
+
+				if (ImGui::BeginMenu("Export As Pack"))
+				{
+					bool exportPack = false;
+					bool predecodeTextures = false;
+					if (ImGui::MenuItem("Source Textures"))
+						exportPack = true;
+					if (ImGui::MenuItem("Pre-decoded Textures"))
+						exportPack = predecodeTextures = true;
+
+					if (exportPack)
+					{
+						std::string name = m_EnvironmentFolderPath.u8string() + "\\" + m_Env->Name + c_AssetPackExtension;
+						if (ExportEnvironmentPack(*m_Env, name, predecodeTextures))
+							m_AppStatusWindow.SetText("Exported Environment Pack To: " + name);
+						else
+							m_AppStatusWindow.SetText("Could not export environment pack to: " + name);
+					}
+
+					ImGui::EndMenu();
 				}
 
 				if (ImGui::MenuItem("Close Environment"))
@@ -1272,9 +1356,7 @@ namespace Ainan
 			{
 				if (mods & GLFW_MOD_CONTROL)
 				{
-					std::string name = m_EnvironmentFolderPath.u8string() + "\\" + m_Env->Name + ".env";
-					SaveEnvironment(*m_Env, name);
-					m_AppStatusWindow.SetText("Saved Environment To: " + name);
+					SaveEnvironmentAsync(false);
 				}
 			});
 
@@ -1476,6 +1558,12 @@ namespace Ainan
 					m_AverageFPS = 1.0f / (std::accumulate(m_DeltaTimeHistory.begin(), m_DeltaTimeHistory.end(), 0.0f) / m_DeltaTimeHistory.size());
 				else
 					m_AverageFPS = 0;
+
+				m_GPUPassTimes = Renderer::Rdata->GPUPassTimes;
+				m_CPUPassTimes = Renderer::Rdata->CPUPassTimes;
+				m_RenderThreadBusyTime = Renderer::Rdata->RenderThreadBusyTime;
+				m_PresentWaitTime = Renderer::Rdata->PresentWaitTime;
+				m_FrameTimePercentiles = Renderer::GetFrameTimePercentiles();
 				frameCounter = 1;
 			}
 			frameCounter++;
@@ -1486,13 +1574,25 @@ namespace Ainan
 
 			if (ImGui::IsItemHovered()) {
 				ImGui::BeginTooltip();
-				ImGui::SetTooltip("NOTE: Frame rates do not exceed 60,\nthis is theoretical FPS given the time per frame");
+				ImGui::SetTooltip("NOTE: Frame rates do not exceed the frame pacing limit,\nthis is theoretical FPS given the time per frame");
 				ImGui::EndTooltip();
 			}
 
 			ImGui::PlotLines("Frame Time(s)", m_DeltaTimeHistory.data(), m_DeltaTimeHistory.size(),
 				0, 0, 0.0f, 0.025f, ImVec2(0, 50));
 
+			ImGui::Text("Frame Time p50: ");
+			ImGui::SameLine();
+			ImGui::TextColored({ 0.0f,0.8f,0.0f,1.0f }, "%.2f ms", m_FrameTimePercentiles.P50);
+			ImGui::SameLine();
+			ImGui::Text("   p95: ");
+			ImGui::SameLine();
+			ImGui::TextColored({ 0.0f,0.8f,0.0f,1.0f }, "%.2f ms", m_FrameTimePercentiles.P95);
+			ImGui::SameLine();
+			ImGui::Text("   p99: ");
+			ImGui::SameLine();
+			ImGui::TextColored({ 0.0f,0.8f,0.0f,1.0f }, "%.2f ms", m_FrameTimePercentiles.P99);
+
 			ImGui::Text("Textures: ");
 			ImGui::SameLine();
 			ImGui::Text(std::to_string(Renderer::Rdata->ReservedTextures.size()).c_str());
@@ -1518,6 +1618,70 @@ namespace Ainan
 			ImGui::Text(std::to_string(m_GPUMemAllocated / (1024 * 1024)).c_str());
 			ImGui::SameLine();
 			ImGui::Text("Mb");
+
+			ImGui::Text("Cached Textures: ");
+			ImGui::SameLine();
+			ImGui::Text(std::to_string(TextureCache::GetEntryCount()).c_str());
+			ImGui::SameLine();
+			ImGui::Text("   Unused: ");
+			ImGui::SameLine();
+			ImGui::Text(std::to_string(TextureCache::GetUnusedBytes() / (1024 * 1024)).c_str());
+			ImGui::SameLine();
+			ImGui::Text("Mb");
+
+			ImGui::Separator();
+
+			//per pass timings, gpu time is how long the gpu spent executing the pass
+			//and renderer thread time is how long it took to submit it
+			ImGui::Columns(3);
+			ImGui::Text("Pass");
+			ImGui::NextColumn();
+			ImGui::Text("GPU (ms)");
+			ImGui::NextColumn();
+			ImGui::Text("Renderer Thread (ms)");
+			ImGui::NextColumn();
+			ImGui::Separator();
+
+			double totalGPUTime = 0.0;
+			double totalCPUTime = 0.0;
+			for (size_t i = 0; i < (size_t)RenderPass::Count; i++)
+			{
+				ImGui::Text(RenderPassStr((RenderPass)i).c_str());
+				ImGui::NextColumn();
+				ImGui::Text("%.3f", m_GPUPassTimes[i]);
+				ImGui::NextColumn();
+				ImGui::Text("%.3f", m_CPUPassTimes[i]);
+				ImGui::NextColumn();
+
+				totalGPUTime += m_GPUPassTimes[i];
+				totalCPUTime += m_CPUPassTimes[i];
+			}
+
+			ImGui::Separator();
+			ImGui::Text("Total");
+			ImGui::NextColumn();
+			ImGui::TextColored({ 0.0f,0.8f,0.0f,1.0f }, "%.3f", totalGPUTime);
+			ImGui::NextColumn();
+			ImGui::TextColored({ 0.0f,0.8f,0.0f,1.0f }, "%.3f", totalCPUTime);
+			ImGui::NextColumn();
+			ImGui::Columns(1);
+			ImGui::Separator();
+
+			ImGui::Text("Renderer Thread Busy: ");
+			ImGui::SameLine();
+			ImGui::TextColored({ 0.0f,0.8f,0.0f,1.0f }, "%.3f ms", m_RenderThreadBusyTime);
+			ImGui::SameLine();
+			ImGui::Text("   Waiting For Renderer: ");
+			ImGui::SameLine();
+			ImGui::TextColored({ 0.0f,0.8f,0.0f,1.0f }, "%.3f ms", m_PresentWaitTime);
+
+			if (ImGui::IsItemHovered()) {
+				ImGui::BeginTooltip();
+				ImGui::SetTooltip("High GPU times mean the scene is fill bound,\n"
+								  "a busy renderer thread with low GPU times means it is submission bound,\n"
+								  "and waiting with both low means the threads are stalling on each other (sync bound)");
+				ImGui::EndTooltip();
+			}
 		}
 		break;
 
@@ -1657,6 +1821,33 @@ namespace Ainan
 		if (ImGui::IsItemHovered())
 			ImGui::SetTooltip("Backend will change only when the app is restarted");
 
+		if (ImGui::BeginCombo("Frame Pacing", FramePacingModeStr(m_Preferences.FramePacing).c_str()))
+		{
+			for (auto mode : { FramePacingMode::Limited, FramePacingMode::VSync, FramePacingMode::Uncapped })
+			{
+				bool selected = m_Preferences.FramePacing == mode;
+				if (ImGui::Selectable(FramePacingModeStr(mode).c_str(), &selected))
+				{
+					m_Preferences.FramePacing = mode;
+					Renderer::SetFramePacing(m_Preferences.FramePacing, m_Preferences.TargetFramerate);
+				}
+			}
+
+			ImGui::EndCombo();
+		}
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip("Uncapped runs as fast as possible, it is meant for benchmarking");
+
+		if (m_Preferences.FramePacing == FramePacingMode::Limited)
+		{
+			if (ImGui::DragInt("Target Framerate", &m_Preferences.TargetFramerate, 1.0f, c_MinTargetFramerate, c_MaxTargetFramerate))
+				Renderer::SetFramePacing(m_Preferences.FramePacing, m_Preferences.TargetFramerate);
+		}
+
+		ImGui::DragInt("Autosave Interval", &m_Preferences.AutosaveInterval, 0.1f, 0, c_MaxAutosaveInterval, "%d min");
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip("Minutes between autosaves, 0 turns autosaving off. Autosaves are written next to the environment file");
+
 		ImGui::End();
 	}
 
@@ -14,10 +14,14 @@
 #include "Exporter.h"
 #include "file/FolderBrowser.h"
 #include "EditorPreferences.h"
+#include "EnvironmentSaver.h"
 #include "environment/RadialLight.h"
 
 namespace Ainan {
 	bool SaveEnvironment(const Environment& env, std::string path);
+	bool ExportEnvironmentToJson(const Environment& env, std::string path);
+	//packs the environment and the files it references into one file that can be loaded like an environment
+	bool ExportEnvironmentPack(const Environment& env, std::string path, bool predecodeTextures);
 	Environment* LoadEnvironment(const std::string& path);
 
 	const float c_StartMenuBtnWidth     = 300.0f;
@@ -51,6 +55,8 @@ namespace Ainan {
 		~Editor();
 
 		void Update();
+		//steps by deltaTime instead of the time the last frame took, used by the exporter to run faster than real time
+		void Update(float deltaTime);
 		void Draw();
 
 	private:
@@ -60,9 +66,12 @@ namespace Ainan {
 		ViewportWindow m_ViewportWindow;
 		AppStatusWindow m_AppStatusWindow;
 		Exporter m_Exporter;
+		EnvironmentSaver m_Saver;
 		RenderSurface m_RenderSurface;
 		Gizmo m_Gizmo;
 		Grid m_Grid;
+		//watches the shader folder so edited shaders are compiled again while the editor runs
+		std::unique_ptr<AssetIndex> m_ShaderIndex;
 
 		bool m_EnvironmentControlsWindowOpen = true;
 		bool m_ObjectInspectorWindowOpen = true;
@@ -97,6 +106,7 @@ namespace Ainan {
 		FileBrowser m_LoadEnvironmentBrowser;
 		bool m_IncludeStarterAssets = false;
 		bool m_ShouldDeleteEnv = false;
+		float m_TimeSinceAutosave = 0.0f;
 
 		std::array<std::thread, 4> WorkerThreads;
 		std::queue<EnvironmentObjectInterface*> UpdateQueue;
@@ -108,9 +118,19 @@ namespace Ainan {
 		int32_t m_AverageFPS = 0;
 		uint32_t m_GPUMemAllocated = 0;
 		int32_t m_DrawCalls = 0;
+		//pass timings shown in the profiler, refreshed with the fps so they are readable
+		RenderPassTimes m_GPUPassTimes = {};
+		RenderPassTimes m_CPUPassTimes = {};
+		double m_RenderThreadBusyTime = 0.0;
+		double m_PresentWaitTime = 0.0;
+		FrameTimePercentiles m_FrameTimePercentiles;
 
 	private:
 		void WorkerThreadLoop();
+		void ReloadChangedAssets();
+		//the environment is saved next to the others with an _autosave suffix if this is an autosave
+		void SaveEnvironmentAsync(bool autosave);
+		void UpdateSaving(float deltaTime);
 
 		//methods based on editor state
 		void Update_EditorMode(float deltaTime);
@@ -12,6 +12,9 @@ namespace Ainan {
 		defaultPreferences.Style = EditorStyle::Dark_Gray;
 		defaultPreferences.WindowMaximized = true;
 		defaultPreferences.WindowSize = { 1280, 720 };
+		defaultPreferences.FramePacing = FramePacingMode::Limited;
+		defaultPreferences.TargetFramerate = c_DefaultTargetFramerate;
+		defaultPreferences.AutosaveInterval = c_DefaultAutosaveInterval;
 
 		//we default to Direct X in windows because we want nativity
 #ifdef PLATFORM_WINDOWS
@@ -25,18 +28,17 @@ namespace Ainan {
 
 	EditorPreferences EditorPreferences::LoadFromDefaultPath()
 	{
-		FILE* file;
-		fopen_s(&file, c_DefaultPreferencesPath, "r");
+		MappedFile file = AssetManager::MapFile(c_DefaultPreferencesPath);
 
 		EditorPreferences preferences = Default();
 
-		if (file)
+		if (file.IsValid())
 		{
 			nlohmann::json j;
 			std::string errorStr = "";
 			try
 			{
-				j = nlohmann::json::parse(AssetManager::ReadEntireTextFile(c_DefaultPreferencesPath));
+				j = nlohmann::json::parse(file.GetText());
 			}
 			catch (const std::exception& e)
 			{
@@ -49,9 +51,15 @@ namespace Ainan {
 				preferences.WindowSize = JSON_ARRAY_TO_IVEC2(j["EditorWindowSize"].get<std::vector<float>>());
 				preferences.Style = EditorStyleVal(j["EditorStyle"].get<std::string>());
 				preferences.RenderingBackend = RendererTypeVal(j["EditorBackend"].get<std::string>());
-			}
 
-			fclose(file);
+				//older preference files don't have these
+				if (j.find("EditorFramePacing") != j.end())
+					preferences.FramePacing = FramePacingModeVal(j["EditorFramePacing"].get<std::string>());
+				if (j.find("EditorTargetFramerate") != j.end())
+					preferences.TargetFramerate = j["EditorTargetFramerate"].get<int32_t>();
+				if (j.find("EditorAutosaveInterval") != j.end())
+					preferences.AutosaveInterval = j["EditorAutosaveInterval"].get<int32_t>();
+			}
 		}
 
 		return preferences;
@@ -66,6 +74,9 @@ namespace Ainan {
 		j["EditorWindowSize"] = { WindowSize.x, WindowSize.y };
 		j["EditorStyle"] = EditorStyleStr(Style);
 		j["EditorBackend"] = RendererTypeStr(RenderingBackend);
+		j["EditorFramePacing"] = FramePacingModeStr(FramePacing);
+		j["EditorTargetFramerate"] = TargetFramerate;
+		j["EditorAutosaveInterval"] = AutosaveInterval;
 
 		return j.dump(4);
 	}
@@ -74,8 +85,7 @@ namespace Ainan {
 	{
 		std::string jsonStr = SerializeIntoJson();
 
-		FILE* file;
-		fopen_s(&file, c_DefaultPreferencesPath, "w");
+		FILE* file = fopen(c_DefaultPreferencesPath, "w");
 
 		if (file)
 		{
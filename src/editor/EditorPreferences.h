@@ -3,6 +3,7 @@
 #include "EditorStyles.h"
 #include "renderer/Renderer.h"
 #include "file/AssetManager.h"
+#include "EnvironmentSaver.h"
 
 namespace Ainan {
 
@@ -22,5 +23,8 @@ namespace Ainan {
 		bool WindowMaximized = false;
 		glm::ivec2 WindowSize = { 0, 0 };
 		RendererType RenderingBackend = RendererType::OpenGL;
+		FramePacingMode FramePacing = FramePacingMode::Limited;
+		int32_t TargetFramerate = c_DefaultTargetFramerate;
+		int32_t AutosaveInterval = c_DefaultAutosaveInterval; //in minutes, 0 means no autosaving
 	};
 }
\ No newline at end of file
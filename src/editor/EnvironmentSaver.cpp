@@ -0,0 +1,78 @@
+#include "EnvironmentSaver.h"
+
+namespace Ainan {
+
+	EnvironmentSaver::EnvironmentSaver()
+	{
+		m_Thread = std::thread([this]() { SaverThreadLoop(); });
+	}
+
+	EnvironmentSaver::~EnvironmentSaver()
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Stop = true;
+		}
+		m_JobCV.notify_one();
+		m_Thread.join();
+	}
+
+	void EnvironmentSaver::SaveAsync(const Environment& env, const std::string& path, bool autosave)
+	{
+		SaveJob job;
+		job.Snapshot = BinaryEnvironment::TakeSnapshot(env);
+		job.Path = path;
+		job.Autosave = autosave;
+
+		{
+			std::lock_guard lock(m_Mutex);
+			m_PendingJob = std::move(job);
+		}
+		m_JobCV.notify_one();
+	}
+
+	bool EnvironmentSaver::IsSaving()
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_Writing || m_PendingJob.Snapshot;
+	}
+
+	std::vector<EnvironmentSaveResult> EnvironmentSaver::TakeResults()
+	{
+		std::lock_guard lock(m_Mutex);
+		std::vector<EnvironmentSaveResult> results;
+		results.swap(m_Results);
+		return results;
+	}
+
+	void EnvironmentSaver::SaverThreadLoop()
+	{
+		while (true)
+		{
+			SaveJob job;
+			{
+				std::unique_lock lock(m_Mutex);
+				m_JobCV.wait(lock, [this]() { return m_Stop || m_PendingJob.Snapshot; });
+
+				//pending saves are still written when stopping so closing the editor doesn't lose them
+				if (!m_PendingJob.Snapshot)
+					return;
+
+				job = std::move(m_PendingJob);
+				m_PendingJob = SaveJob();
+				m_Writing = true;
+			}
+
+			EnvironmentSaveResult result;
+			result.Path = job.Path;
+			result.Autosave = job.Autosave;
+			result.Succeeded = BinaryEnvironment::WriteFile(BinaryEnvironment::Serialize(*job.Snapshot), job.Path);
+			if (!result.Succeeded)
+				AINAN_LOG_ERROR("Could not save environment to: " + job.Path);
+
+			std::lock_guard lock(m_Mutex);
+			m_Writing = false;
+			m_Results.push_back(result);
+		}
+	}
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "environment/EnvBinary.h"
+
+#include <thread>
+#include <condition_variable>
+
+namespace Ainan {
+
+	//default time between autosaves in minutes, 0 turns autosaving off
+	const int32_t c_DefaultAutosaveInterval = 5;
+	const int32_t c_MaxAutosaveInterval = 60;
+
+	struct EnvironmentSaveResult
+	{
+		std::string Path;
+		bool Succeeded = false;
+		bool Autosave = false;
+	};
+
+	//saves environments on its own thread so saving never stalls a frame, only the snapshot is taken on the
+	//calling thread. if a save is requested while one is being written the newest request replaces the one waiting
+	class EnvironmentSaver
+	{
+	public:
+		EnvironmentSaver();
+		//finishes the save that is being written and the one waiting behind it
+		~EnvironmentSaver();
+
+		EnvironmentSaver(const EnvironmentSaver&) = delete;
+		EnvironmentSaver& operator=(const EnvironmentSaver&) = delete;
+
+		void SaveAsync(const Environment& env, const std::string& path, bool autosave = false);
+		//true while a save is waiting or being written
+		bool IsSaving();
+		//saves that finished since the last call
+		std::vector<EnvironmentSaveResult> TakeResults();
+
+	private:
+		void SaverThreadLoop();
+
+	private:
+		struct SaveJob
+		{
+			std::shared_ptr<const EnvSnapshot> Snapshot; //nullptr if there is no job
+			std::string Path;
+			bool Autosave = false;
+		};
+
+		std::thread m_Thread;
+		std::mutex m_Mutex;
+		std::condition_variable m_JobCV;
+		SaveJob m_PendingJob;
+		bool m_Writing = false;
+		bool m_Stop = false;
+		std::vector<EnvironmentSaveResult> m_Results;
+	};
+}
@@ -1,15 +1,10 @@
 #include "Exporter.h"
 
-extern "C"
-{
-#include <libavformat/avformat.h>
-#include <libavformat/avio.h>
-#include <libavcodec/avcodec.h>
-#include <libavutil/imgutils.h>
-#include <libswscale/swscale.h>
-}
-
 #include "Editor.h"
+#include "ImageSequenceWriter.h"
+#ifdef AINAN_FFMPEG
+#include "VideoEncoder.h"
+#endif
 
 namespace Ainan {
 
@@ -34,6 +29,9 @@ namespace Ainan {
 		PictureSettings.ExportTargetLocation.m_FileName = "Example Name";
 		PictureSettings.ExportTargetLocation.FileExtension = ".png";
 		PictureSettings.ExportTargetPath = PictureSettings.ExportTargetLocation.GetSelectedSavePath();
+
+		FlipbookSettings.ExportTargetLocation.m_FileName = "Example Name";
+		FlipbookSettings.ExportTargetLocation.FileExtension = ".png";
 	}
 
 	void Exporter::ExportIfScheduled(Editor& editor)
@@ -42,10 +40,14 @@ namespace Ainan {
 			return;
 		m_ExporterScheduled = false;
 
-		if (m_Mode == ExportMode::Picture)
+		if (m_Mode == ExportMode::Picture && PictureSettings.Tiled)
+			ExportTiledImage(editor);
+		else if (m_Mode == ExportMode::Picture)
 			ExportImage(editor);
 		else if (m_Mode == ExportMode::Video)
 			ExportVideo(editor);
+		else if (m_Mode == ExportMode::Flipbook)
+			ExportFlipbook(editor);
 	}
 
 	void Exporter::DrawOutline()
@@ -87,17 +89,42 @@ namespace Ainan {
 		Camera.SetPosition(reversedPos * c_GlobalScaleFactor);
 	}
 
+	glm::ivec2 Exporter::GetExportSize()
+	{
+		float aspectRatio = (float)m_WidthRatio / m_HeightRatio;
+		return glm::ivec2(std::round(Camera.ZoomFactor * aspectRatio / 2.0f) * 2.0f, Camera.ZoomFactor);
+	}
+
+	glm::ivec2 Exporter::GetTiledExportSize()
+	{
+		float aspectRatio = (float)m_WidthRatio / m_HeightRatio;
+		int32_t width = std::clamp(PictureSettings.TiledWidth, 1, c_MaxTiledExportWidth);
+		return glm::ivec2(width, std::max((int32_t)std::round(width / aspectRatio), 1));
+	}
+
+	glm::ivec2 Exporter::GetFlipbookFrameSize()
+	{
+		float aspectRatio = (float)m_WidthRatio / m_HeightRatio;
+		int32_t height = std::clamp(FlipbookSettings.FrameHeight, 1, c_ExportTileSize);
+		return glm::ivec2(std::clamp((int32_t)std::round(height * aspectRatio), 1, c_ExportTileSize), height);
+	}
+
 	void Exporter::DrawEnvToExportSurface(Environment& env)
 	{
-		Camera.Update(0.0f, { 0, 0, (int)Window::FramebufferSize.x,(int)Window::FramebufferSize.y });
+		glm::ivec2 size = GetExportSize();
+		Camera.Update(0.0f, { 0, 0, size.x, size.y });
+		DrawEnvToExportSurface(env, Camera, size, env.BlurRadius);
+	}
+
+	void Exporter::DrawEnvToExportSurface(Environment& env, const Ainan::Camera& camera, glm::ivec2 size, float blurRadius)
+	{
 		SceneDescription desc;
-		desc.SceneCamera = Camera;
+		desc.SceneCamera = camera;
 		desc.SceneDrawTarget = &m_RenderSurface.SurfaceFrameBuffer;
 		desc.Blur = env.BlurEnabled;
-		desc.BlurRadius = env.BlurRadius;
+		desc.BlurRadius = blurRadius;
 		Renderer::BeginScene(desc);
-		float aspectRatio = (float)m_WidthRatio / m_HeightRatio;
-		m_RenderSurface.SetSize(glm::ivec2(std::round(Camera.ZoomFactor * aspectRatio / 2.0f) * 2.0f, Camera.ZoomFactor));
+		m_RenderSurface.SetSize(size);
 		m_RenderSurface.SurfaceFrameBuffer->Bind();
 		Renderer::ClearScreen();
 
@@ -127,7 +154,7 @@ namespace Ainan {
 		m_ExportTargetImage = new Image(m_RenderSurface.SurfaceFrameBuffer->ReadPixels());
 	}
 
-	void Exporter::DisplayGUI()
+	void Exporter::DisplayGUI(Environment& env)
 	{
 		ImGui::PushID(this);
 		if (m_ExporterWindowOpen)
@@ -152,11 +179,22 @@ namespace Ainan {
 					m_Mode = Picture;
 				}
 
+				bool is_flipbook = m_Mode == Flipbook ? true : false;
+				if (ImGui::Selectable(GetModeString(Flipbook).c_str(), &is_flipbook))
+				{
+					ImGui::SetItemDefaultFocus();
+					m_Mode = Flipbook;
+				}
+
 				ImGui::EndCombo();
 			}
 
 			if (m_Mode == ExportMode::Video)
 				DisplayVideoExportSettingsControls();
+			else if (m_Mode == ExportMode::Picture)
+				DisplayTiledPictureExportSettingsControls();
+			else if (m_Mode == ExportMode::Flipbook)
+				DisplayFlipbookExportSettingsControls(env);
 
 
 			if (ImGui::TreeNode("ExportMode Camera Settings"))
@@ -239,14 +277,111 @@ namespace Ainan {
 
 	void Exporter::DisplayVideoExportSettingsControls()
 	{
-		if (ImGui::Button("Save Location"))
-			VideoSettings.ExportTargetLocation.OpenWindow();
+		ImGui::Text("Target: ");
+#ifdef AINAN_FFMPEG
+		ImGui::SameLine();
+		if (ImGui::RadioButton("Video File", VideoSettings.Target == EncodedFile))
+			VideoSettings.Target = EncodedFile;
+#endif
+		ImGui::SameLine();
+		if (ImGui::RadioButton("Image Sequence", VideoSettings.Target == ImageSequence))
+			VideoSettings.Target = ImageSequence;
+		ImGui::SameLine();
+		if (ImGui::RadioButton("Raw Stream", VideoSettings.Target == RawStream))
+			VideoSettings.Target = RawStream;
+
+		//the save location shows the name of the first frame of image sequences
+		if (VideoSettings.Target == ImageSequence)
+			VideoSettings.ExportTargetLocation.FileExtension = "_000000." + Image::GetFormatString(VideoSettings.SequenceFormat);
+		else
+			VideoSettings.ExportTargetLocation.FileExtension = ".mp4";
 
-		VideoSettings.ExportTargetLocation.DisplayGUI([this](const std::string& path)
+		if (VideoSettings.Target == ImageSequence)
+		{
+			ImGui::Text("Image Format: ");
+			ImGui::SameLine();
+			ImGui::PushItemWidth(60);
+			if (ImGui::BeginCombo("##Sequence Format", Image::GetFormatString(VideoSettings.SequenceFormat).c_str()))
 			{
-				VideoSettings.ExportTargetPath = path + ".mp4";
-				VideoSettings.ExportTargetLocation.CloseWindow();
-			});
+				for (ImageFormat format : { ImageFormat::png, ImageFormat::bmp, ImageFormat::qoi })
+				{
+					bool selected = VideoSettings.SequenceFormat == format;
+					if (ImGui::Selectable(Image::GetFormatString(format).c_str(), &selected))
+						VideoSettings.SequenceFormat = format;
+				}
+				ImGui::EndCombo();
+			}
+			ImGui::PopItemWidth();
+
+			ImGui::SameLine();
+			ImGui::Text("Fast Compression: ");
+			ImGui::SameLine();
+			ImGui::Checkbox("##Fast Compression", &VideoSettings.FastCompression);
+			if (ImGui::IsItemHovered())
+			{
+				ImGui::BeginTooltip();
+				ImGui::Text("Writes png frames without compression, they are much bigger but take a fraction of the time");
+				ImGui::EndTooltip();
+			}
+		}
+
+		if (VideoSettings.Target != RawStream)
+		{
+			if (ImGui::Button("Save Location"))
+				VideoSettings.ExportTargetLocation.OpenWindow();
+
+			//the sink reads the path from ExportTargetLocation when the export starts
+			VideoSettings.ExportTargetLocation.DisplayGUI([this](const std::string& path)
+				{
+					VideoSettings.ExportTargetLocation.CloseWindow();
+				});
+		}
+		else
+		{
+			ImGui::Text("Container: ");
+			ImGui::SameLine();
+			ImGui::PushItemWidth(60);
+			if (ImGui::BeginCombo("##Container", RawVideoContainerStr(VideoSettings.RawContainer).c_str()))
+			{
+				for (RawVideoContainer container : { RawVideoContainer::Y4M, RawVideoContainer::Raw })
+				{
+					bool selected = VideoSettings.RawContainer == container;
+					if (ImGui::Selectable(RawVideoContainerStr(container).c_str(), &selected))
+						VideoSettings.RawContainer = container;
+				}
+				ImGui::EndCombo();
+			}
+			ImGui::PopItemWidth();
+
+			ImGui::Text("Destination: ");
+			ImGui::SameLine();
+			ImGui::InputText("##Destination", &VideoSettings.RawStreamDestination);
+			if (ImGui::IsItemHovered())
+			{
+				ImGui::BeginTooltip();
+				ImGui::Text("A file or named pipe, - for stdout, fd:N for an open file descriptor or |command to stream to a process");
+				ImGui::EndTooltip();
+			}
+		}
+
+		ImGui::Text("Framerate: ");
+		ImGui::SameLine();
+		ImGui::PushItemWidth(60);
+		if (ImGui::BeginCombo("##Framerate", std::to_string(VideoSettings.Framerate).c_str()))
+		{
+			for (int32_t framerate : c_VideoExportFramerates)
+			{
+				bool selected = VideoSettings.Framerate == framerate;
+				if (ImGui::Selectable(std::to_string(framerate).c_str(), &selected))
+					VideoSettings.Framerate = framerate;
+			}
+			ImGui::EndCombo();
+		}
+		ImGui::SameLine();
+		ImGui::Text("Substeps: ");
+		ImGui::SameLine();
+		ImGui::DragInt("##Substeps", &VideoSettings.Substeps, 0.1f, 1, c_MaxVideoExportSubsteps);
+		ImGui::PopItemWidth();
 
 		ImGui::PushItemWidth(25);
 		ImGui::Text("Length: ");
@@ -262,7 +397,179 @@ namespace Ainan {
 		ImGui::Text("Seconds");
 		ImGui::PopItemWidth();
 
-		ImGui::TextColored({ 0.0f, 0.8f, 0.0f, 1.0f }, VideoSettings.ExportTargetLocation.GetSelectedSavePath().c_str());
+		if (VideoSettings.Target != RawStream)
+			ImGui::TextColored({ 0.0f, 0.8f, 0.0f, 1.0f }, VideoSettings.ExportTargetLocation.GetSelectedSavePath().c_str());
+	}
+
+	void Exporter::DisplayTiledPictureExportSettingsControls()
+	{
+		ImGui::Text("Tiled: ");
+		ImGui::SameLine();
+		ImGui::Checkbox("##Tiled", &PictureSettings.Tiled);
+		if (ImGui::IsItemHovered())
+		{
+			ImGui::BeginTooltip();
+			ImGui::Text("Renders the picture in tiles and saves it while rendering, for pictures bigger than the window");
+			ImGui::EndTooltip();
+		}
+
+		if (!PictureSettings.Tiled)
+			return;
+
+		ImGui::Text("Width: ");
+		ImGui::SameLine();
+		ImGui::PushItemWidth(100);
+		ImGui::DragInt("##Tiled Width", &PictureSettings.TiledWidth, 16.0f, 1, c_MaxTiledExportWidth);
+		ImGui::PopItemWidth();
+		glm::ivec2 size = GetTiledExportSize();
+		ImGui::SameLine();
+		ImGui::Text("Resolution: %i, %i", size.x, size.y);
+
+		//jpeg can't be written a few rows at a time
+		if (PictureSettings.Format == ImageFormat::jpeg)
+			PictureSettings.Format = ImageFormat::png;
+
+		ImGui::Text("Image Format: ");
+		ImGui::SameLine();
+		ImGui::PushItemWidth(60);
+		if (ImGui::BeginCombo("##Tiled Image Format", Image::GetFormatString(PictureSettings.Format).c_str()))
+		{
+			for (ImageFormat format : { ImageFormat::png, ImageFormat::bmp, ImageFormat::qoi })
+			{
+				bool selected = PictureSettings.Format == format;
+				if (ImGui::Selectable(Image::GetFormatString(format).c_str(), &selected))
+					PictureSettings.Format = format;
+			}
+			ImGui::EndCombo();
+		}
+		ImGui::PopItemWidth();
+		if (ImGui::IsItemHovered())
+		{
+			ImGui::BeginTooltip();
+			ImGui::Text("png is saved without compression, use qoi for smaller files");
+			ImGui::EndTooltip();
+		}
+
+		PictureSettings.ExportTargetLocation.FileExtension = "." + Image::GetFormatString(PictureSettings.Format);
+		PictureSettings.ExportTargetPath = PictureSettings.ExportTargetLocation.GetSelectedSavePath();
+
+		if (ImGui::Button("Save Location"))
+			PictureSettings.ExportTargetLocation.OpenWindow();
+
+		ImGui::Text("Selected Save Path: ");
+		ImGui::SameLine();
+		ImGui::TextColored({ 0.0f, 0.8f, 0.0f, 1.0f }, PictureSettings.ExportTargetPath.u8string().c_str());
+	}
+
+	void Exporter::DisplayFlipbookExportSettingsControls(Environment& env)
+	{
+		ImGui::Text("Particle System: ");
+		ImGui::SameLine();
+		if (ImGui::BeginCombo("##Flipbook Particle System", FlipbookSettings.ParticleSystemName.c_str()))
+		{
+			for (pEnvironmentObject& obj : env.Objects)
+			{
+				if (obj->Type != ParticleSystemType)
+					continue;
+
+				bool selected = FlipbookSettings.ParticleSystemName == obj->m_Name;
+				if (ImGui::Selectable(obj->m_Name.c_str(), &selected))
+					FlipbookSettings.ParticleSystemName = obj->m_Name;
+			}
+			ImGui::EndCombo();
+		}
+
+		ImGui::PushItemWidth(100);
+		ImGui::Text("Frames: ");
+		ImGui::SameLine();
+		ImGui::DragInt("##Flipbook Frames", &FlipbookSettings.FrameCount, 1.0f, 1, c_MaxFlipbookFrameCount);
+		ImGui::SameLine();
+		ImGui::Text("Framerate: ");
+		ImGui::SameLine();
+		ImGui::DragInt("##Flipbook Framerate", &FlipbookSettings.Framerate, 1.0f, 1, 120);
+		ImGui::Text("Frame Height: ");
+		ImGui::SameLine();
+		ImGui::DragInt("##Flipbook Frame Height", &FlipbookSettings.FrameHeight, 1.0f, 16, c_ExportTileSize);
+		ImGui::PopItemWidth();
+		ImGui::SameLine();
+		ImGui::Text("Frame Size: %i, %i", GetFlipbookFrameSize().x, GetFlipbookFrameSize().y);
+
+		ImGui::Text("Trim: ");
+		ImGui::SameLine();
+		ImGui::Checkbox("##Flipbook Trim", &FlipbookSettings.Trim);
+		if (ImGui::IsItemHovered())
+		{
+			ImGui::BeginTooltip();
+			ImGui::Text("Crops every frame to the pixels that have something drawn in them");
+			ImGui::EndTooltip();
+		}
+
+		ImGui::SameLine();
+		ImGui::Text("Image Format: ");
+		ImGui::SameLine();
+		ImGui::PushItemWidth(60);
+		if (ImGui::BeginCombo("##Flipbook Image Format", Image::GetFormatString(FlipbookSettings.Format).c_str()))
+		{
+			for (ImageFormat format : { ImageFormat::png, ImageFormat::qoi })
+			{
+				bool selected = FlipbookSettings.Format == format;
+				if (ImGui::Selectable(Image::GetFormatString(format).c_str(), &selected))
+					FlipbookSettings.Format = format;
+			}
+			ImGui::EndCombo();
+		}
+		ImGui::PopItemWidth();
+
+		FlipbookSettings.ExportTargetLocation.FileExtension = "." + Image::GetFormatString(FlipbookSettings.Format);
+
+		if (ImGui::Button("Save Location"))
+			FlipbookSettings.ExportTargetLocation.OpenWindow();
+
+		FlipbookSettings.ExportTargetLocation.DisplayGUI([this](const std::string& path)
+			{
+				FlipbookSettings.ExportTargetLocation.CloseWindow();
+			});
+
+		ImGui::Text("Selected Save Path: ");
+		ImGui::SameLine();
+		ImGui::TextColored({ 0.0f, 0.8f, 0.0f, 1.0f }, FlipbookSettings.ExportTargetLocation.GetSelectedSavePath().c_str());
+	}
+
+	std::unique_ptr<VideoSink> Exporter::OpenVideoSink(glm::ivec2 frameSize, VideoFrameFormat format, bool flipVertically)
+	{
+		if (VideoSettings.Target == RawStream)
+		{
+			auto writer = std::make_unique<RawVideoWriter>();
+			if (!writer->Open(VideoSettings.RawStreamDestination, frameSize.x, frameSize.y, VideoSettings.Framerate,
+				format, VideoSettings.RawContainer, flipVertically))
+				return nullptr;
+
+			return writer;
+		}
+
+		if (VideoSettings.Target == ImageSequence)
+		{
+			std::string path = VideoSettings.ExportTargetLocation.GetSelectedSavePath();
+			std::string pathPrefix = path.substr(0, path.size() - VideoSettings.ExportTargetLocation.FileExtension.size());
+			auto writer = std::make_unique<ImageSequenceWriter>();
+			if (!writer->Open(pathPrefix, frameSize.x, frameSize.y, VideoSettings.SequenceFormat,
+				VideoSettings.FastCompression ? ImageCompression::Fast : ImageCompression::Default, flipVertically))
+				return nullptr;
+
+			return writer;
+		}
+
+#ifdef AINAN_FFMPEG
+		auto encoder = std::make_unique<VideoEncoder>();
+		if (!encoder->Open(VideoSettings.ExportTargetLocation.GetSelectedSavePath(), frameSize.x, frameSize.y, VideoSettings.Framerate,
+			format, flipVertically))
+			return nullptr;
+
+		return encoder;
+#else
+		AINAN_LOG_ERROR("Videos can only be exported as raw streams on this platform");
+		return nullptr;
+#endif
 	}
 
 	void Exporter::DisplayFinalizePictureExportSettingsWindow()
@@ -295,6 +602,13 @@ namespace Ainan {
 				PictureSettings.Format = ImageFormat::bmp;
 			}
 
+			bool is_qoi = PictureSettings.Format == ImageFormat::qoi ? true : false;
+			if (ImGui::Selectable(Image::GetFormatString(ImageFormat::qoi).c_str(), &is_qoi)) {
+
+				ImGui::SetItemDefaultFocus();
+				PictureSettings.Format = ImageFormat::qoi;
+			}
+
 			ImGui::EndCombo();
 		}
 
@@ -329,6 +643,18 @@ namespace Ainan {
 		ImGui::End();
 	}
 
+	void Exporter::UpdateProgressUI(Editor& editor, int32_t operationNum, int32_t operationCount, float fraction)
+	{
+		Renderer::SetRenderTargetApplicationWindow();
+		Renderer::ImGuiNewFrame();
+		ImGuiWrapper::BeginGlobalDocking(true);
+		DisplayProgressBarWindow(operationNum, operationCount, fraction);
+		editor.DrawUI();
+		ImGuiWrapper::EndGlobalDocking();
+		Renderer::ImGuiEndFrame();
+		Renderer::Present();
+	}
+
 	void Exporter::DisplayProgressBarWindow(int32_t operationNum, int32_t operationCount, float fraction)
 	{
 		ImGui::SetNextWindowPosCenter(ImGuiCond_Always);
@@ -348,13 +674,16 @@ namespace Ainan {
 	{
 		editor.PlayMode();
 
-		while (editor.m_TimeSincePlayModeStarted < ExportStartTime)
-			editor.Update();
+		//stills start from the same simulation state as a video export with the same settings
+		SimulateUntilExportStart(editor, VideoSettings.Framerate, std::clamp(VideoSettings.Substeps, 1, c_MaxVideoExportSubsteps), 1);
+		//textures that are still loading would be exported as transparent placeholders
+		TextureLoader::Flush();
 
 		DrawEnvToExportSurface(*editor.m_Env);
 		GetImageFromExportSurfaceToRAM();
 
-		if (Renderer::Rdata->CurrentActiveAPI->GetContext()->GetType() == RendererType::OpenGL)
+		auto type = Renderer::Rdata->CurrentActiveAPI->GetContext()->GetType();
+		if (type == RendererType::OpenGL || type == RendererType::Software)
 			m_ExportTargetImage->FlipHorizontally();
 
 		m_ExportTargetTexture = Renderer::CreateTexture(*m_ExportTargetImage);
@@ -364,118 +693,293 @@ namespace Ainan {
 		editor.Stop();
 	}
 
-#define CHECK(x) if((x) < 0) { AINAN_LOG_ERROR("Error while exporting video"); editor.Stop(); return; } 
-#define CHECKP(x) if((x) == 0) { AINAN_LOG_ERROR("Error while exporting video"); editor.Stop(); return; } 
+	void Exporter::SimulateUntilExportStart(Editor& editor, int32_t framerate, int32_t substeps, int32_t operationCount)
+	{
+		const float substepDeltaTime = 1.0f / ((float)framerate * substeps);
+		auto lastUIUpdate = std::chrono::high_resolution_clock::now();
+
+		//frames are counted instead of summing the delta times so rounding errors can't add or drop a frame
+		const int32_t startFrameCount = (int32_t)std::round(ExportStartTime * framerate);
+		for (int32_t i = 0; i < startFrameCount; i++)
+		{
+			for (int32_t j = 0; j < substeps; j++)
+				editor.Update(substepDeltaTime);
+
+			auto now = std::chrono::high_resolution_clock::now();
+			if (std::chrono::duration<float>(now - lastUIUpdate).count() >= c_ExportProgressUpdatePeriod)
+			{
+				lastUIUpdate = now;
+				UpdateProgressUI(editor, 1, operationCount, (float)i / startFrameCount);
+			}
+		}
+	}
 
 	void Exporter::ExportVideo(Editor& editor)
 	{
 		editor.PlayMode();
 
-		auto updateUI = [this, &editor](int32_t operationIndex, int32_t operationCount, float fraction)
+		//the progress bar is only redrawn every c_ExportProgressUpdatePeriod, so the simulation runs as fast as it can
+		auto lastUIUpdate = std::chrono::high_resolution_clock::now();
+		auto isUIUpdateDue = [&lastUIUpdate]()
 		{
-			Renderer::SetRenderTargetApplicationWindow();
-			Renderer::ImGuiNewFrame();
-			ImGuiWrapper::BeginGlobalDocking(true);
-			DisplayProgressBarWindow(operationIndex, operationCount, fraction);
-			editor.DrawUI();
-			ImGuiWrapper::EndGlobalDocking();
-			Renderer::ImGuiEndFrame();
-			Renderer::Present();
+			auto now = std::chrono::high_resolution_clock::now();
+			if (std::chrono::duration<float>(now - lastUIUpdate).count() < c_ExportProgressUpdatePeriod)
+				return false;
+
+			lastUIUpdate = now;
+			return true;
 		};
 
-		while (editor.m_TimeSincePlayModeStarted < ExportStartTime)
+		//every frame advances exactly 1 / Framerate seconds of simulated time no matter how long it took to export,
+		//so the same environment always exports to the same video, substeps split that into smaller updates
+		const int32_t substeps = std::clamp(VideoSettings.Substeps, 1, c_MaxVideoExportSubsteps);
+		const float substepDeltaTime = 1.0f / ((float)VideoSettings.Framerate * substeps);
+		auto simulateFrame = [&editor, substeps, substepDeltaTime]()
 		{
-			editor.Update();
-			updateUI(1,2, editor.m_TimeSincePlayModeStarted / ExportStartTime);
-		}
+			for (int32_t i = 0; i < substeps; i++)
+				editor.Update(substepDeltaTime);
+		};
 
+		SimulateUntilExportStart(editor, VideoSettings.Framerate, substeps, 2);
+		//textures that are still loading would be exported as transparent placeholders
+		TextureLoader::Flush();
+
+		glm::ivec2 size = GetExportSize();
 		DrawEnvToExportSurface(*editor.m_Env);
-		GetImageFromExportSurfaceToRAM();
-		const AVPixelFormat fmt = AV_PIX_FMT_YUV420P;
-
-		AVFormatContext* fContext = nullptr;
-		AVCodecContext* cContext = nullptr;
-		AVStream* vStream = nullptr;
-		AVCodec* codec = avcodec_find_encoder(AV_CODEC_ID_H264);
-		cContext = avcodec_alloc_context3(codec);
-		int32_t result = 0;
-		result = avformat_alloc_output_context2(&fContext, nullptr, nullptr, VideoSettings.ExportTargetLocation.GetSelectedSavePath().c_str());
-		CHECK(result);
-		int32_t totalFrameCount = 60 * VideoSettings.LengthSeconds + 60 * VideoSettings.LengthSeconds * VideoSettings.LengthMinutes;
-		fContext->duration = totalFrameCount;
-
-		vStream = avformat_new_stream(fContext, codec);
-		vStream->codecpar->format = fmt;
-		vStream->codecpar->width = std::round(m_ExportTargetImage->m_Width / 2.0f) * 2;
-		vStream->codecpar->height = std::round(m_ExportTargetImage->m_Height / 2.0f) * 2;
-		vStream->codecpar->codec_type = AVMEDIA_TYPE_VIDEO;
-		vStream->codecpar->codec_id = AV_CODEC_ID_H264;
-		CHECKP(vStream);
-
-		result = avio_open(&fContext->pb, fContext->filename, AVIO_FLAG_WRITE);
-		CHECK(result);
-
-		cContext->width = vStream->codecpar->width;
-		cContext->height = vStream->codecpar->height;
-		cContext->pix_fmt = fmt;
-		cContext->framerate = AVRational{ 60,1 };
-		cContext->time_base = AVRational{ 1, 60 };
-
-		result = avcodec_open2(cContext, codec, 0);
-		CHECK(result);
-
-		vStream->codec->width = cContext->width;
-		vStream->codec->height = cContext->height;
-		vStream->codec->pix_fmt = cContext->pix_fmt;
-		vStream->codec->framerate = cContext->framerate;
-		vStream->codec->time_base = cContext->time_base;
-
-		result = avformat_write_header(fContext, 0);
-		CHECK(result);
-
-		AVPacket* pkt = av_packet_alloc();
-		AVFrame* frame = av_frame_alloc();
-		SwsContext* swsContext = sws_getContext(cContext->width, cContext->height, AV_PIX_FMT_RGBA,
-			cContext->width, cContext->height, fmt, 0, 0, 0, 0);
-		CHECKP(swsContext);
-		frame->width = cContext->width;
-		frame->height = cContext->height;
-		frame->format = fmt;
-		frame->color_range = AVColorRange::AVCOL_RANGE_MPEG;
-		av_image_alloc(frame->data, frame->linesize, frame->width, frame->height, fmt, 1);
-		for (size_t i = 0; i < totalFrameCount; i++)
+		//the surface is resized by the renderer thread, readbacks use its size
+		Renderer::WaitUntilRendererIdle();
+
+		auto type = Renderer::Rdata->CurrentActiveAPI->GetContext()->GetType();
+		bool flipVertically = type == RendererType::OpenGL || type == RendererType::Software;
+
+		//the gpu converts frames to yuv before they are read back, which reads back 1.5 bytes per pixel instead of 4,
+		//the software and null renderers don't have the shader so they read back rgba and the encoder converts it with swscale,
+		//image sequences are written as rgba
+		bool convertOnGPU = VideoSettings.Target != ImageSequence && type != RendererType::Software && type != RendererType::Null;
+		//the shader matches swscale's chroma filter from c_MinGPUYUVConversionHeight up, raw streams have no other converter
+		if (VideoSettings.Target == EncodedFile && YUV420Layout(size).VideoSize.y < c_MinGPUYUVConversionHeight)
+			convertOnGPU = false;
+		std::shared_ptr<FrameBuffer> yuvFrameBuffer;
+		if (convertOnGPU)
+			yuvFrameBuffer = Renderer::CreateFrameBuffer(glm::vec2(YUV420Layout(size).TargetSize));
+		std::shared_ptr<FrameBuffer>& readbackFrameBuffer = convertOnGPU ? yuvFrameBuffer : m_RenderSurface.SurfaceFrameBuffer;
+		glm::ivec2 readbackSize = convertOnGPU ? YUV420Layout(size).TargetSize : size;
+
+		auto sink = OpenVideoSink(size, convertOnGPU ? VideoFrameFormat::PackedYUV420 : VideoFrameFormat::RGBA, flipVertically);
+		if (!sink)
+		{
+			editor.Stop();
+			return;
+		}
+
+		//the main thread simulates and renders, readbacks and the threads of the sink run behind it
+		int32_t totalFrameCount = VideoSettings.Framerate * (VideoSettings.LengthMinutes * 60 + VideoSettings.LengthSeconds);
+		for (int32_t i = 0; i < totalFrameCount; i++)
 		{
-			result = 0;
-			
-			frame->pts = av_rescale_q(i, cContext->time_base, vStream->time_base);
-			int rgba_stride[4] = { 4 * frame->width, 0, 0, 0 };
-			int dst_stride[4] = { frame->height, 0, 0, 0 };
-			int idk = av_image_get_buffer_size(AV_PIX_FMT_RGBA, frame->width, frame->height, 1);
-			result = sws_scale(swsContext, &m_ExportTargetImage->m_Data, rgba_stride, 0, frame->height, frame->data, frame->linesize);
-			CHECK(result);
-			result = avcodec_send_frame(cContext, frame);
-			CHECK(result);
-			result = avcodec_receive_packet(cContext, pkt);
-			if (result != -11)
+			if (i > 0)
 			{
-				result = av_interleaved_write_frame(fContext, pkt);
+				simulateFrame();
+				DrawEnvToExportSurface(*editor.m_Env);
 			}
-			editor.Update();
-			DrawEnvToExportSurface(*editor.m_Env);
-			GetImageFromExportSurfaceToRAM();
-			updateUI(2, 2, (float)i / totalFrameCount);
+
+			if (convertOnGPU)
+				Renderer::ConvertToYUV420(m_RenderSurface.SurfaceFrameBuffer, yuvFrameBuffer, flipVertically);
+
+			uint8_t* pixels = sink->AcquireFrame();
+			if (!pixels)
+				break;
+			sink->SubmitFrame(pixels, readbackFrameBuffer->ReadPixelsAsync(pixels, readbackSize));
+
+			if (isUIUpdateDue())
+				UpdateProgressUI(editor, 2, 2, (float)sink->GetWrittenFrameCount() / totalFrameCount);
 		}
-		av_packet_unref(pkt);
-		av_freep(&frame->data[0]);
-		av_frame_free(&frame);
-		sws_freeContext(swsContext);
+		readbackFrameBuffer->FlushReadbacks();
+
+		if (!sink->Finish())
+			AINAN_LOG_ERROR("Error while exporting video");
+
+		editor.Stop();
+	}
+
+	void Exporter::ExportTiledImage(Editor& editor)
+	{
+		Environment& env = *editor.m_Env;
+		glm::ivec2 imageSize = GetTiledExportSize();
+
+		ImageStreamWriter writer;
+		if (!writer.Open(PictureSettings.ExportTargetPath.u8string(), imageSize.x, imageSize.y, PictureSettings.Format))
+			return;
+
+		editor.PlayMode();
+
+		//stills start from the same simulation state as a video export with the same settings
+		SimulateUntilExportStart(editor, VideoSettings.Framerate, std::clamp(VideoSettings.Substeps, 1, c_MaxVideoExportSubsteps), 1);
+		//textures that are still loading would be exported as transparent placeholders
+		TextureLoader::Flush();
+
+		//the blur radius is in pixels, so it grows with the resolution to look the same as a normal export,
+		//and every tile is rendered with a border wide enough for the blur to sample the same pixels it would in one big image
+		float pixelScale = (float)imageSize.y / GetExportSize().y;
+		float blurRadius = env.BlurRadius * pixelScale;
+		int32_t border = env.BlurEnabled ? (int32_t)std::ceil(4.0f * blurRadius) + 1 : 0;
+
+		//the camera covers exactly the whole image, every tile crops its own part of the projection
+		Camera.Update(0.0f, { 0, 0, imageSize.x, imageSize.y });
+
+		auto type = Renderer::Rdata->CurrentActiveAPI->GetContext()->GetType();
+		bool flipVertically = type == RendererType::OpenGL || type == RendererType::Software;
+
+		//only a single row of tiles is kept in memory, it's written out before the next one is rendered
+		const int32_t tileColumnCount = (imageSize.x + c_ExportTileSize - 1) / c_ExportTileSize;
+		const int32_t tileRowCount = (imageSize.y + c_ExportTileSize - 1) / c_ExportTileSize;
+		const size_t imageRowSize = (size_t)imageSize.x * 4;
+		std::vector<uint8_t> strip(imageRowSize * std::min(imageSize.y, c_ExportTileSize));
+		std::vector<uint8_t> tilePixels;
+
+		auto lastUIUpdate = std::chrono::high_resolution_clock::now();
+		bool succeeded = true;
+		for (int32_t tileRow = 0; tileRow < tileRowCount && succeeded; tileRow++)
+		{
+			//rows are counted from the top of the image
+			int32_t firstRow = tileRow * c_ExportTileSize;
+			int32_t rowCount = std::min(c_ExportTileSize, imageSize.y - firstRow);
+
+			for (int32_t tileColumn = 0; tileColumn < tileColumnCount; tileColumn++)
+			{
+				int32_t firstColumn = tileColumn * c_ExportTileSize;
+				int32_t columnCount = std::min(c_ExportTileSize, imageSize.x - firstColumn);
+				glm::ivec2 surfaceSize = glm::ivec2(columnCount, rowCount) + 2 * border;
+
+				//the region of the image this tile and its border cover, where 0,0 is the bottom left of the image
+				glm::vec2 bottomLeft = glm::vec2(firstColumn - border, imageSize.y - firstRow - rowCount - border) / glm::vec2(imageSize);
+				glm::vec2 topRight = bottomLeft + glm::vec2(surfaceSize) / glm::vec2(imageSize);
+				Ainan::Camera tileCamera = Camera;
+				tileCamera.CropProjection(bottomLeft, topRight);
+
+				DrawEnvToExportSurface(env, tileCamera, surfaceSize, blurRadius);
+				//the surface is resized by the renderer thread and tiles at the edges are smaller, readbacks use its size
+				Renderer::WaitUntilRendererIdle();
+
+				tilePixels.resize((size_t)surfaceSize.x * surfaceSize.y * 4);
+				auto readback = m_RenderSurface.SurfaceFrameBuffer->ReadPixelsAsync(tilePixels.data(), surfaceSize);
+				m_RenderSurface.SurfaceFrameBuffer->FlushReadbacks();
+				if (!readback.get())
+				{
+					succeeded = false;
+					break;
+				}
+
+				//copy the tile without its border into the strip
+				for (int32_t y = 0; y < rowCount; y++)
+				{
+					int32_t surfaceRow = flipVertically ? surfaceSize.y - 1 - border - y : border + y;
+					const uint8_t* source = &tilePixels[((size_t)surfaceRow * surfaceSize.x + border) * 4];
+					memcpy(&strip[imageRowSize * y + (size_t)firstColumn * 4], source, (size_t)columnCount * 4);
+				}
+
+				auto now = std::chrono::high_resolution_clock::now();
+				if (std::chrono::duration<float>(now - lastUIUpdate).count() >= c_ExportProgressUpdatePeriod)
+				{
+					lastUIUpdate = now;
+					float fraction = (float)(tileRow * tileColumnCount + tileColumn + 1) / (tileRowCount * tileColumnCount);
+					UpdateProgressUI(editor, 1, 1, fraction);
+				}
+			}
 
-		result = av_write_trailer(fContext);
-		CHECK(result);
+			succeeded = succeeded && writer.WriteRows(strip.data(), rowCount, (int32_t)imageRowSize);
+		}
+
+		if (!writer.Close() || !succeeded)
+			AINAN_LOG_ERROR("Error while exporting tiled image");
+
+		editor.Stop();
+	}
+
+	void Exporter::ExportFlipbook(Editor& editor)
+	{
+		Environment& env = *editor.m_Env;
+		auto findParticleSystem = [this, &env]() -> EnvironmentObjectInterface*
+		{
+			for (pEnvironmentObject& obj : env.Objects)
+				if (obj->Type == ParticleSystemType && obj->m_Name == FlipbookSettings.ParticleSystemName)
+					return obj.get();
+			return nullptr;
+		};
+
+		if (!findParticleSystem())
+		{
+			AINAN_LOG_ERROR("Select a particle system to export as a flipbook");
+			return;
+		}
+
+		editor.PlayMode();
+
+		//the whole environment is simulated like a normal export, only the selected particle system is drawn
+		SimulateUntilExportStart(editor, std::max(FlipbookSettings.Framerate, 1), 1, 1);
+		//textures that are still loading would be exported as transparent placeholders
+		TextureLoader::Flush();
+
+		glm::ivec2 frameSize = GetFlipbookFrameSize();
+		Camera.Update(0.0f, { 0, 0, frameSize.x, frameSize.y });
+
+		auto type = Renderer::Rdata->CurrentActiveAPI->GetContext()->GetType();
+		bool flipVertically = type == RendererType::OpenGL || type == RendererType::Software;
+
+		const int32_t frameCount = std::clamp(FlipbookSettings.FrameCount, 1, c_MaxFlipbookFrameCount);
+		const int32_t framerate = std::max(FlipbookSettings.Framerate, 1);
+		const size_t rowSize = (size_t)frameSize.x * 4;
+		FlipbookAtlas atlas(frameSize, framerate, FlipbookSettings.Trim);
+		std::vector<uint8_t> pixels(rowSize * frameSize.y);
+
+		auto lastUIUpdate = std::chrono::high_resolution_clock::now();
+		bool succeeded = true;
+		for (int32_t i = 0; i < frameCount; i++)
+		{
+			if (i > 0)
+				editor.Update(1.0f / framerate);
+
+			//the user can't delete it while exporting but the simulation could
+			EnvironmentObjectInterface* particleSystem = findParticleSystem();
+			if (!particleSystem)
+				break;
+
+			//drawn without lights and blur, those belong to the scene the flipbook is played in
+			SceneDescription desc;
+			desc.SceneCamera = Camera;
+			desc.SceneDrawTarget = &m_RenderSurface.SurfaceFrameBuffer;
+			desc.Blur = false;
+			Renderer::BeginScene(desc);
+			m_RenderSurface.SetSize(frameSize);
+			m_RenderSurface.SurfaceFrameBuffer->Bind();
+			Renderer::ClearScreen();
+			particleSystem->Draw();
+			Renderer::EndScene();
+			//the surface is resized by the renderer thread, readbacks use its size
+			Renderer::WaitUntilRendererIdle();
+
+			auto readback = m_RenderSurface.SurfaceFrameBuffer->ReadPixelsAsync(pixels.data(), frameSize);
+			m_RenderSurface.SurfaceFrameBuffer->FlushReadbacks();
+			if (!readback.get())
+			{
+				succeeded = false;
+				break;
+			}
+
+			if (flipVertically)
+				atlas.AddFrame(&pixels[rowSize * (frameSize.y - 1)], -(int32_t)rowSize);
+			else
+				atlas.AddFrame(pixels.data(), (int32_t)rowSize);
+
+			auto now = std::chrono::high_resolution_clock::now();
+			if (std::chrono::duration<float>(now - lastUIUpdate).count() >= c_ExportProgressUpdatePeriod)
+			{
+				lastUIUpdate = now;
+				UpdateProgressUI(editor, 1, 1, (float)(i + 1) / frameCount);
+			}
+		}
 
-		avio_close(fContext->pb);
-		avcodec_free_context(&cContext);
-		avformat_free_context(fContext);
+		if (!succeeded || !atlas.Save(FlipbookSettings.ExportTargetLocation.GetSelectedSavePath(), FlipbookSettings.Format))
+			AINAN_LOG_ERROR("Error while exporting flipbook");
 
 		editor.Stop();
 	}
@@ -11,27 +11,54 @@
 #include "environment/EnvironmentObjectInterface.h"
 #include "renderer/RenderSurface.h"
 #include "renderer/Image.h"
+#include "editor/RawVideoWriter.h"
+#include "editor/FlipbookAtlas.h"
 
 namespace Ainan {
 
 	const glm::vec4 c_OutlineColor = { 0.8f, 0.0, 0.0f, 0.8f };
+	//seconds between redraws of the progress bar while exporting, drawing it every frame would limit exporting to the editor framerate
+	const float c_ExportProgressUpdatePeriod = 0.1f;
+	//video exports are simulated offline, so any of these framerates can be exported regardless of how fast the machine is
+	const std::array<int32_t, 4> c_VideoExportFramerates = { 24, 30, 60, 120 };
+	const int32_t c_MaxVideoExportSubsteps = 8;
+	//tiled picture exports render this many pixels per tile in both directions, plus a border for the blur
+	const int32_t c_ExportTileSize = 2048;
+	const int32_t c_MaxTiledExportWidth = 65536;
+	const int32_t c_MaxFlipbookFrameCount = 1024;
+
+	class Editor;
 
 	class Exporter 
 	{
 		enum ExportMode
 		{
 			Picture,
-			Video
+			Video,
+			//renders a single particle system into a sprite sheet, see FlipbookAtlas
+			Flipbook
+		};
+
+		enum VideoTarget
+		{
+			//encoded with ffmpeg, only on platforms it is linked on
+			EncodedFile,
+			//an image per frame, see ImageSequenceWriter
+			ImageSequence,
+			//streamed uncompressed to an external encoder, see RawVideoWriter
+			RawStream
 		};
 	public:
 		Exporter();
 		void DrawOutline();
-		void DisplayGUI();
+		void DisplayGUI(Environment& env);
 		void OpenExporterWindow();
 
 		void ExportIfScheduled(Editor& editor);
 		void ExportImage(Editor& editor);
 		void ExportVideo(Editor& editor);
+		void ExportTiledImage(Editor& editor);
+		void ExportFlipbook(Editor& editor);
 
 	public:
 		bool SettingsWindowOpen = true;
@@ -44,14 +71,25 @@ namespace Ainan {
 		Image* m_ExportTargetImage = nullptr;
 		std::shared_ptr<Texture> m_ExportTargetTexture = nullptr;
 
-		Camera Camera;
+		Ainan::Camera Camera;
 		RenderSurface m_RenderSurface;
 
 		struct ExportVideoSettings
 		{
 			SaveItemBrowser ExportTargetLocation;
-			std::filesystem::path ExportTargetPath;
 			int32_t Framerate = 60;
+			//simulation updates per exported frame, each one advances 1 / (Framerate * Substeps) seconds
+			int32_t Substeps = 1;
+#ifdef AINAN_FFMPEG
+			VideoTarget Target = EncodedFile;
+#else
+			VideoTarget Target = RawStream;
+#endif
+			ImageFormat SequenceFormat = ImageFormat::png;
+			bool FastCompression = true;
+			RawVideoContainer RawContainer = RawVideoContainer::Y4M;
+			//see RawVideoWriter::Open
+			std::string RawStreamDestination = "|ffmpeg -y -i - output.mp4";
 			int32_t LengthMinutes = 0;
 			int32_t LengthSeconds = 5;
 		} VideoSettings;
@@ -61,17 +99,46 @@ namespace Ainan {
 			SaveItemBrowser ExportTargetLocation;
 			std::filesystem::path ExportTargetPath;
 			ImageFormat Format = ImageFormat::png;
+			//renders the picture in tiles and writes it to ExportTargetPath a few rows at a time,
+			//so it can be bigger than the framebuffer and the memory allow
+			bool Tiled = false;
+			int32_t TiledWidth = 16384;
 		} PictureSettings;
 
+		struct ExportFlipbookSettings
+		{
+			SaveItemBrowser ExportTargetLocation;
+			//looked up by name when exporting, because objects can be deleted and reordered before that
+			std::string ParticleSystemName;
+			int32_t FrameCount = 64;
+			int32_t Framerate = 30;
+			//the width follows the export ratio
+			int32_t FrameHeight = 256;
+			bool Trim = true;
+			ImageFormat Format = ImageFormat::png;
+		} FlipbookSettings;
+
 		//this means after x seconds we will capture the frame using this exporter
 		float ExportStartTime = 5.0f;
 	private:
 		void SetSize();
+		glm::ivec2 GetExportSize();
+		glm::ivec2 GetTiledExportSize();
+		glm::ivec2 GetFlipbookFrameSize();
 		void DrawEnvToExportSurface(Environment& env);
+		void DrawEnvToExportSurface(Environment& env, const Ainan::Camera& camera, glm::ivec2 size, float blurRadius);
 		void GetImageFromExportSurfaceToRAM();
 		void DisplayVideoExportSettingsControls();
+		void DisplayTiledPictureExportSettingsControls();
+		void DisplayFlipbookExportSettingsControls(Environment& env);
+		std::unique_ptr<VideoSink> OpenVideoSink(glm::ivec2 frameSize, VideoFrameFormat format, bool flipVertically);
 		void DisplayFinalizePictureExportSettingsWindow();
 		void DisplayProgressBarWindow(int32_t operationNum, int32_t operationCount, float fraction);
+		//draws the editor with the progress bar on top while an export blocks the main loop
+		void UpdateProgressUI(Editor& editor, int32_t operationNum, int32_t operationCount, float fraction);
+		//simulates ExportStartTime seconds in fixed steps of 1 / (framerate * substeps) so every export of the same
+		//environment starts from the same state, shown as the first of operationCount operations in the progress bar
+		void SimulateUntilExportStart(Editor& editor, int32_t framerate, int32_t substeps, int32_t operationCount);
 
 	private:
 		bool m_ExporterWindowOpen = false;
@@ -94,6 +161,9 @@ namespace Ainan {
 			case Video:
 				return "Video";
 
+			case Flipbook:
+				return "Flipbook";
+
 			default:
 				return "";
 			}
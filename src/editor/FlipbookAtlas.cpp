@@ -0,0 +1,152 @@
+#include "FlipbookAtlas.h"
+
+#include <json/json.hpp>
+
+namespace Ainan {
+
+	FlipbookAtlas::FlipbookAtlas(glm::ivec2 frameSize, int32_t framerate, bool trim) :
+		m_FrameSize(frameSize),
+		m_Framerate(framerate),
+		m_Trim(trim)
+	{
+		assert(frameSize.x > 0 && frameSize.y > 0);
+	}
+
+	void FlipbookAtlas::AddFrame(const uint8_t* firstRow, int32_t stride)
+	{
+		glm::ivec2 min = { 0, 0 };
+		glm::ivec2 max = m_FrameSize - 1;
+
+		if (m_Trim)
+		{
+			min = m_FrameSize;
+			max = { -1, -1 };
+			for (int32_t y = 0; y < m_FrameSize.y; y++)
+			{
+				const uint8_t* row = firstRow + (ptrdiff_t)y * stride;
+				for (int32_t x = 0; x < m_FrameSize.x; x++)
+				{
+					const uint8_t* pixel = row + x * 4;
+					if (pixel[0] == 0 && pixel[1] == 0 && pixel[2] == 0)
+						continue;
+
+					min = glm::min(min, glm::ivec2(x, y));
+					max = glm::max(max, glm::ivec2(x, y));
+				}
+			}
+		}
+
+		FlipbookCell cell;
+		if (max.x >= min.x)
+		{
+			cell.TrimOffset = min;
+			cell.Size = max - min + 1;
+			size_t rowSize = (size_t)cell.Size.x * 4;
+			cell.Pixels.resize(rowSize * cell.Size.y);
+			for (int32_t y = 0; y < cell.Size.y; y++)
+				memcpy(&cell.Pixels[rowSize * y], firstRow + (ptrdiff_t)(min.y + y) * stride + (size_t)min.x * 4, rowSize);
+		}
+
+		m_Cells.push_back(std::move(cell));
+	}
+
+	glm::ivec2 FlipbookAtlas::Pack()
+	{
+		//aim for a square atlas, but at least as wide as the widest cell
+		int64_t area = 0;
+		int32_t width = 1;
+		for (auto& cell : m_Cells)
+		{
+			area += (int64_t)(cell.Size.x + c_FlipbookCellPadding) * (cell.Size.y + c_FlipbookCellPadding);
+			width = std::max(width, cell.Size.x);
+		}
+		width = std::max(width, (int32_t)std::ceil(std::sqrt((double)area)));
+
+		std::vector<FlipbookCell*> order;
+		for (auto& cell : m_Cells)
+			if (cell.Size.x > 0)
+				order.push_back(&cell);
+		std::stable_sort(order.begin(), order.end(), [](const FlipbookCell* a, const FlipbookCell* b) { return a->Size.y > b->Size.y; });
+
+		glm::ivec2 size = { 1, 1 };
+		glm::ivec2 cursor = { 0, 0 };
+		int32_t rowHeight = 0;
+		for (FlipbookCell* cell : order)
+		{
+			if (cursor.x > 0 && cursor.x + cell->Size.x > width)
+			{
+				cursor = { 0, cursor.y + rowHeight + c_FlipbookCellPadding };
+				rowHeight = 0;
+			}
+
+			cell->AtlasPosition = cursor;
+			size = glm::max(size, cursor + cell->Size);
+			cursor.x += cell->Size.x + c_FlipbookCellPadding;
+			rowHeight = std::max(rowHeight, cell->Size.y);
+		}
+
+		return size;
+	}
+
+	bool FlipbookAtlas::Save(const std::string& imagePath, ImageFormat format)
+	{
+		glm::ivec2 atlasSize = Pack();
+
+		size_t atlasRowSize = (size_t)atlasSize.x * 4;
+		std::vector<uint8_t> atlas(atlasRowSize * atlasSize.y, 0);
+		for (auto& cell : m_Cells)
+		{
+			size_t rowSize = (size_t)cell.Size.x * 4;
+			for (int32_t y = 0; y < cell.Size.y; y++)
+				memcpy(&atlas[atlasRowSize * (cell.AtlasPosition.y + y) + (size_t)cell.AtlasPosition.x * 4], &cell.Pixels[rowSize * y], rowSize);
+		}
+
+		ImageEncoder encoder;
+		if (!encoder.Encode(atlas.data(), atlasSize.x, atlasSize.y, 4, (int32_t)atlasRowSize, format) || !encoder.WriteToFile(imagePath))
+		{
+			AINAN_LOG_ERROR("Could not write flipbook atlas to " + imagePath);
+			return false;
+		}
+
+		std::filesystem::path metadataPath = imagePath;
+		std::string imageName = metadataPath.filename().u8string();
+		metadataPath.replace_extension(".json");
+		return SaveMetadata(metadataPath.u8string(), imageName, atlasSize);
+	}
+
+	bool FlipbookAtlas::SaveMetadata(const std::string& path, const std::string& imageName, glm::ivec2 atlasSize)
+	{
+		//laid out like the common sprite sheet formats, positions are in pixels from the top left
+		nlohmann::json data;
+		data["Image"] = imageName;
+		data["Size"] = { atlasSize.x, atlasSize.y };
+		data["FrameSize"] = { m_FrameSize.x, m_FrameSize.y };
+		data["Framerate"] = m_Framerate;
+		data["FrameDuration"] = 1.0f / m_Framerate;
+		data["Trimmed"] = m_Trim;
+
+		nlohmann::json frames = nlohmann::json::array();
+		for (size_t i = 0; i < m_Cells.size(); i++)
+		{
+			const FlipbookCell& cell = m_Cells[i];
+			nlohmann::json frame;
+			frame["Time"] = (float)i / m_Framerate;
+			frame["Rect"] = { cell.AtlasPosition.x, cell.AtlasPosition.y, cell.Size.x, cell.Size.y };
+			frame["Offset"] = { cell.TrimOffset.x, cell.TrimOffset.y };
+			frames.push_back(frame);
+		}
+		data["Frames"] = frames;
+
+		std::string jsonString = data.dump(4);
+
+		FILE* file = fopen(path.c_str(), "w");
+		if (!file)
+		{
+			AINAN_LOG_ERROR("Could not write flipbook metadata to " + path);
+			return false;
+		}
+		bool succeeded = fwrite(jsonString.c_str(), 1, jsonString.size(), file) == jsonString.size();
+		succeeded = fclose(file) == 0 && succeeded;
+		return succeeded;
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "renderer/ImageEncoder.h"
+
+namespace Ainan {
+
+	//pixels between the cells of a flipbook so bilinear sampling of a cell never reads its neighbours
+	const int32_t c_FlipbookCellPadding = 1;
+
+	//a frame of a flipbook and where it ended up in the atlas
+	struct FlipbookCell
+	{
+		//top left of the cell in the atlas
+		glm::ivec2 AtlasPosition = { 0, 0 };
+		//0, 0 for frames with nothing drawn in them
+		glm::ivec2 Size = { 0, 0 };
+		//where the trimmed pixels were in the untrimmed frame, from its top left
+		glm::ivec2 TrimOffset = { 0, 0 };
+		std::vector<uint8_t> Pixels;
+	};
+
+	//packs the frames of an effect into a single image so a game engine can play it back on one textured quad,
+	//frames are trimmed to the pixels that aren't black because effects are drawn additively on black,
+	//the metadata is written next to the atlas as json with the same name
+	class FlipbookAtlas
+	{
+	public:
+		FlipbookAtlas(glm::ivec2 frameSize, int32_t framerate, bool trim);
+
+		//pixels are rgba, stride can be negative if the rows are stored bottom to top
+		void AddFrame(const uint8_t* firstRow, int32_t stride);
+		//packs every added frame and writes the atlas and its metadata
+		bool Save(const std::string& imagePath, ImageFormat format);
+
+		size_t GetFrameCount() const { return m_Cells.size(); }
+
+	private:
+		//packs the cells in rows (tallest first) and returns the size of the atlas
+		glm::ivec2 Pack();
+		bool SaveMetadata(const std::string& path, const std::string& imageName, glm::ivec2 atlasSize);
+
+	private:
+		glm::ivec2 m_FrameSize;
+		int32_t m_Framerate;
+		bool m_Trim;
+		std::vector<FlipbookCell> m_Cells;
+	};
+}
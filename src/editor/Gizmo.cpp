@@ -99,7 +99,8 @@ namespace Ainan {
 		layout[1] = VertexLayoutElement("NORMAL", 0, ShaderVariableType::Vec4);
 		m_VertexBuffer = Renderer::CreateVertexBuffer((void*)arrowVertices, sizeof(arrowVertices), layout, Renderer::ShaderLibrary()["GizmoShader"]);
 
-		if(Renderer::Rdata->CurrentActiveAPI->GetContext()->GetType() == RendererType::OpenGL)
+		auto type = Renderer::Rdata->CurrentActiveAPI->GetContext()->GetType();
+		if(type == RendererType::OpenGL || type == RendererType::Software)
 			m_IndexBuffer = Renderer::CreateIndexBuffer((uint32_t*)c_OpenGLArrowIndecies, sizeof(c_OpenGLArrowIndecies) / sizeof(uint32_t));
 		else
 			m_IndexBuffer = Renderer::CreateIndexBuffer((uint32_t*)c_DirectXArrowIndecies, sizeof(c_DirectXArrowIndecies) / sizeof(uint32_t));
@@ -152,7 +153,9 @@ namespace Ainan {
 		shader->BindUniformBuffer(m_UniformBuffer, 1, RenderingStage::VertexShader);
 		m_UniformBuffer->UpdateData(&data);
 
+		Renderer::BeginPass(RenderPass::Gizmo);
 		Renderer::Draw(m_VertexBuffer, shader, Primitive::Triangles, m_IndexBuffer);
+		Renderer::EndPass();
 	}
 
 	//we are treating arrow hitboxes as rectangles for now
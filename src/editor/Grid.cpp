@@ -64,6 +64,8 @@ namespace Ainan {
 		Renderer::WaitUntilRendererIdle();
 
 		shader->BindUniformBuffer(m_TransformUniformBuffer, 1, RenderingStage::VertexShader);
+		Renderer::BeginPass(RenderPass::Grid);
 		Renderer::Draw(m_VertexBuffer, shader, Primitive::Lines, m_IndexBuffer);
+		Renderer::EndPass();
 	}
 }
\ No newline at end of file
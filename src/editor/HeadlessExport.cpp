@@ -0,0 +1,193 @@
+#include "HeadlessExport.h"
+
+#include "Editor.h"
+#include "Camera.h"
+#include "file/AssetManager.h"
+
+namespace Ainan {
+
+	static void PrintHeadlessUsage()
+	{
+		fprintf(stderr, "usage: Ainan --headless <environment> <output image> [--size W H] [--time seconds] [--framerate fps] [--camera X Y] [--renderer opengl|software]\n");
+	}
+
+	static bool ParseHeadlessArgs(int argc, char* argv[], HeadlessExportSettings& settings)
+	{
+		if (argc < 4)
+			return false;
+
+		settings.EnvironmentPath = argv[2];
+		settings.OutputPath = argv[3];
+
+		for (int i = 4; i < argc; i++)
+		{
+			std::string arg = argv[i];
+			int remaining = argc - i - 1;
+
+			if (arg == "--size" && remaining >= 2)
+			{
+				settings.Size = { atoi(argv[i + 1]), atoi(argv[i + 2]) };
+				i += 2;
+			}
+			else if (arg == "--time" && remaining >= 1)
+				settings.Time = (float)atof(argv[++i]);
+			else if (arg == "--framerate" && remaining >= 1)
+				settings.Framerate = atoi(argv[++i]);
+			else if (arg == "--camera" && remaining >= 2)
+			{
+				settings.CameraPosition = { (float)atof(argv[i + 1]), (float)atof(argv[i + 2]) };
+				i += 2;
+			}
+			else if (arg == "--renderer" && remaining >= 1)
+			{
+				std::string backend = argv[++i];
+				if (backend == "opengl")
+					settings.Backend = RendererType::OpenGL;
+				else if (backend == "software")
+					settings.Backend = RendererType::Software;
+				else
+					return false;
+			}
+			else
+				return false;
+		}
+
+		return true;
+	}
+
+	static bool GetImageFormatFromPath(const std::filesystem::path& path, ImageFormat& format)
+	{
+		std::string extension = path.extension().u8string();
+		for (ImageFormat f : { ImageFormat::png, ImageFormat::bmp, ImageFormat::qoi })
+		{
+			if (extension == "." + Image::GetFormatString(f))
+			{
+				format = f;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool IsHeadlessExportCommand(int argc, char* argv[])
+	{
+		return argc > 1 && std::string(argv[1]) == "--headless";
+	}
+
+	int32_t RunHeadlessExport(int argc, char* argv[])
+	{
+		HeadlessExportSettings settings;
+		if (!ParseHeadlessArgs(argc, argv, settings))
+		{
+			PrintHeadlessUsage();
+			return 1;
+		}
+
+		ImageFormat format;
+		if (!GetImageFormatFromPath(settings.OutputPath, format))
+		{
+			fprintf(stderr, "output image must be .png, .bmp or .qoi\n");
+			return 1;
+		}
+
+		//bigger images need the tiled export in the editor
+		if (settings.Size.x < 1 || settings.Size.y < 1 || settings.Size.x > c_ExportTileSize || settings.Size.y > c_ExportTileSize)
+		{
+			fprintf(stderr, "output size must be between 1 and %d pixels on each side\n", c_ExportTileSize);
+			return 1;
+		}
+
+		if (!std::filesystem::exists(settings.EnvironmentPath))
+		{
+			fprintf(stderr, "could not find environment %s\n", settings.EnvironmentPath.c_str());
+			return 1;
+		}
+
+#ifndef PLATFORM_LINUX
+		if (settings.Backend == RendererType::OpenGL)
+		{
+			fprintf(stderr, "headless OpenGL is only supported on linux, use --renderer software\n");
+			return 1;
+		}
+#endif // PLATFORM_LINUX
+
+		//internal buffers (like the blur buffer) are sized for the image instead of a window
+		Renderer::Init(settings.Backend, true, glm::vec2(settings.Size));
+
+		Environment* env = LoadEnvironment(settings.EnvironmentPath);
+		Renderer::SetBlendMode(env->BlendMode);
+
+		//same fixed steps as the exports in the editor so the result doesn't depend on how fast this machine is
+		const int32_t framerate = std::max(settings.Framerate, 1);
+		const float deltaTime = 1.0f / framerate;
+		const int32_t frameCount = (int32_t)std::round(std::max(settings.Time, 0.0f) * framerate);
+		for (int32_t i = 0; i < frameCount; i++)
+		{
+			for (auto& obj : env->Objects)
+				obj->Update(deltaTime);
+
+			env->Objects.erase(std::remove_if(env->Objects.begin(), env->Objects.end(),
+				[](const pEnvironmentObject& obj) { return obj->ToBeDeleted; }), env->Objects.end());
+		}
+
+		//the zoom factor is the height of the image in pixels, like the export camera in the editor
+		Camera camera;
+		camera.ZoomFactor = (float)settings.Size.y;
+		camera.Update(0.0f, { 0, 0, settings.Size.x, settings.Size.y });
+		camera.SetPosition(-settings.CameraPosition * c_GlobalScaleFactor);
+
+		auto target = Renderer::CreateFrameBuffer(glm::vec2(settings.Size));
+
+		//textures of the environment (and defaults like the particle circle) are still placeholders until they are uploaded
+		TextureLoader::Flush();
+
+		SceneDescription desc;
+		desc.SceneCamera = camera;
+		desc.SceneDrawTarget = &target;
+		desc.Blur = env->BlurEnabled;
+		desc.BlurRadius = env->BlurRadius;
+		Renderer::BeginScene(desc);
+		target->Bind();
+		Renderer::ClearScreen();
+
+		for (pEnvironmentObject& obj : env->Objects)
+		{
+			if (obj->Type == RadialLightType)
+			{
+				RadialLight* light = static_cast<RadialLight*>(obj.get());
+				Renderer::AddRadialLight(light->Position, light->Color, light->Intensity);
+			}
+			else if (obj->Type == SpotLightType)
+			{
+				SpotLight* light = static_cast<SpotLight*>(obj.get());
+				Renderer::AddSpotLight(light->Position, light->Color, light->Angle, light->InnerCutoff, light->OuterCutoff, light->Intensity);
+			}
+		}
+
+		for (pEnvironmentObject& obj : env->Objects)
+			obj->Draw();
+
+		Renderer::EndScene();
+
+		Image image = target->ReadPixels();
+		bool succeeded = image.m_Data != nullptr;
+		if (succeeded)
+		{
+			//both headless backends (OpenGL and Software) store rows bottom to top
+			image.FlipHorizontally();
+
+			succeeded = image.SaveToFile(settings.OutputPath, format).get();
+		}
+
+		if (!succeeded)
+			fprintf(stderr, "could not render %s to %s\n", settings.EnvironmentPath.c_str(), settings.OutputPath.c_str());
+
+		//objects can own renderer resources, so they go before the renderer
+		delete env;
+		target.reset();
+		AssetManager::Terminate();
+		Renderer::Terminate();
+
+		return succeeded ? 0 : 1;
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "renderer/Renderer.h"
+
+namespace Ainan {
+
+	//renders an environment to an image without a window or the editor, used for batch/offline rendering:
+	//Ainan --headless <environment> <output image> [--size W H] [--time seconds] [--framerate fps] [--camera X Y] [--renderer opengl|software]
+	struct HeadlessExportSettings
+	{
+		std::string EnvironmentPath;
+		//the format is taken from the extension (.png, .bmp or .qoi)
+		std::string OutputPath;
+		glm::ivec2 Size = { 1920, 1080 };
+		//how long the environment is simulated before the image is taken
+		float Time = 0.0f;
+		int32_t Framerate = 60;
+		//same units as the export camera position in the editor
+		glm::vec2 CameraPosition = { 0.0f, 0.0f };
+#ifdef PLATFORM_LINUX
+		RendererType Backend = RendererType::OpenGL;
+#else
+		RendererType Backend = RendererType::Software;
+#endif // PLATFORM_LINUX
+	};
+
+	bool IsHeadlessExportCommand(int argc, char* argv[]);
+	//returns the exit code of the process
+	int32_t RunHeadlessExport(int argc, char* argv[]);
+}
@@ -0,0 +1,131 @@
+#include "ImageSequenceWriter.h"
+
+namespace Ainan {
+
+	//enough buffers to keep every writer thread busy while the readbacks of newer frames are in flight
+	ImageSequenceWriter::ImageSequenceWriter() :
+		m_FreePixelBuffers(c_VideoExportFramesInFlight + ImageWriter::GetThreadCount())
+	{}
+
+	ImageSequenceWriter::~ImageSequenceWriter()
+	{
+		//the jobs that are still queued use this object
+		m_Failed = true;
+		m_FreePixelBuffers.Close();
+		WaitForOutstandingFrames();
+	}
+
+	bool ImageSequenceWriter::Open(const std::string& pathPrefix, int32_t frameWidth, int32_t frameHeight,
+		ImageFormat format, ImageCompression compression, bool flipVertically)
+	{
+		m_PathPrefix = pathPrefix;
+		m_FrameWidth = frameWidth;
+		m_FrameHeight = frameHeight;
+		m_FrameBufferSize = (size_t)frameWidth * frameHeight * 4;
+		m_Format = format;
+		m_Compression = compression;
+		m_FlipVertically = flipVertically;
+
+		std::filesystem::path directory = std::filesystem::path(pathPrefix).parent_path();
+		if (!directory.empty() && !std::filesystem::is_directory(directory))
+		{
+			Fail("Image sequence folder doesn't exist: " + directory.u8string());
+			return false;
+		}
+
+		m_PixelBuffers.resize(c_VideoExportFramesInFlight + ImageWriter::GetThreadCount());
+		for (auto& buffer : m_PixelBuffers)
+		{
+			buffer.resize(m_FrameBufferSize);
+			m_FreePixelBuffers.Push(buffer.data());
+		}
+
+		return true;
+	}
+
+	uint8_t* ImageSequenceWriter::AcquireFrame()
+	{
+		uint8_t* pixels = nullptr;
+		if (m_Failed || !m_FreePixelBuffers.Pop(pixels))
+			return nullptr;
+
+		return pixels;
+	}
+
+	void ImageSequenceWriter::SubmitFrame(uint8_t* pixels, std::future<bool> readback)
+	{
+		char frameNumber[16];
+		snprintf(frameNumber, sizeof(frameNumber), "_%06d.", m_SubmittedFrameCount++);
+		std::string path = m_PathPrefix + frameNumber + Image::GetFormatString(m_Format);
+
+		{
+			std::lock_guard lock(m_OutstandingMutex);
+			m_OutstandingFrameCount++;
+		}
+
+		//jobs have to be copyable
+		auto sharedReadback = std::make_shared<std::future<bool>>(std::move(readback));
+		auto job = [this, pixels, sharedReadback, path](ImageEncoder& encoder)
+		{
+			if (!sharedReadback->get())
+				Fail("Could not read frame back from the renderer");
+			bool written = !m_Failed && WriteFrame(encoder, pixels, path);
+			ReleaseFrame(pixels);
+			return written;
+		};
+		ImageWriter::Submit(job);
+	}
+
+	bool ImageSequenceWriter::Finish()
+	{
+		WaitForOutstandingFrames();
+		m_PixelBuffers.clear();
+		return !m_Failed;
+	}
+
+	bool ImageSequenceWriter::WriteFrame(ImageEncoder& encoder, const uint8_t* pixels, const std::string& path)
+	{
+		const int32_t rowSize = m_FrameWidth * 4;
+		const uint8_t* firstRow = pixels;
+		int32_t stride = rowSize;
+		//OpenGL reads rows bottom to top
+		if (m_FlipVertically)
+		{
+			firstRow = pixels + (size_t)(m_FrameHeight - 1) * rowSize;
+			stride = -rowSize;
+		}
+
+		if (!encoder.Encode(firstRow, m_FrameWidth, m_FrameHeight, 4, stride, m_Format, m_Compression) || !encoder.WriteToFile(path))
+		{
+			Fail("Could not write image: " + path);
+			return false;
+		}
+
+		m_WrittenFrameCount++;
+		return true;
+	}
+
+	void ImageSequenceWriter::ReleaseFrame(uint8_t* pixels)
+	{
+		m_FreePixelBuffers.Push(pixels);
+
+		std::lock_guard lock(m_OutstandingMutex);
+		m_OutstandingFrameCount--;
+		m_OutstandingCV.notify_all();
+	}
+
+	void ImageSequenceWriter::WaitForOutstandingFrames()
+	{
+		std::unique_lock lock(m_OutstandingMutex);
+		m_OutstandingCV.wait(lock, [this]() { return m_OutstandingFrameCount == 0; });
+	}
+
+	void ImageSequenceWriter::Fail(const std::string& error)
+	{
+		if (!m_Failed.exchange(true))
+			AINAN_LOG_ERROR(error);
+
+		//unblock the exporter, it sees that AcquireFrame failed and stops
+		m_FreePixelBuffers.Close();
+	}
+}
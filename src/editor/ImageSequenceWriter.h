@@ -0,0 +1,59 @@
+#pragma once
+
+#include "BoundedQueue.h"
+#include "VideoSink.h"
+#include "renderer/ImageWriter.h"
+
+namespace Ainan {
+
+	//writes every frame as its own image (Name_000000.png, Name_000001.png...) for compositing in other tools,
+	//frames are encoded and written in parallel by the ImageWriter threads straight from their readback buffers
+	class ImageSequenceWriter : public VideoSink
+	{
+	public:
+		ImageSequenceWriter();
+		~ImageSequenceWriter();
+
+		ImageSequenceWriter(const ImageSequenceWriter&) = delete;
+		ImageSequenceWriter& operator=(const ImageSequenceWriter&) = delete;
+
+		//pathPrefix is the path of the frames without the frame number and the extension,
+		//only takes rgba frames
+		bool Open(const std::string& pathPrefix, int32_t frameWidth, int32_t frameHeight,
+			ImageFormat format, ImageCompression compression, bool flipVertically);
+
+		// Inherited via VideoSink
+		virtual uint8_t* AcquireFrame() override;
+		virtual void SubmitFrame(uint8_t* pixels, std::future<bool> readback) override;
+		virtual bool Finish() override;
+		virtual size_t GetFrameBufferSize() const override { return m_FrameBufferSize; }
+		virtual uint32_t GetWrittenFrameCount() const override { return m_WrittenFrameCount; }
+
+	private:
+		bool WriteFrame(ImageEncoder& encoder, const uint8_t* pixels, const std::string& path);
+		void ReleaseFrame(uint8_t* pixels);
+		void WaitForOutstandingFrames();
+		void Fail(const std::string& error);
+
+	private:
+		std::string m_PathPrefix;
+		int32_t m_FrameWidth = 0;
+		int32_t m_FrameHeight = 0;
+		size_t m_FrameBufferSize = 0;
+		ImageFormat m_Format = ImageFormat::png;
+		ImageCompression m_Compression = ImageCompression::Default;
+		bool m_FlipVertically = false;
+
+		std::vector<std::vector<uint8_t>> m_PixelBuffers;
+		BoundedQueue<uint8_t*> m_FreePixelBuffers;
+		int32_t m_SubmittedFrameCount = 0;
+
+		//frames submitted to the ImageWriter that it didn't finish yet
+		std::mutex m_OutstandingMutex;
+		std::condition_variable m_OutstandingCV;
+		uint32_t m_OutstandingFrameCount = 0;
+
+		std::atomic<uint32_t> m_WrittenFrameCount = 0;
+		std::atomic<bool> m_Failed = false;
+	};
+}
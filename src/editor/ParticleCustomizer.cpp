@@ -197,6 +197,7 @@ namespace Ainan {
 		m_LifetimeCustomizer.DisplayGUI();
 		m_ScaleCustomizer.DisplayGUI();
 		m_ForceCustomizer.DisplayGUI();
+		m_BakeCustomizer.DisplayGUI();
 
 		ImGui::End();
 	}
@@ -8,6 +8,7 @@
 #include "customizers/LifetimeCustomizer.h"
 #include "customizers/NoiseCustomizer.h"
 #include "customizers/ForceCustomizer.h"
+#include "customizers/BakeCustomizer.h"
 
 namespace Ainan {
 
@@ -60,6 +61,7 @@ namespace Ainan {
 		ColorCustomizer m_ColorCustomizer;
 		TextureCustomizer m_TextureCustomizer;
 		ForceCustomizer m_ForceCustomizer;
+		BakeCustomizer m_BakeCustomizer;
 
 		glm::vec2 m_SpawnPosition = { 0.5f, 0.5f };
 
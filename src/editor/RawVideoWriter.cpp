@@ -0,0 +1,324 @@
+#include "RawVideoWriter.h"
+
+#include "renderer/Renderer.h"
+
+#ifdef PLATFORM_WINDOWS
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <unistd.h>
+#include <signal.h>
+#include <climits>
+#endif
+
+namespace Ainan {
+
+	std::string RawVideoContainerStr(RawVideoContainer container)
+	{
+		switch (container)
+		{
+		case RawVideoContainer::Y4M:
+			return "Y4M";
+
+		case RawVideoContainer::Raw:
+			return "Raw";
+
+		default:
+			assert(false);
+			return "";
+		}
+	}
+
+	RawVideoWriter::~RawVideoWriter()
+	{
+		//only does something if Finish wasn't called
+		m_Failed = true;
+		m_FreePixelBuffers.Close();
+		m_PendingFrames.Close();
+		Close();
+	}
+
+	bool RawVideoWriter::Open(const std::string& destination, int32_t frameWidth, int32_t frameHeight, int32_t framerate,
+		VideoFrameFormat format, RawVideoContainer container, bool flipVertically)
+	{
+		m_Destination = destination;
+		m_FrameWidth = frameWidth;
+		m_FrameHeight = frameHeight;
+		m_Format = format;
+		m_Container = container;
+		m_FlipVertically = flipVertically;
+
+		if (container == RawVideoContainer::Y4M && format != VideoFrameFormat::PackedYUV420)
+		{
+			Fail("Y4M needs yuv frames, the software and null renderers can only stream raw rgba video");
+			return false;
+		}
+
+		glm::ivec2 videoSize = glm::ivec2(frameWidth, frameHeight);
+		if (format == VideoFrameFormat::RGBA)
+			m_FrameBufferSize = (size_t)frameWidth * frameHeight * 4;
+		else
+		{
+			YUV420Layout layout(videoSize);
+			videoSize = layout.VideoSize;
+			m_FrameBufferSize = layout.Size;
+		}
+
+		if (!OpenOutput(destination))
+		{
+			Fail("Could not open video stream: " + destination);
+			return false;
+		}
+
+		if (container == RawVideoContainer::Y4M)
+		{
+			//C420jpeg is centered chroma, which is what the 2x2 average of the yuv conversion gives
+			std::string header = "YUV4MPEG2 W" + std::to_string(videoSize.x) + " H" + std::to_string(videoSize.y) +
+				" F" + std::to_string(framerate) + ":1 Ip A1:1 C420jpeg XCOLORRANGE=LIMITED\n";
+			if (fwrite(header.data(), 1, header.size(), m_Output) != header.size() || fflush(m_Output) != 0)
+			{
+				Fail("Could not write to video stream: " + destination);
+				return false;
+			}
+		}
+
+		//tell the user how to read the stream, raw video has no header,
+		//this goes to stderr even in release builds (where there is no log) and never mixes with a stream on stdout
+		const char* pixelFormat = format == VideoFrameFormat::RGBA ? "rgba" : "yuv420p";
+		fprintf(stderr, "Streaming %s video to %s: %s %dx%d at %d fps\n", RawVideoContainerStr(container).c_str(), destination.c_str(),
+			pixelFormat, videoSize.x, videoSize.y, framerate);
+
+		m_PixelBuffers.resize(c_VideoExportFramesInFlight);
+		for (auto& buffer : m_PixelBuffers)
+		{
+			buffer.resize(m_FrameBufferSize);
+			m_FreePixelBuffers.Push(buffer.data());
+		}
+
+		m_WriteThread = std::thread([this]() { WriteThreadLoop(); });
+		return true;
+	}
+
+	bool RawVideoWriter::OpenOutput(const std::string& destination)
+	{
+#ifndef PLATFORM_WINDOWS
+		//a reader that goes away should fail the export, not kill the whole editor
+		signal(SIGPIPE, SIG_IGN);
+#endif
+
+		if (destination == "-")
+		{
+#ifdef PLATFORM_WINDOWS
+			_setmode(_fileno(stdout), _O_BINARY);
+#endif
+			fflush(stdout);
+			m_Output = stdout;
+			m_OwnsOutput = false;
+			return true;
+		}
+
+		m_OwnsOutput = true;
+		if (destination.size() > 1 && destination[0] == '|')
+		{
+			m_OutputIsProcess = true;
+#ifdef PLATFORM_WINDOWS
+			m_Output = _popen(destination.c_str() + 1, "wb");
+#else
+			m_Output = popen(destination.c_str() + 1, "w");
+#endif
+			return m_Output != nullptr;
+		}
+
+		if (destination.rfind("fd:", 0) == 0)
+		{
+			//write to a copy so closing the stream doesn't close the caller's descriptor
+			int32_t fd = atoi(destination.c_str() + 3);
+#ifdef PLATFORM_WINDOWS
+			int32_t copy = _dup(fd);
+			m_Output = copy < 0 ? nullptr : _fdopen(copy, "wb");
+#else
+			int32_t copy = dup(fd);
+			m_Output = copy < 0 ? nullptr : fdopen(copy, "w");
+#endif
+			return m_Output != nullptr;
+		}
+
+		//opening a named pipe blocks until the reader opens it too
+		m_Output = fopen(destination.c_str(), "wb");
+		return m_Output != nullptr;
+	}
+
+	uint8_t* RawVideoWriter::AcquireFrame()
+	{
+		uint8_t* pixels = nullptr;
+		if (m_Failed || !m_FreePixelBuffers.Pop(pixels))
+			return nullptr;
+
+		return pixels;
+	}
+
+	void RawVideoWriter::SubmitFrame(uint8_t* pixels, std::future<bool> readback)
+	{
+		PendingFrame frame;
+		frame.Pixels = pixels;
+		frame.Readback = std::move(readback);
+		m_PendingFrames.Push(std::move(frame));
+	}
+
+	bool RawVideoWriter::Finish()
+	{
+		m_PendingFrames.Close();
+		if (m_WriteThread.joinable())
+			m_WriteThread.join();
+
+		bool succeeded = !m_Failed;
+		if (!Close())
+		{
+			AINAN_LOG_ERROR("Error while closing video stream: " + m_Destination);
+			succeeded = false;
+		}
+		return succeeded;
+	}
+
+	void RawVideoWriter::WriteThreadLoop()
+	{
+		PendingFrame pending;
+		while (m_PendingFrames.Pop(pending))
+		{
+			if (!pending.Readback.get())
+				Fail("Could not read frame back from the renderer");
+
+			if (!m_Failed)
+			{
+				if (WriteFrame(pending.Pixels))
+					m_WrittenFrameCount++;
+				else
+					Fail("Could not write to video stream: " + m_Destination);
+			}
+			m_FreePixelBuffers.Push(pending.Pixels);
+		}
+	}
+
+	bool RawVideoWriter::WriteFrame(const uint8_t* pixels)
+	{
+		static const char c_Y4MFrameHeader[] = "FRAME\n";
+
+		m_FramePieces.clear();
+		if (m_Container == RawVideoContainer::Y4M)
+			AddRows((const uint8_t*)c_Y4MFrameHeader, sizeof(c_Y4MFrameHeader) - 1, 0, 1);
+
+		if (m_Format == VideoFrameFormat::PackedYUV420)
+		{
+			//the planes are already flipped and in order, only the padding at the end of their rows is skipped
+			YUV420Layout layout(glm::ivec2(m_FrameWidth, m_FrameHeight));
+			AddRows(pixels, layout.VideoSize.x, layout.LumaStride, layout.VideoSize.y);
+			AddRows(pixels + layout.UOffset, layout.VideoSize.x / 2, layout.ChromaStride, layout.VideoSize.y / 2);
+			AddRows(pixels + layout.VOffset, layout.VideoSize.x / 2, layout.ChromaStride, layout.VideoSize.y / 2);
+		}
+		else
+		{
+			int32_t rowSize = m_FrameWidth * 4;
+			if (m_FlipVertically)
+				AddRows(pixels + (size_t)(m_FrameHeight - 1) * rowSize, rowSize, -rowSize, m_FrameHeight);
+			else
+				AddRows(pixels, rowSize * m_FrameHeight, 0, 1);
+		}
+
+#ifdef PLATFORM_WINDOWS
+		for (auto& [data, size] : m_FramePieces)
+		{
+			if (fwrite(data, 1, size, m_Output) != size)
+				return false;
+		}
+		return true;
+#else
+		int32_t fd = fileno(m_Output);
+		size_t index = 0;
+		while (index < m_FramePieces.size())
+		{
+			int32_t count = (int32_t)std::min<size_t>(m_FramePieces.size() - index, IOV_MAX);
+			ssize_t written = writev(fd, &m_FramePieces[index], count);
+			if (written < 0)
+			{
+				if (errno == EINTR)
+					continue;
+				return false;
+			}
+
+			//pipes can take less than everything, skip what was written and continue from there
+			while (written > 0 && index < m_FramePieces.size())
+			{
+				iovec& piece = m_FramePieces[index];
+				if ((size_t)written >= piece.iov_len)
+				{
+					written -= piece.iov_len;
+					index++;
+				}
+				else
+				{
+					piece.iov_base = (uint8_t*)piece.iov_base + written;
+					piece.iov_len -= written;
+					written = 0;
+				}
+			}
+		}
+		return true;
+#endif
+	}
+
+	void RawVideoWriter::AddRows(const uint8_t* firstRow, int32_t rowSize, int32_t stride, int32_t rowCount)
+	{
+		//contiguous rows are written as one piece
+		if (stride == rowSize)
+		{
+			rowSize *= rowCount;
+			rowCount = 1;
+		}
+
+		for (int32_t i = 0; i < rowCount; i++)
+		{
+			const uint8_t* row = firstRow + (ptrdiff_t)i * stride;
+#ifdef PLATFORM_WINDOWS
+			m_FramePieces.push_back({ row, (size_t)rowSize });
+#else
+			m_FramePieces.push_back({ (void*)row, (size_t)rowSize });
+#endif
+		}
+	}
+
+	void RawVideoWriter::Fail(const std::string& error)
+	{
+		if (!m_Failed.exchange(true))
+			AINAN_LOG_ERROR(error);
+
+		//unblock the exporter, it sees that AcquireFrame failed and stops
+		m_FreePixelBuffers.Close();
+	}
+
+	bool RawVideoWriter::Close()
+	{
+		if (m_WriteThread.joinable())
+			m_WriteThread.join();
+
+		bool succeeded = true;
+		if (m_Output)
+		{
+			if (!m_OwnsOutput)
+				succeeded = fflush(m_Output) == 0;
+			else if (m_OutputIsProcess)
+			{
+				//waits for the process to exit, it has to encode everything it was sent first
+#ifdef PLATFORM_WINDOWS
+				succeeded = _pclose(m_Output) == 0;
+#else
+				succeeded = pclose(m_Output) == 0;
+#endif
+			}
+			else
+				succeeded = fclose(m_Output) == 0;
+		}
+		m_Output = nullptr;
+		m_PixelBuffers.clear();
+		return succeeded;
+	}
+}
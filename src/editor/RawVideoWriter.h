@@ -0,0 +1,90 @@
+#pragma once
+
+#include "BoundedQueue.h"
+#include "VideoSink.h"
+
+#ifndef PLATFORM_WINDOWS
+#include <sys/uio.h>
+#endif
+
+namespace Ainan {
+
+	enum class RawVideoContainer
+	{
+		//yuv4mpeg2, a short text header before the stream and before every frame, only for yuv frames
+		Y4M,
+		//only the pixels, the reader has to be told the size, pixel format and framerate
+		Raw
+	};
+
+	std::string RawVideoContainerStr(RawVideoContainer container);
+
+	//streams uncompressed frames to a file, a named pipe, stdout, a file descriptor or the stdin of a process,
+	//so they can be encoded by an external encoder on other cores or another machine,
+	//a writer thread writes every frame straight from its readback buffer once the readback is done
+	class RawVideoWriter : public VideoSink
+	{
+	public:
+		RawVideoWriter() = default;
+		~RawVideoWriter();
+
+		RawVideoWriter(const RawVideoWriter&) = delete;
+		RawVideoWriter& operator=(const RawVideoWriter&) = delete;
+
+		//destination is a file or named pipe path, "-" for stdout (debug builds log to it too), "fd:N" for a file descriptor
+		//that is already open or "|command" to start command and write to its stdin,
+		//yuv frames are written as yuv420p with an even size and rgba frames as rgba, Y4M only supports yuv
+		bool Open(const std::string& destination, int32_t frameWidth, int32_t frameHeight, int32_t framerate,
+			VideoFrameFormat format, RawVideoContainer container, bool flipVertically);
+
+		// Inherited via VideoSink
+		virtual uint8_t* AcquireFrame() override;
+		virtual void SubmitFrame(uint8_t* pixels, std::future<bool> readback) override;
+		virtual bool Finish() override;
+		virtual size_t GetFrameBufferSize() const override { return m_FrameBufferSize; }
+		virtual uint32_t GetWrittenFrameCount() const override { return m_WrittenFrameCount; }
+
+	private:
+		struct PendingFrame
+		{
+			uint8_t* Pixels = nullptr;
+			std::future<bool> Readback;
+		};
+
+		bool OpenOutput(const std::string& destination);
+		void WriteThreadLoop();
+		bool WriteFrame(const uint8_t* pixels);
+		//adds rowCount rows of rowSize bytes that are stride bytes apart to the frame being written
+		void AddRows(const uint8_t* firstRow, int32_t rowSize, int32_t stride, int32_t rowCount);
+		void Fail(const std::string& error);
+		bool Close();
+
+	private:
+		std::string m_Destination;
+		FILE* m_Output = nullptr;
+		bool m_OutputIsProcess = false;
+		bool m_OwnsOutput = false;
+
+		int32_t m_FrameWidth = 0;
+		int32_t m_FrameHeight = 0;
+		size_t m_FrameBufferSize = 0;
+		VideoFrameFormat m_Format = VideoFrameFormat::RGBA;
+		RawVideoContainer m_Container = RawVideoContainer::Y4M;
+		bool m_FlipVertically = false;
+
+		//pieces of the frame being written, used to write the whole frame with as few calls as possible and without copying it
+#ifdef PLATFORM_WINDOWS
+		std::vector<std::pair<const uint8_t*, size_t>> m_FramePieces;
+#else
+		std::vector<iovec> m_FramePieces;
+#endif
+
+		std::vector<std::vector<uint8_t>> m_PixelBuffers;
+		BoundedQueue<uint8_t*> m_FreePixelBuffers = BoundedQueue<uint8_t*>(c_VideoExportFramesInFlight);
+		BoundedQueue<PendingFrame> m_PendingFrames = BoundedQueue<PendingFrame>(c_VideoExportFramesInFlight);
+
+		std::thread m_WriteThread;
+		std::atomic<uint32_t> m_WrittenFrameCount = 0;
+		std::atomic<bool> m_Failed = false;
+	};
+}
@@ -0,0 +1,306 @@
+#include "VideoEncoder.h"
+
+#include "renderer/Renderer.h"
+
+extern "C"
+{
+#include <libavformat/avformat.h>
+#include <libavformat/avio.h>
+#include <libavcodec/avcodec.h>
+#include <libavutil/imgutils.h>
+#include <libswscale/swscale.h>
+}
+
+namespace Ainan {
+
+	const AVPixelFormat c_VideoExportPixelFormat = AV_PIX_FMT_YUV420P;
+
+	SwsContext* VideoEncoder::CreateRGBAConverter(int32_t videoWidth, int32_t videoHeight)
+	{
+		return sws_getContext(videoWidth, videoHeight, AV_PIX_FMT_RGBA,
+			videoWidth, videoHeight, c_VideoExportPixelFormat, SWS_BILINEAR, nullptr, nullptr, nullptr);
+	}
+
+	VideoEncoder::~VideoEncoder()
+	{
+		//only does something if Finish wasn't called
+		m_Failed = true;
+		m_FreePixelBuffers.Close();
+		m_PendingFrames.Close();
+		m_FreeFrames.Close();
+		m_ConvertedFrames.Close();
+		Close();
+	}
+
+	bool VideoEncoder::Open(const std::string& path, int32_t frameWidth, int32_t frameHeight, int32_t framerate,
+		VideoFrameFormat format, bool flipVertically)
+	{
+		m_FrameWidth = frameWidth;
+		m_FrameHeight = frameHeight;
+		m_Format = format;
+		m_FlipVertically = flipVertically;
+		if (format == VideoFrameFormat::RGBA)
+			m_FrameBufferSize = (size_t)frameWidth * frameHeight * 4;
+		else
+			m_FrameBufferSize = YUV420Layout(glm::ivec2(frameWidth, frameHeight)).Size;
+
+		AVCodec* codec = avcodec_find_encoder(AV_CODEC_ID_H264);
+		if (!codec)
+		{
+			Fail("Could not find an h264 encoder");
+			return false;
+		}
+
+		if (avformat_alloc_output_context2(&m_FormatContext, nullptr, nullptr, path.c_str()) < 0)
+		{
+			Fail("Could not create video file: " + path);
+			return false;
+		}
+
+		m_Stream = avformat_new_stream(m_FormatContext, codec);
+		m_CodecContext = avcodec_alloc_context3(codec);
+		if (!m_Stream || !m_CodecContext)
+		{
+			Fail("Could not create video stream");
+			return false;
+		}
+
+		m_CodecContext->width = frameWidth & ~1;
+		m_CodecContext->height = frameHeight & ~1;
+		m_CodecContext->pix_fmt = c_VideoExportPixelFormat;
+		m_CodecContext->framerate = AVRational{ framerate, 1 };
+		m_CodecContext->time_base = AVRational{ 1, framerate };
+		//both conversion paths produce BT.601 limited range
+		m_CodecContext->color_range = AVCOL_RANGE_MPEG;
+		m_CodecContext->colorspace = AVCOL_SPC_SMPTE170M;
+		//0 lets the encoder use a thread per core
+		m_CodecContext->thread_count = 0;
+		m_CodecContext->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+		if (m_FormatContext->oformat->flags & AVFMT_GLOBALHEADER)
+			m_CodecContext->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+
+		if (avcodec_open2(m_CodecContext, codec, nullptr) < 0 ||
+			avcodec_parameters_from_context(m_Stream->codecpar, m_CodecContext) < 0)
+		{
+			Fail("Could not open the h264 encoder");
+			return false;
+		}
+		m_Stream->time_base = m_CodecContext->time_base;
+
+		if (avio_open(&m_FormatContext->pb, path.c_str(), AVIO_FLAG_WRITE) < 0 ||
+			avformat_write_header(m_FormatContext, nullptr) < 0)
+		{
+			Fail("Could not write video file: " + path);
+			return false;
+		}
+		m_HeaderWritten = true;
+
+		if (format == VideoFrameFormat::RGBA)
+			m_SwsContext = CreateRGBAConverter(m_CodecContext->width, m_CodecContext->height);
+		m_Packet = av_packet_alloc();
+		if ((format == VideoFrameFormat::RGBA && !m_SwsContext) || !m_Packet)
+		{
+			Fail("Could not create video converter");
+			return false;
+		}
+
+		m_PixelBuffers.resize(c_VideoExportFramesInFlight);
+		for (auto& buffer : m_PixelBuffers)
+		{
+			buffer.resize(m_FrameBufferSize);
+			m_FreePixelBuffers.Push(buffer.data());
+		}
+
+		for (uint32_t i = 0; i < c_VideoExportEncodeQueueSize; i++)
+		{
+			AVFrame* frame = av_frame_alloc();
+			frame->width = m_CodecContext->width;
+			frame->height = m_CodecContext->height;
+			frame->format = c_VideoExportPixelFormat;
+			frame->color_range = AVCOL_RANGE_MPEG;
+			frame->colorspace = AVCOL_SPC_SMPTE170M;
+			//these aren't reference counted so the encoder copies them, that lets us reuse them right after sending them,
+			//packed yuv frames don't need their own planes because they point into the pixel buffers
+			if (format == VideoFrameFormat::RGBA)
+				av_image_alloc(frame->data, frame->linesize, frame->width, frame->height, c_VideoExportPixelFormat, 32);
+			m_Frames.push_back(frame);
+			m_FreeFrames.Push(frame);
+		}
+
+		m_ConvertThread = std::thread([this]() { ConvertThreadLoop(); });
+		m_EncodeThread = std::thread([this]() { EncodeThreadLoop(); });
+		return true;
+	}
+
+	uint8_t* VideoEncoder::AcquireFrame()
+	{
+		uint8_t* pixels = nullptr;
+		if (m_Failed || !m_FreePixelBuffers.Pop(pixels))
+			return nullptr;
+
+		return pixels;
+	}
+
+	void VideoEncoder::SubmitFrame(uint8_t* pixels, std::future<bool> readback)
+	{
+		PendingFrame frame;
+		frame.Pixels = pixels;
+		frame.Readback = std::move(readback);
+		frame.Index = m_SubmittedFrameCount++;
+		m_PendingFrames.Push(std::move(frame));
+	}
+
+	bool VideoEncoder::Finish()
+	{
+		//let both stages drain their queues then stop
+		m_PendingFrames.Close();
+		if (m_ConvertThread.joinable())
+			m_ConvertThread.join();
+		m_ConvertedFrames.Close();
+		if (m_EncodeThread.joinable())
+			m_EncodeThread.join();
+
+		if (!m_Failed && m_CodecContext)
+		{
+			//a null frame flushes the frames the encoder is still holding on to
+			if (avcodec_send_frame(m_CodecContext, nullptr) < 0 || !ReceivePackets())
+				Fail("Error while finishing video");
+		}
+
+		if (m_HeaderWritten && av_write_trailer(m_FormatContext) < 0)
+			Fail("Error while finishing video");
+		m_HeaderWritten = false;
+
+		bool succeeded = !m_Failed;
+		Close();
+		return succeeded;
+	}
+
+	void VideoEncoder::ConvertThreadLoop()
+	{
+		const int32_t rowSize = m_FrameWidth * 4;
+		const YUV420Layout layout(glm::ivec2(m_FrameWidth, m_FrameHeight));
+
+		PendingFrame pending;
+		while (m_PendingFrames.Pop(pending))
+		{
+			if (!pending.Readback.get())
+				Fail("Could not read frame back from the renderer");
+
+			AVFrame* frame = nullptr;
+			if (m_Failed || !m_FreeFrames.Pop(frame))
+			{
+				m_FreePixelBuffers.Push(pending.Pixels);
+				continue;
+			}
+
+			ConvertedFrame converted;
+			converted.Frame = frame;
+			if (m_Format == VideoFrameFormat::PackedYUV420)
+			{
+				frame->data[0] = pending.Pixels;
+				frame->data[1] = pending.Pixels + layout.UOffset;
+				frame->data[2] = pending.Pixels + layout.VOffset;
+				frame->linesize[0] = layout.LumaStride;
+				frame->linesize[1] = layout.ChromaStride;
+				frame->linesize[2] = layout.ChromaStride;
+				converted.Pixels = pending.Pixels;
+			}
+			else
+			{
+				//OpenGL reads rows bottom to top, a negative stride flips the image while converting it
+				const uint8_t* source = pending.Pixels;
+				int32_t sourceStride = rowSize;
+				if (m_FlipVertically)
+				{
+					source = pending.Pixels + (size_t)(m_FrameHeight - 1) * rowSize;
+					sourceStride = -rowSize;
+				}
+
+				sws_scale(m_SwsContext, &source, &sourceStride, 0, m_CodecContext->height, frame->data, frame->linesize);
+				m_FreePixelBuffers.Push(pending.Pixels);
+			}
+			frame->pts = pending.Index;
+
+			m_ConvertedFrames.Push(converted);
+		}
+	}
+
+	void VideoEncoder::EncodeThreadLoop()
+	{
+		ConvertedFrame converted;
+		while (m_ConvertedFrames.Pop(converted))
+		{
+			if (!m_Failed)
+			{
+				if (avcodec_send_frame(m_CodecContext, converted.Frame) < 0 || !ReceivePackets())
+					Fail("Error while encoding video");
+				else
+					m_EncodedFrameCount++;
+			}
+			if (converted.Pixels)
+				m_FreePixelBuffers.Push(converted.Pixels);
+			m_FreeFrames.Push(converted.Frame);
+		}
+	}
+
+	bool VideoEncoder::ReceivePackets()
+	{
+		while (true)
+		{
+			int32_t result = avcodec_receive_packet(m_CodecContext, m_Packet);
+			if (result == AVERROR(EAGAIN) || result == AVERROR_EOF)
+				return true;
+			if (result < 0)
+				return false;
+
+			av_packet_rescale_ts(m_Packet, m_CodecContext->time_base, m_Stream->time_base);
+			m_Packet->stream_index = m_Stream->index;
+			result = av_interleaved_write_frame(m_FormatContext, m_Packet);
+			av_packet_unref(m_Packet);
+			if (result < 0)
+				return false;
+		}
+	}
+
+	void VideoEncoder::Fail(const std::string& error)
+	{
+		if (!m_Failed.exchange(true))
+			AINAN_LOG_ERROR(error);
+
+		//unblock the producer and the other stage, they see m_Failed and stop
+		m_FreePixelBuffers.Close();
+		m_FreeFrames.Close();
+	}
+
+	void VideoEncoder::Close()
+	{
+		if (m_ConvertThread.joinable())
+			m_ConvertThread.join();
+		if (m_EncodeThread.joinable())
+			m_EncodeThread.join();
+
+		for (AVFrame* frame : m_Frames)
+		{
+			if (m_Format == VideoFrameFormat::RGBA)
+				av_freep(&frame->data[0]);
+			av_frame_free(&frame);
+		}
+		m_Frames.clear();
+		m_PixelBuffers.clear();
+
+		if (m_SwsContext)
+			sws_freeContext(m_SwsContext);
+		m_SwsContext = nullptr;
+		av_packet_free(&m_Packet);
+		avcodec_free_context(&m_CodecContext);
+		if (m_FormatContext)
+		{
+			if (m_FormatContext->pb)
+				avio_closep(&m_FormatContext->pb);
+			avformat_free_context(m_FormatContext);
+		}
+		m_FormatContext = nullptr;
+		m_Stream = nullptr;
+	}
+}
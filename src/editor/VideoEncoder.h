@@ -0,0 +1,97 @@
+#pragma once
+
+#include "BoundedQueue.h"
+#include "VideoSink.h"
+
+struct AVFormatContext;
+struct AVCodecContext;
+struct AVStream;
+struct AVFrame;
+struct AVPacket;
+struct SwsContext;
+
+namespace Ainan {
+
+	//converted frames waiting for the encoder
+	const uint32_t c_VideoExportEncodeQueueSize = 4;
+
+	//encodes frames to an h264 video with ffmpeg as a pipeline:
+	//a conversion thread waits for each readback and converts it to yuv (or just points the planes at it if the gpu did that),
+	//and an encoding thread feeds the encoder, which runs on its own threads
+	class VideoEncoder : public VideoSink
+	{
+	public:
+		VideoEncoder() = default;
+		~VideoEncoder();
+
+		VideoEncoder(const VideoEncoder&) = delete;
+		VideoEncoder& operator=(const VideoEncoder&) = delete;
+
+		//the video size is the frame size rounded down to even numbers because yuv420 needs it,
+		//flipVertically only applies to rgba frames, the gpu conversion flips packed ones itself
+		bool Open(const std::string& path, int32_t frameWidth, int32_t frameHeight, int32_t framerate,
+			VideoFrameFormat format, bool flipVertically);
+
+		// Inherited via VideoSink
+		virtual uint8_t* AcquireFrame() override;
+		virtual void SubmitFrame(uint8_t* pixels, std::future<bool> readback) override;
+		virtual bool Finish() override;
+		virtual size_t GetFrameBufferSize() const override { return m_FrameBufferSize; }
+		virtual uint32_t GetWrittenFrameCount() const override { return m_EncodedFrameCount; }
+
+		bool HasFailed() const { return m_Failed; }
+
+		//the rgba to yuv420 converter used for rgba frames, freed with sws_freeContext,
+		//shaders/YUV420.frag reproduces its output so changing its flags or colorspace has to change the shader too
+		static SwsContext* CreateRGBAConverter(int32_t videoWidth, int32_t videoHeight);
+
+	private:
+		struct PendingFrame
+		{
+			uint8_t* Pixels = nullptr;
+			std::future<bool> Readback;
+			int64_t Index = 0;
+		};
+
+		struct ConvertedFrame
+		{
+			AVFrame* Frame = nullptr;
+			//packed yuv frames point into their pixel buffer, so it is only released after the encoder copied it
+			uint8_t* Pixels = nullptr;
+		};
+
+		void ConvertThreadLoop();
+		void EncodeThreadLoop();
+		bool ReceivePackets();
+		void Fail(const std::string& error);
+		void Close();
+
+	private:
+		AVFormatContext* m_FormatContext = nullptr;
+		AVCodecContext* m_CodecContext = nullptr;
+		AVStream* m_Stream = nullptr;
+		AVPacket* m_Packet = nullptr;
+		SwsContext* m_SwsContext = nullptr;
+
+		int32_t m_FrameWidth = 0;
+		int32_t m_FrameHeight = 0;
+		size_t m_FrameBufferSize = 0;
+		VideoFrameFormat m_Format = VideoFrameFormat::RGBA;
+		bool m_FlipVertically = false;
+		bool m_HeaderWritten = false;
+
+		std::vector<std::vector<uint8_t>> m_PixelBuffers;
+		std::vector<AVFrame*> m_Frames;
+		int64_t m_SubmittedFrameCount = 0;
+
+		BoundedQueue<uint8_t*> m_FreePixelBuffers = BoundedQueue<uint8_t*>(c_VideoExportFramesInFlight);
+		BoundedQueue<PendingFrame> m_PendingFrames = BoundedQueue<PendingFrame>(c_VideoExportFramesInFlight);
+		BoundedQueue<AVFrame*> m_FreeFrames = BoundedQueue<AVFrame*>(c_VideoExportEncodeQueueSize);
+		BoundedQueue<ConvertedFrame> m_ConvertedFrames = BoundedQueue<ConvertedFrame>(c_VideoExportEncodeQueueSize);
+
+		std::thread m_ConvertThread;
+		std::thread m_EncodeThread;
+		std::atomic<uint32_t> m_EncodedFrameCount = 0;
+		std::atomic<bool> m_Failed = false;
+	};
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <future>
+
+namespace Ainan {
+
+	//how many frames can be between the renderer and a sink, this is also how many buffers a sink allocates,
+	//it has to be bigger than c_ReadbackRingSize because readbacks only complete when newer ones are requested
+	const uint32_t c_VideoExportFramesInFlight = 8;
+
+	enum class VideoFrameFormat
+	{
+		//straight from the export surface
+		RGBA,
+		//already converted by Renderer::ConvertToYUV420, packed as described by YUV420Layout
+		PackedYUV420
+	};
+
+	//where exported video frames go,
+	//the exporter renders frames and reads them back asynchronously into buffers it gets from AcquireFrame,
+	//then hands them back with SubmitFrame and the sink processes them on its own threads once their readback is done
+	class VideoSink
+	{
+	public:
+		virtual ~VideoSink() = default;
+
+		//returns a buffer for GetFrameBufferSize() bytes, blocks while every buffer is in use,
+		//returns nullptr if the sink failed
+		virtual uint8_t* AcquireFrame() = 0;
+		//pixels are used once the readback future is ready, the sink fails if it is false
+		virtual void SubmitFrame(uint8_t* pixels, std::future<bool> readback) = 0;
+
+		//processes whatever is left and closes the output, returns false if anything failed
+		virtual bool Finish() = 0;
+
+		virtual size_t GetFrameBufferSize() const = 0;
+		//frames that were completely handed to the output
+		virtual uint32_t GetWrittenFrameCount() const = 0;
+	};
+}
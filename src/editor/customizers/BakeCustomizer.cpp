@@ -0,0 +1,45 @@
+#include "BakeCustomizer.h"
+
+namespace Ainan {
+
+	void BakeCustomizer::DisplayGUI()
+	{
+		ImGui::SeparatorEx(ImGuiSeparatorFlags_Horizontal);
+		if (ImGui::TreeNode("Baking"))
+		{
+			ImGui::Text("Play Baked Simulation: ");
+			ImGui::SameLine();
+			ImGui::Checkbox("##Play Baked Simulation: ", &m_PlayBaked);
+			if (ImGui::IsItemHovered())
+			{
+				ImGui::BeginTooltip();
+				ImGui::Text("Loops the baked frames instead of simulating, changes to the other settings need a new bake");
+				ImGui::EndTooltip();
+			}
+
+			ImGui::Text("Warmup: ");
+			ImGui::SameLine();
+			ImGui::DragFloat("##Bake Warmup: ", &m_Warmup, 0.1f, 0.0f, c_MaxBakeDuration);
+
+			ImGui::Text("Duration: ");
+			ImGui::SameLine();
+			ImGui::DragFloat("##Bake Duration: ", &m_Duration, 0.1f, 0.1f, c_MaxBakeDuration);
+
+			ImGui::Text("Framerate: ");
+			ImGui::SameLine();
+			ImGui::DragInt("##Bake Framerate: ", &m_Framerate, 1.0f, 1, c_MaxBakeFramerate);
+
+			if (ImGui::Button("Bake"))
+				BakeRequested = true;
+
+			if (BakeStatus != "")
+				ImGui::Text(BakeStatus.c_str());
+
+			ImGui::TreePop();
+		}
+
+		m_Warmup = std::clamp(m_Warmup, 0.0f, c_MaxBakeDuration);
+		m_Duration = std::clamp(m_Duration, 0.1f, c_MaxBakeDuration);
+		m_Framerate = std::clamp(m_Framerate, 1, c_MaxBakeFramerate);
+	}
+}
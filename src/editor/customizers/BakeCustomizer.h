@@ -0,0 +1,34 @@
+#pragma once
+
+#include "environment/ExposeToJson.h"
+
+namespace Ainan {
+
+	const float c_MaxBakeDuration = 30.0f;
+	const int32_t c_MaxBakeFramerate = 120;
+
+	class BakeCustomizer
+	{
+	public:
+		void DisplayGUI();
+
+		const std::filesystem::path& GetBakePath() const { return m_BakePath; }
+
+	public:
+		//set by the gui, the particle system bakes itself the next time its gui is displayed
+		bool BakeRequested = false;
+		//shown under the bake button, set by the particle system
+		std::string BakeStatus;
+
+	private:
+		//plays the bake back instead of simulating, only takes effect if a bake is loaded
+		bool m_PlayBaked = false;
+		//seconds that are simulated but not recorded, so the bake starts with the effect already running
+		float m_Warmup = 2.0f;
+		float m_Duration = 4.0f;
+		int32_t m_Framerate = 60;
+		std::filesystem::path m_BakePath = ""; //relative to the environment folder, empty if it was never baked
+
+		EXPOSE_CUSTOMIZER_TO_JSON
+	};
+}
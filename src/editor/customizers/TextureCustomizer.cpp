@@ -13,7 +13,7 @@ namespace Ainan {
 
 		if (!UseDefaultTexture)
 		{
-			ParticleTexture = Renderer::CreateTexture(Image::LoadFromFile(AssetManager::s_EnvironmentDirectory.u8string() + "\\" + customizer.m_TexturePath.u8string()));
+			ParticleTexture = TextureCache::Get(AssetManager::s_EnvironmentDirectory.u8string() + "\\" + customizer.m_TexturePath.u8string());
 		}
 	}
 
@@ -38,14 +38,14 @@ namespace Ainan {
 					UseDefaultTexture = true;
 					m_TexturePath = "";
 				}
-				for (auto& tex : textures) 
+				for (auto& tex : *textures) 
 				{
 					std::string textureFileName = std::filesystem::path(tex).filename().u8string();
 					if (ImGui::Selectable(textureFileName.c_str(), &selected))
 					{
 						if (textureFileName != "Default") 
 						{
-							ParticleTexture = Renderer::CreateTexture(Image::LoadFromFile(tex.u8string()));
+							ParticleTexture = TextureCache::Get(tex.u8string());
 							
 							UseDefaultTexture = false;
 							m_TexturePath = tex.lexically_relative(AssetManager::s_EnvironmentDirectory).u8string();
@@ -0,0 +1,595 @@
+#include "EnvBinary.h"
+
+#include "ParticleSystem.h"
+#include "RadialLight.h"
+#include "SpotLight.h"
+#include "Sprite.h"
+#include "LitSprite.h"
+
+#ifdef PLATFORM_WINDOWS
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Ainan {
+
+	static size_t AlignTo16(size_t offset)
+	{
+		return (offset + 15) & ~(size_t)15;
+	}
+
+	//the chunks and the string table of an environment, copied out of its objects so it can be written
+	//from any thread while the editor keeps changing them
+	class EnvSnapshot
+	{
+	public:
+		EnvString AddString(const std::string& str)
+		{
+			EnvString result = { (uint32_t)m_Strings.size(), (uint32_t)str.size() };
+			m_Strings.insert(m_Strings.end(), str.begin(), str.end());
+			return result;
+		}
+
+		template<typename T>
+		void AddChunk(uint32_t id, const std::vector<T>& records)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			Chunk chunk;
+			chunk.Id = id;
+			chunk.ElementCount = (uint32_t)records.size();
+			chunk.Data.resize(records.size() * sizeof(T));
+			if (records.size() > 0)
+				memcpy(chunk.Data.data(), records.data(), chunk.Data.size());
+			m_Chunks.push_back(std::move(chunk));
+		}
+
+		std::vector<uint8_t> Serialize() const
+		{
+			//the string table is the last chunk
+			const size_t chunkCount = m_Chunks.size() + 1;
+			auto getChunkData = [this](size_t i) -> const uint8_t*
+			{
+				return i < m_Chunks.size() ? m_Chunks[i].Data.data() : (const uint8_t*)m_Strings.data();
+			};
+
+			EnvFileHeader header = {};
+			memcpy(header.Magic, c_EnvBinaryMagic, sizeof(header.Magic));
+			header.Version = c_EnvBinaryVersion;
+			header.ChunkCount = (uint32_t)chunkCount;
+
+			std::vector<EnvChunkEntry> toc(chunkCount);
+			size_t offset = AlignTo16(sizeof(EnvFileHeader) + toc.size() * sizeof(EnvChunkEntry));
+			for (size_t i = 0; i < chunkCount; i++)
+			{
+				bool isStrings = i == m_Chunks.size();
+				toc[i].Id = isStrings ? c_EnvStringsChunk : m_Chunks[i].Id;
+				toc[i].ElementCount = isStrings ? (uint32_t)m_Strings.size() : m_Chunks[i].ElementCount;
+				toc[i].Offset = offset;
+				toc[i].Size = isStrings ? m_Strings.size() : m_Chunks[i].Data.size();
+				offset = AlignTo16(offset + (size_t)toc[i].Size);
+			}
+
+			std::vector<uint8_t> data(offset, 0);
+			memcpy(data.data(), &header, sizeof(header));
+			memcpy(data.data() + sizeof(header), toc.data(), toc.size() * sizeof(EnvChunkEntry));
+			for (size_t i = 0; i < chunkCount; i++)
+				if (toc[i].Size > 0)
+					memcpy(data.data() + toc[i].Offset, getChunkData(i), (size_t)toc[i].Size);
+
+			return data;
+		}
+
+	private:
+		struct Chunk
+		{
+			uint32_t Id = 0;
+			uint32_t ElementCount = 0;
+			std::vector<uint8_t> Data;
+		};
+
+		std::vector<char> m_Strings;
+		std::vector<Chunk> m_Chunks;
+	};
+
+	//gives bounds checked access to the chunks of a mapped file
+	class EnvBinaryReader
+	{
+	public:
+		EnvBinaryReader(const uint8_t* data, size_t size) :
+			m_Data(data),
+			m_Size(size)
+		{}
+
+		bool ReadTableOfContents()
+		{
+			const EnvFileHeader* header = (const EnvFileHeader*)m_Data;
+			if (header->Version > c_EnvBinaryVersion)
+			{
+				AINAN_LOG_ERROR("Environment was saved by a newer version of Ainan");
+				return false;
+			}
+
+			if (sizeof(EnvFileHeader) + (uint64_t)header->ChunkCount * sizeof(EnvChunkEntry) > m_Size)
+				return false;
+
+			m_Chunks = (const EnvChunkEntry*)(m_Data + sizeof(EnvFileHeader));
+			m_ChunkCount = header->ChunkCount;
+			for (uint32_t i = 0; i < m_ChunkCount; i++)
+				if (m_Chunks[i].Offset > m_Size || m_Chunks[i].Size > m_Size - m_Chunks[i].Offset || m_Chunks[i].Offset % 16 != 0)
+					return false;
+
+			uint32_t stringCount = 0;
+			m_Strings = GetChunk<char>(c_EnvStringsChunk, stringCount);
+			m_StringsSize = stringCount;
+			return true;
+		}
+
+		//nullptr with a count of 0 if the chunk is missing, also if its size doesn't match its records
+		template<typename T>
+		const T* GetChunk(uint32_t id, uint32_t& count)
+		{
+			count = 0;
+			for (uint32_t i = 0; i < m_ChunkCount; i++)
+			{
+				if (m_Chunks[i].Id != id)
+					continue;
+
+				if (m_Chunks[i].Size != (uint64_t)m_Chunks[i].ElementCount * sizeof(T))
+				{
+					m_Valid = false;
+					return nullptr;
+				}
+
+				count = m_Chunks[i].ElementCount;
+				return (const T*)(m_Data + m_Chunks[i].Offset);
+			}
+			return nullptr;
+		}
+
+		std::string GetString(const EnvString& str)
+		{
+			if ((uint64_t)str.Offset + str.Length > m_StringsSize)
+			{
+				m_Valid = false;
+				return "";
+			}
+			return std::string(m_Strings + str.Offset, str.Length);
+		}
+
+		bool IsValid() const { return m_Valid; }
+
+	private:
+		const uint8_t* m_Data;
+		size_t m_Size;
+		const EnvChunkEntry* m_Chunks = nullptr;
+		uint32_t m_ChunkCount = 0;
+		const char* m_Strings = nullptr;
+		size_t m_StringsSize = 0;
+		bool m_Valid = true;
+	};
+
+	bool BinaryEnvironment::IsBinaryEnvironment(const uint8_t* data, size_t size)
+	{
+		return size >= sizeof(EnvFileHeader) && memcmp(data, c_EnvBinaryMagic, sizeof(c_EnvBinaryMagic)) == 0;
+	}
+
+	bool BinaryEnvironment::Save(const Environment& env, const std::string& path)
+	{
+		return WriteFile(Serialize(env), path);
+	}
+
+	bool BinaryEnvironment::WriteFile(const std::vector<uint8_t>& data, const std::string& path)
+	{
+		std::string tempPath = path + ".tmp";
+		FILE* file = fopen(tempPath.c_str(), "wb");
+		if (!file)
+			return false;
+
+		bool succeeded = fwrite(data.data(), 1, data.size(), file) == data.size();
+		succeeded = fflush(file) == 0 && succeeded;
+		//make sure the data is on disk before the rename, otherwise a crash can leave an empty file behind
+#ifdef PLATFORM_WINDOWS
+		succeeded = _commit(_fileno(file)) == 0 && succeeded;
+#else
+		succeeded = fsync(fileno(file)) == 0 && succeeded;
+#endif
+		succeeded = fclose(file) == 0 && succeeded;
+
+		std::error_code err;
+		if (succeeded)
+			std::filesystem::rename(std::filesystem::u8path(tempPath), std::filesystem::u8path(path), err);
+
+		if (!succeeded || err)
+		{
+			std::filesystem::remove(std::filesystem::u8path(tempPath), err);
+			return false;
+		}
+
+		return true;
+	}
+
+	std::vector<uint8_t> BinaryEnvironment::Serialize(const Environment& env)
+	{
+		return Serialize(*TakeSnapshot(env));
+	}
+
+	std::vector<uint8_t> BinaryEnvironment::Serialize(const EnvSnapshot& snapshot)
+	{
+		return snapshot.Serialize();
+	}
+
+	std::shared_ptr<const EnvSnapshot> BinaryEnvironment::TakeSnapshot(const Environment& env)
+	{
+		auto snapshot = std::make_shared<EnvSnapshot>();
+
+		EnvSettingsRecord settings = {};
+		settings.Name = snapshot->AddString(env.Name);
+		settings.BlurEnabled = env.BlurEnabled;
+		settings.BlurRadius = env.BlurRadius;
+		settings.BlendMode = (uint32_t)env.BlendMode;
+
+		std::vector<EnvObjectRecord> objects;
+		std::vector<EnvParticleSystemRecord> particleSystems;
+		std::vector<EnvForceRecord> forces;
+		std::vector<EnvRadialLightRecord> radialLights;
+		std::vector<EnvSpotLightRecord> spotLights;
+		std::vector<EnvSpriteRecord> sprites;
+		std::vector<EnvLitSpriteRecord> litSprites;
+
+		for (const pEnvironmentObject& obj : env.Objects)
+		{
+			switch (obj->Type)
+			{
+			case ParticleSystemType:
+			{
+				const ParticleSystem& ps = *(const ParticleSystem*)obj.get();
+				const ParticleCustomizer& customizer = ps.Customizer;
+				objects.push_back({ ParticleSystemType, (uint32_t)particleSystems.size() });
+
+				EnvParticleSystemRecord record = {};
+				record.Name = snapshot->AddString(ps.m_Name);
+				record.Mode = (uint32_t)customizer.Mode;
+				record.ParticlesPerSecond = customizer.m_ParticlesPerSecond;
+				record.SpawnPosition = customizer.m_SpawnPosition;
+				record.LineLength = customizer.m_LineLength;
+				record.LineAngle = customizer.m_LineAngle;
+				record.CircleRadius = customizer.m_CircleRadius;
+
+				record.RandomScale = customizer.m_ScaleCustomizer.m_RandomScale;
+				record.MinScale = customizer.m_ScaleCustomizer.m_MinScale;
+				record.MaxScale = customizer.m_ScaleCustomizer.m_MaxScale;
+				record.DefinedScale = customizer.m_ScaleCustomizer.m_DefinedScale;
+				record.EndScale = customizer.m_ScaleCustomizer.m_EndScale;
+				record.ScaleInterpolationType = customizer.m_ScaleCustomizer.m_InterpolationType;
+
+				record.StartColor = customizer.m_ColorCustomizer.StartColor;
+				record.EndColor = customizer.m_ColorCustomizer.EndColor;
+				record.ColorInterpolationType = customizer.m_ColorCustomizer.m_InterpolationType;
+
+				record.RandomLifetime = customizer.m_LifetimeCustomizer.m_RandomLifetime;
+				record.DefinedLifetime = customizer.m_LifetimeCustomizer.m_DefinedLifetime;
+				record.MinLifetime = customizer.m_LifetimeCustomizer.m_MinLifetime;
+				record.MaxLifetime = customizer.m_LifetimeCustomizer.m_MaxLifetime;
+
+				record.RandomVelocity = customizer.m_VelocityCustomizer.m_RandomVelocity;
+				record.DefinedVelocity = customizer.m_VelocityCustomizer.m_DefinedVelocity;
+				record.MinVelocity = customizer.m_VelocityCustomizer.m_MinVelocity;
+				record.MaxVelocity = customizer.m_VelocityCustomizer.m_MaxVelocity;
+				record.VelocityLimitType = customizer.m_VelocityCustomizer.CurrentVelocityLimitType;
+				record.MinNormalVelocityLimit = customizer.m_VelocityCustomizer.m_MinNormalVelocityLimit;
+				record.MaxNormalVelocityLimit = customizer.m_VelocityCustomizer.m_MaxNormalVelocityLimit;
+				record.MinPerAxisVelocityLimit = customizer.m_VelocityCustomizer.m_MinPerAxisVelocityLimit;
+				record.MaxPerAxisVelocityLimit = customizer.m_VelocityCustomizer.m_MaxPerAxisVelocityLimit;
+
+				record.NoiseEnabled = customizer.m_NoiseCustomizer.m_NoiseEnabled;
+				record.NoiseStrength = customizer.m_NoiseCustomizer.m_NoiseStrength;
+				record.NoiseFrequency = customizer.m_NoiseCustomizer.m_NoiseFrequency;
+				record.NoiseTarget = customizer.m_NoiseCustomizer.NoiseTarget;
+				record.NoiseInterpolationMode = (uint32_t)customizer.m_NoiseCustomizer.NoiseInterpolationMode;
+
+				record.UseDefaultTexture = customizer.m_TextureCustomizer.UseDefaultTexture;
+				record.TexturePath = snapshot->AddString(customizer.m_TextureCustomizer.m_TexturePath.u8string());
+
+				record.PlayBaked = customizer.m_BakeCustomizer.m_PlayBaked;
+				record.BakeWarmup = customizer.m_BakeCustomizer.m_Warmup;
+				record.BakeDuration = customizer.m_BakeCustomizer.m_Duration;
+				record.BakeFramerate = customizer.m_BakeCustomizer.m_Framerate;
+				record.BakePath = snapshot->AddString(customizer.m_BakeCustomizer.m_BakePath.u8string());
+
+				record.FirstForce = (uint32_t)forces.size();
+				record.ForceCount = (uint32_t)customizer.m_ForceCustomizer.m_Forces.size();
+				for (auto& [key, force] : customizer.m_ForceCustomizer.m_Forces)
+				{
+					EnvForceRecord forceRecord = {};
+					forceRecord.Key = snapshot->AddString(key);
+					forceRecord.Enabled = force.Enabled;
+					forceRecord.Type = force.Type;
+					forceRecord.DF_Value = force.DF_Value;
+					forceRecord.RF_Target = force.RF_Target;
+					forceRecord.RF_Strength = force.RF_Strength;
+					forces.push_back(forceRecord);
+				}
+
+				particleSystems.push_back(record);
+				break;
+			}
+
+			case RadialLightType:
+			{
+				const RadialLight& light = *(const RadialLight*)obj.get();
+				objects.push_back({ RadialLightType, (uint32_t)radialLights.size() });
+
+				EnvRadialLightRecord record = {};
+				record.Name = snapshot->AddString(light.m_Name);
+				record.Position = light.Position;
+				record.Color = light.Color;
+				record.Intensity = light.Intensity;
+				radialLights.push_back(record);
+				break;
+			}
+
+			case SpotLightType:
+			{
+				const SpotLight& light = *(const SpotLight*)obj.get();
+				objects.push_back({ SpotLightType, (uint32_t)spotLights.size() });
+
+				EnvSpotLightRecord record = {};
+				record.Name = snapshot->AddString(light.m_Name);
+				record.Position = light.Position;
+				record.Color = light.Color;
+				record.Angle = light.Angle;
+				record.InnerCutoff = light.InnerCutoff;
+				record.OuterCutoff = light.OuterCutoff;
+				record.Intensity = light.Intensity;
+				spotLights.push_back(record);
+				break;
+			}
+
+			case SpriteType:
+			{
+				const Sprite& sprite = *(const Sprite*)obj.get();
+				objects.push_back({ SpriteType, (uint32_t)sprites.size() });
+
+				EnvSpriteRecord record = {};
+				record.Name = snapshot->AddString(sprite.m_Name);
+				record.Position = sprite.Position;
+				record.Scale = sprite.Scale;
+				record.Rotation = sprite.Rotation;
+				record.Tint = sprite.Tint;
+				record.TexturePath = snapshot->AddString(sprite.m_TexturePath.u8string());
+				sprites.push_back(record);
+				break;
+			}
+
+			case LitSpriteType:
+			{
+				const LitSprite& sprite = *(const LitSprite*)obj.get();
+				objects.push_back({ LitSpriteType, (uint32_t)litSprites.size() });
+
+				EnvLitSpriteRecord record = {};
+				record.Name = snapshot->AddString(sprite.m_Name);
+				record.Position = sprite.m_Position;
+				record.Tint = sprite.m_UniformBufferData.Tint;
+				record.Scale = sprite.m_Scale;
+				record.Rotation = sprite.m_Rotation;
+				record.BaseLight = sprite.m_UniformBufferData.BaseLight;
+				record.MaterialConstantCoefficient = sprite.m_UniformBufferData.MaterialConstantCoefficient;
+				record.MaterialLinearCoefficient = sprite.m_UniformBufferData.MaterialLinearCoefficient;
+				record.MaterialQuadraticCoefficient = sprite.m_UniformBufferData.MaterialQuadraticCoefficient;
+				litSprites.push_back(record);
+				break;
+			}
+
+			default: //this means we have a type that we haven't implemented how to save it
+				AINAN_LOG_FATAL("Invalid object type enum");
+				break;
+			}
+		}
+
+		snapshot->AddChunk(c_EnvSettingsChunk, std::vector<EnvSettingsRecord>{ settings });
+		snapshot->AddChunk(c_EnvObjectsChunk, objects);
+		snapshot->AddChunk(c_EnvParticleSystemsChunk, particleSystems);
+		snapshot->AddChunk(c_EnvForcesChunk, forces);
+		snapshot->AddChunk(c_EnvRadialLightsChunk, radialLights);
+		snapshot->AddChunk(c_EnvSpotLightsChunk, spotLights);
+		snapshot->AddChunk(c_EnvSpritesChunk, sprites);
+		snapshot->AddChunk(c_EnvLitSpritesChunk, litSprites);
+
+		return snapshot;
+	}
+
+	Environment* BinaryEnvironment::Load(const MappedFile& file)
+	{
+		if (!file.IsValid() || !IsBinaryEnvironment(file.GetData(), file.GetSize()))
+			return nullptr;
+
+		EnvBinaryReader reader(file.GetData(), file.GetSize());
+		if (!reader.ReadTableOfContents())
+			return nullptr;
+
+		uint32_t settingsCount, objectCount, particleSystemCount, forceCount, radialLightCount, spotLightCount, spriteCount, litSpriteCount;
+		const EnvSettingsRecord* settings = reader.GetChunk<EnvSettingsRecord>(c_EnvSettingsChunk, settingsCount);
+		const EnvObjectRecord* objects = reader.GetChunk<EnvObjectRecord>(c_EnvObjectsChunk, objectCount);
+		const EnvParticleSystemRecord* particleSystems = reader.GetChunk<EnvParticleSystemRecord>(c_EnvParticleSystemsChunk, particleSystemCount);
+		const EnvForceRecord* forces = reader.GetChunk<EnvForceRecord>(c_EnvForcesChunk, forceCount);
+		const EnvRadialLightRecord* radialLights = reader.GetChunk<EnvRadialLightRecord>(c_EnvRadialLightsChunk, radialLightCount);
+		const EnvSpotLightRecord* spotLights = reader.GetChunk<EnvSpotLightRecord>(c_EnvSpotLightsChunk, spotLightCount);
+		const EnvSpriteRecord* sprites = reader.GetChunk<EnvSpriteRecord>(c_EnvSpritesChunk, spriteCount);
+		const EnvLitSpriteRecord* litSprites = reader.GetChunk<EnvLitSpriteRecord>(c_EnvLitSpritesChunk, litSpriteCount);
+		if (!reader.IsValid() || settingsCount != 1)
+			return nullptr;
+
+		std::unique_ptr<Environment> env = std::make_unique<Environment>();
+		env->Name = reader.GetString(settings->Name);
+		env->BlurEnabled = settings->BlurEnabled;
+		env->BlurRadius = settings->BlurRadius;
+		env->BlendMode = (RenderingBlendMode)settings->BlendMode;
+
+		for (uint32_t i = 0; i < objectCount; i++)
+		{
+			uint32_t index = objects[i].Index;
+			switch (objects[i].Type)
+			{
+			case ParticleSystemType:
+			{
+				if (index >= particleSystemCount)
+					return nullptr;
+				const EnvParticleSystemRecord& record = particleSystems[index];
+				if ((uint64_t)record.FirstForce + record.ForceCount > forceCount)
+					return nullptr;
+
+				std::unique_ptr<ParticleSystem> ps = std::make_unique<ParticleSystem>();
+				ParticleCustomizer& customizer = ps->Customizer;
+				ps->m_Name = reader.GetString(record.Name);
+				customizer.Mode = (SpawnMode)record.Mode;
+				customizer.m_ParticlesPerSecond = record.ParticlesPerSecond;
+				customizer.m_SpawnPosition = record.SpawnPosition;
+				customizer.m_LineLength = record.LineLength;
+				customizer.m_LineAngle = record.LineAngle;
+				customizer.m_CircleRadius = record.CircleRadius;
+
+				customizer.m_ScaleCustomizer.m_RandomScale = record.RandomScale;
+				customizer.m_ScaleCustomizer.m_MinScale = record.MinScale;
+				customizer.m_ScaleCustomizer.m_MaxScale = record.MaxScale;
+				customizer.m_ScaleCustomizer.m_DefinedScale = record.DefinedScale;
+				customizer.m_ScaleCustomizer.m_EndScale = record.EndScale;
+				customizer.m_ScaleCustomizer.m_InterpolationType = (InterpolationType)record.ScaleInterpolationType;
+
+				customizer.m_ColorCustomizer.StartColor = record.StartColor;
+				customizer.m_ColorCustomizer.EndColor = record.EndColor;
+				customizer.m_ColorCustomizer.m_InterpolationType = (InterpolationType)record.ColorInterpolationType;
+
+				customizer.m_LifetimeCustomizer.m_RandomLifetime = record.RandomLifetime;
+				customizer.m_LifetimeCustomizer.m_DefinedLifetime = record.DefinedLifetime;
+				customizer.m_LifetimeCustomizer.m_MinLifetime = record.MinLifetime;
+				customizer.m_LifetimeCustomizer.m_MaxLifetime = record.MaxLifetime;
+
+				customizer.m_VelocityCustomizer.m_RandomVelocity = record.RandomVelocity;
+				customizer.m_VelocityCustomizer.m_DefinedVelocity = record.DefinedVelocity;
+				customizer.m_VelocityCustomizer.m_MinVelocity = record.MinVelocity;
+				customizer.m_VelocityCustomizer.m_MaxVelocity = record.MaxVelocity;
+				customizer.m_VelocityCustomizer.CurrentVelocityLimitType = (VelocityCustomizer::VelocityLimitType)record.VelocityLimitType;
+				customizer.m_VelocityCustomizer.m_MinNormalVelocityLimit = record.MinNormalVelocityLimit;
+				customizer.m_VelocityCustomizer.m_MaxNormalVelocityLimit = record.MaxNormalVelocityLimit;
+				customizer.m_VelocityCustomizer.m_MinPerAxisVelocityLimit = record.MinPerAxisVelocityLimit;
+				customizer.m_VelocityCustomizer.m_MaxPerAxisVelocityLimit = record.MaxPerAxisVelocityLimit;
+
+				customizer.m_NoiseCustomizer.m_NoiseEnabled = record.NoiseEnabled;
+				customizer.m_NoiseCustomizer.m_NoiseStrength = record.NoiseStrength;
+				customizer.m_NoiseCustomizer.m_NoiseFrequency = record.NoiseFrequency;
+				customizer.m_NoiseCustomizer.NoiseTarget = (NoiseCustomizer::NoiseApplyTarget)record.NoiseTarget;
+				customizer.m_NoiseCustomizer.NoiseInterpolationMode = (FastNoise::Interp)record.NoiseInterpolationMode;
+
+				customizer.m_TextureCustomizer.UseDefaultTexture = record.UseDefaultTexture;
+				customizer.m_TextureCustomizer.m_TexturePath = reader.GetString(record.TexturePath);
+				if (!customizer.m_TextureCustomizer.UseDefaultTexture)
+					customizer.m_TextureCustomizer.ParticleTexture = TextureCache::Get(AssetManager::s_EnvironmentDirectory.u8string() + "\\" + customizer.m_TextureCustomizer.m_TexturePath.u8string());
+
+				customizer.m_BakeCustomizer.m_PlayBaked = record.PlayBaked;
+				customizer.m_BakeCustomizer.m_Warmup = record.BakeWarmup;
+				customizer.m_BakeCustomizer.m_Duration = record.BakeDuration;
+				customizer.m_BakeCustomizer.m_Framerate = record.BakeFramerate;
+				customizer.m_BakeCustomizer.m_BakePath = reader.GetString(record.BakePath);
+				ps->LoadBake();
+
+				//the forces saved replace the default ones
+				customizer.m_ForceCustomizer.m_Forces.clear();
+				for (uint32_t j = record.FirstForce; j < record.FirstForce + record.ForceCount; j++)
+				{
+					Force& force = customizer.m_ForceCustomizer.m_Forces[reader.GetString(forces[j].Key)];
+					force.Enabled = forces[j].Enabled;
+					force.Type = (Force::ForceType)forces[j].Type;
+					force.DF_Value = forces[j].DF_Value;
+					force.RF_Target = forces[j].RF_Target;
+					force.RF_Strength = forces[j].RF_Strength;
+				}
+
+				env->Objects.push_back(std::move(ps));
+				break;
+			}
+
+			case RadialLightType:
+			{
+				if (index >= radialLightCount)
+					return nullptr;
+				const EnvRadialLightRecord& record = radialLights[index];
+
+				std::unique_ptr<RadialLight> light = std::make_unique<RadialLight>();
+				light->m_Name = reader.GetString(record.Name);
+				light->Position = record.Position;
+				light->Color = record.Color;
+				light->Intensity = record.Intensity;
+				env->Objects.push_back(std::move(light));
+				break;
+			}
+
+			case SpotLightType:
+			{
+				if (index >= spotLightCount)
+					return nullptr;
+				const EnvSpotLightRecord& record = spotLights[index];
+
+				std::unique_ptr<SpotLight> light = std::make_unique<SpotLight>();
+				light->m_Name = reader.GetString(record.Name);
+				light->Position = record.Position;
+				light->Color = record.Color;
+				light->Angle = record.Angle;
+				light->InnerCutoff = record.InnerCutoff;
+				light->OuterCutoff = record.OuterCutoff;
+				light->Intensity = record.Intensity;
+				env->Objects.push_back(std::move(light));
+				break;
+			}
+
+			case SpriteType:
+			{
+				if (index >= spriteCount)
+					return nullptr;
+				const EnvSpriteRecord& record = sprites[index];
+
+				std::unique_ptr<Sprite> sprite = std::make_unique<Sprite>();
+				sprite->m_Name = reader.GetString(record.Name);
+				sprite->Position = record.Position;
+				sprite->Scale = record.Scale;
+				sprite->Rotation = record.Rotation;
+				sprite->Tint = record.Tint;
+				sprite->m_TexturePath = reader.GetString(record.TexturePath);
+				if (sprite->m_TexturePath != "")
+					sprite->LoadTextureFromFile(AssetManager::s_EnvironmentDirectory.u8string() + "\\" + sprite->m_TexturePath.u8string());
+				env->Objects.push_back(std::move(sprite));
+				break;
+			}
+
+			case LitSpriteType:
+			{
+				if (index >= litSpriteCount)
+					return nullptr;
+				const EnvLitSpriteRecord& record = litSprites[index];
+
+				std::unique_ptr<LitSprite> sprite = std::make_unique<LitSprite>();
+				sprite->m_Name = reader.GetString(record.Name);
+				sprite->m_Position = record.Position;
+				sprite->m_UniformBufferData.Tint = record.Tint;
+				sprite->m_Scale = record.Scale;
+				sprite->m_Rotation = record.Rotation;
+				sprite->m_UniformBufferData.BaseLight = record.BaseLight;
+				sprite->m_UniformBufferData.MaterialConstantCoefficient = record.MaterialConstantCoefficient;
+				sprite->m_UniformBufferData.MaterialLinearCoefficient = record.MaterialLinearCoefficient;
+				sprite->m_UniformBufferData.MaterialQuadraticCoefficient = record.MaterialQuadraticCoefficient;
+				env->Objects.push_back(std::move(sprite));
+				break;
+			}
+
+			default:
+				AINAN_LOG_ERROR("Environment has an object of unknown type " + std::to_string(objects[i].Type));
+				return nullptr;
+			}
+		}
+
+		if (!reader.IsValid())
+			return nullptr;
+
+		return env.release();
+	}
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "Environment.h"
+#include "file/MappedFile.h"
+
+namespace Ainan {
+
+	//the binary .env format, a header and a table of contents followed by chunks of POD records,
+	//records reference their strings in the string table chunk so nothing has to be parsed when loading.
+	//everything is little endian (every platform Ainan runs on is) and every chunk starts 16 byte aligned,
+	//chunks with unknown ids are skipped so newer versions can add them without breaking older ones
+	const char c_EnvBinaryMagic[8] = { 'A', 'I', 'N', 'A', 'N', 'E', 'N', 'V' };
+	const uint32_t c_EnvBinaryVersion = 1;
+
+	constexpr uint32_t EnvChunkId(const char(&id)[5])
+	{
+		return (uint32_t)id[0] | (uint32_t)id[1] << 8 | (uint32_t)id[2] << 16 | (uint32_t)id[3] << 24;
+	}
+
+	const uint32_t c_EnvSettingsChunk = EnvChunkId("SETT");
+	const uint32_t c_EnvStringsChunk = EnvChunkId("STRS");
+	const uint32_t c_EnvObjectsChunk = EnvChunkId("OBJS");
+	const uint32_t c_EnvParticleSystemsChunk = EnvChunkId("PSYS");
+	const uint32_t c_EnvForcesChunk = EnvChunkId("FRCE");
+	const uint32_t c_EnvRadialLightsChunk = EnvChunkId("RLIT");
+	const uint32_t c_EnvSpotLightsChunk = EnvChunkId("SLIT");
+	const uint32_t c_EnvSpritesChunk = EnvChunkId("SPRT");
+	const uint32_t c_EnvLitSpritesChunk = EnvChunkId("LSPR");
+
+	struct EnvFileHeader
+	{
+		char Magic[8];
+		uint32_t Version;
+		uint32_t ChunkCount; //the table of contents follows the header
+	};
+	static_assert(sizeof(EnvFileHeader) == 16);
+
+	struct EnvChunkEntry
+	{
+		uint32_t Id;
+		uint32_t ElementCount;
+		uint64_t Offset; //from the start of the file
+		uint64_t Size;
+	};
+	static_assert(sizeof(EnvChunkEntry) == 24);
+
+	//utf8 bytes in the string table, not null terminated
+	struct EnvString
+	{
+		uint32_t Offset;
+		uint32_t Length;
+	};
+
+	struct EnvSettingsRecord
+	{
+		EnvString Name;
+		uint32_t BlurEnabled;
+		float BlurRadius;
+		uint32_t BlendMode;
+		uint32_t Reserved[3];
+	};
+	static_assert(sizeof(EnvSettingsRecord) == 32);
+
+	//one per object in the order they appear in the environment, Index is into the chunk of its type
+	struct EnvObjectRecord
+	{
+		uint32_t Type;
+		uint32_t Index;
+	};
+	static_assert(sizeof(EnvObjectRecord) == 8);
+
+	struct EnvParticleSystemRecord
+	{
+		EnvString Name;
+		uint32_t Mode;
+		float ParticlesPerSecond;
+		glm::vec2 SpawnPosition;
+		float LineLength;
+		float LineAngle;
+		float CircleRadius;
+
+		//scale
+		uint32_t RandomScale;
+		float MinScale;
+		float MaxScale;
+		float DefinedScale;
+		float EndScale;
+		uint32_t ScaleInterpolationType;
+
+		//color
+		glm::vec4 StartColor;
+		glm::vec4 EndColor;
+		uint32_t ColorInterpolationType;
+
+		//lifetime
+		uint32_t RandomLifetime;
+		float DefinedLifetime;
+		float MinLifetime;
+		float MaxLifetime;
+
+		//velocity
+		uint32_t RandomVelocity;
+		glm::vec2 DefinedVelocity;
+		glm::vec2 MinVelocity;
+		glm::vec2 MaxVelocity;
+		uint32_t VelocityLimitType;
+		float MinNormalVelocityLimit;
+		float MaxNormalVelocityLimit;
+		glm::vec2 MinPerAxisVelocityLimit;
+		glm::vec2 MaxPerAxisVelocityLimit;
+
+		//noise
+		uint32_t NoiseEnabled;
+		float NoiseStrength;
+		float NoiseFrequency;
+		uint32_t NoiseTarget;
+		uint32_t NoiseInterpolationMode;
+
+		//texture
+		uint32_t UseDefaultTexture;
+		EnvString TexturePath;
+
+		//bake
+		uint32_t PlayBaked;
+		float BakeWarmup;
+		float BakeDuration;
+		int32_t BakeFramerate;
+		EnvString BakePath;
+
+		//forces, in the forces chunk
+		uint32_t FirstForce;
+		uint32_t ForceCount;
+	};
+	static_assert(sizeof(EnvParticleSystemRecord) == 232);
+
+	struct EnvForceRecord
+	{
+		EnvString Key;
+		uint32_t Enabled;
+		uint32_t Type;
+		glm::vec2 DF_Value;
+		glm::vec2 RF_Target;
+		float RF_Strength;
+		uint32_t Reserved;
+	};
+	static_assert(sizeof(EnvForceRecord) == 40);
+
+	struct EnvRadialLightRecord
+	{
+		EnvString Name;
+		glm::vec2 Position;
+		glm::vec4 Color;
+		float Intensity;
+		uint32_t Reserved;
+	};
+	static_assert(sizeof(EnvRadialLightRecord) == 40);
+
+	struct EnvSpotLightRecord
+	{
+		EnvString Name;
+		glm::vec2 Position;
+		glm::vec4 Color;
+		float Angle;
+		float InnerCutoff;
+		float OuterCutoff;
+		float Intensity;
+	};
+	static_assert(sizeof(EnvSpotLightRecord) == 48);
+
+	struct EnvSpriteRecord
+	{
+		EnvString Name;
+		glm::vec2 Position;
+		float Scale;
+		float Rotation;
+		glm::vec4 Tint;
+		EnvString TexturePath;
+	};
+	static_assert(sizeof(EnvSpriteRecord) == 48);
+
+	struct EnvLitSpriteRecord
+	{
+		EnvString Name;
+		glm::vec2 Position;
+		glm::vec4 Tint;
+		float Scale;
+		float Rotation;
+		float BaseLight;
+		float MaterialConstantCoefficient;
+		float MaterialLinearCoefficient;
+		float MaterialQuadraticCoefficient;
+	};
+	static_assert(sizeof(EnvLitSpriteRecord) == 56);
+
+	class EnvSnapshot;
+
+	//reads and writes the binary format, a class so the customizers can give it access to their data
+	class BinaryEnvironment
+	{
+	public:
+		static bool IsBinaryEnvironment(const uint8_t* data, size_t size);
+		static bool Save(const Environment& env, const std::string& path);
+		static std::vector<uint8_t> Serialize(const Environment& env);
+		//copies the records out of the objects, has to be taken on the thread that updates the environment
+		//but the snapshot doesn't reference it so it can be serialized on any thread afterwards
+		static std::shared_ptr<const EnvSnapshot> TakeSnapshot(const Environment& env);
+		static std::vector<uint8_t> Serialize(const EnvSnapshot& snapshot);
+		//writes to a temporary file next to path and renames it over path, so path is either the old or the new file
+		static bool WriteFile(const std::vector<uint8_t>& data, const std::string& path);
+		//nullptr if the file is invalid
+		static Environment* Load(const MappedFile& file);
+	};
+}
@@ -5,6 +5,7 @@
 #include "json/json.hpp"
 #include "Sprite.h"
 #include "LitSprite.h"
+#include "EnvBinary.h"
 
 using json = nlohmann::json;
 
@@ -14,7 +15,7 @@ using json = nlohmann::json;
 
 namespace Ainan {
 
-	static void ParticleSystemFromJson(Environment* env, json& data, std::string id);
+	void ParticleSystemFromJson(Environment* env, json& data, std::string id);
 	static void RadialLightFromJson(Environment* env, json& data, std::string id);
 	static void SpotLightFromJson(Environment* env, json& data, std::string id);
 	static void SpriteFromJson(Environment* env,json& data, std::string id);
@@ -25,12 +26,43 @@ namespace Ainan {
 	{
 		json data;
 
-		//we are assuming the .env file is in environment's top folder
-		AssetManager::Init(std::filesystem::path(path).parent_path());
+		//we are assuming the .env file is in environment's top folder,
+		//packs act like that folder with the environment stored inside of them
+		std::filesystem::path envPath = path;
+		if (envPath.extension().u8string() == c_AssetPackExtension)
+		{
+			if (!AssetManager::MountPack(envPath))
+			{
+				AINAN_LOG_ERROR("Cannot load environemnt. Asset pack is invalid, loaded empty project instead.");
+				return new Environment(Environment::Default());
+			}
+			envPath = AssetManager::s_EnvironmentDirectory / c_AssetPackEnvironmentEntry;
+		}
+		else
+			AssetManager::Init(envPath.parent_path());
 		
+		MappedFile file = AssetManager::MapFile(envPath);
+		if (!file.IsValid())
+		{
+			AINAN_LOG_ERROR("Cannot load environemnt. Environment file cannot be opened, loaded empty project instead.");
+			return new Environment(Environment::Default());
+		}
+
+		if (BinaryEnvironment::IsBinaryEnvironment(file.GetData(), file.GetSize()))
+		{
+			Environment* env = BinaryEnvironment::Load(file);
+			if (env == nullptr)
+			{
+				AINAN_LOG_ERROR("Cannot load environemnt. Environment file is invalid, loaded empty project instead.");
+				return new Environment(Environment::Default());
+			}
+			return env;
+		}
+
+		//anything that isn't binary is treated as an environment exported to json
 		try 
 		{
-			data = json::parse(AssetManager::ReadEntireTextFile(path));
+			data = json::parse(file.GetData(), file.GetData() + file.GetSize());
 		}
 		catch (std::exception)
 		{
@@ -145,9 +177,17 @@ namespace Ainan {
 		ps->Customizer.m_TextureCustomizer.m_TexturePath = data[id + "TexturePath"].get<std::string>();
 		if (!ps->Customizer.m_TextureCustomizer.UseDefaultTexture)
 		{
-			ps->Customizer.m_TextureCustomizer.ParticleTexture = Renderer::CreateTexture(Image::LoadFromFile(AssetManager::s_EnvironmentDirectory.u8string() + "\\" + ps->Customizer.m_TextureCustomizer.m_TexturePath.u8string()));
+			ps->Customizer.m_TextureCustomizer.ParticleTexture = TextureCache::Get(AssetManager::s_EnvironmentDirectory.u8string() + "\\" + ps->Customizer.m_TextureCustomizer.m_TexturePath.u8string());
 		}
 
+		//Bake data, environments saved before baking existed don't have it
+		ps->Customizer.m_BakeCustomizer.m_PlayBaked = data.value(id + "PlayBaked", false);
+		ps->Customizer.m_BakeCustomizer.m_Warmup = data.value(id + "BakeWarmup", ps->Customizer.m_BakeCustomizer.m_Warmup);
+		ps->Customizer.m_BakeCustomizer.m_Duration = data.value(id + "BakeDuration", ps->Customizer.m_BakeCustomizer.m_Duration);
+		ps->Customizer.m_BakeCustomizer.m_Framerate = data.value(id + "BakeFramerate", ps->Customizer.m_BakeCustomizer.m_Framerate);
+		ps->Customizer.m_BakeCustomizer.m_BakePath = data.value(id + "BakePath", std::string());
+		ps->LoadBake();
+
 		//Force data
 		size_t forceCount = data[id + "Force Count"].get<size_t>();
 
@@ -6,6 +6,9 @@
 #include "RadialLight.h"
 #include "SpotLight.h"
 #include "LitSprite.h"
+#include "EnvBinary.h"
+#include "file/AssetPack.h"
+#include "renderer/TextureLoader.h"
 
 using json = nlohmann::json;
 
@@ -16,13 +19,78 @@ using json = nlohmann::json;
 namespace Ainan {
 
 	//forward declarations
-	static void toJson(json& j, const ParticleSystem& ps, size_t objectOrder);
+	void toJson(json& j, const ParticleSystem& ps, size_t objectOrder);
 	static void toJson(json& j, const RadialLight& light, size_t objectOrder);
 	static void toJson(json& j, const SpotLight& light, size_t objectOrder);
 	static void toJson(json& j, const Sprite& sprite, size_t objectOrder);
 	static void toJson(json& j, const LitSprite& sprite, size_t objectOrder);
 
 	bool SaveEnvironment(const Environment& env, std::string path)
+	{
+		return BinaryEnvironment::Save(env, path);
+	}
+
+	//adds a file from the environment folder (or the mounted pack) to the pack, decoded textures are stored under the
+	//path the TextureDiskCache looks for them so loading them from the pack skips decoding
+	static bool AddAssetToPack(AssetPackWriter& writer, const std::filesystem::path& relativePath, bool isTexture,
+		TextureConversion conversion, bool predecodeTextures)
+	{
+		MappedFile file = AssetManager::MapFile(AssetManager::s_EnvironmentDirectory / relativePath);
+		if (!file.IsValid())
+		{
+			AINAN_LOG_WARNING("Could not add " + relativePath.u8string() + " to the asset pack");
+			return true;
+		}
+
+		if (!writer.AddEntry(relativePath.u8string(), file.GetData(), file.GetSize()))
+			return false;
+
+		if (!isTexture || !predecodeTextures)
+			return true;
+
+		auto chain = TextureLoader::DecodeMipChain(file.GetData(), file.GetSize(), TextureFormat::Unspecified, conversion);
+		if (!chain)
+			return true;
+
+		uint64_t sourceHash = TextureDiskCache::GetSourceHash(file.GetData(), file.GetSize());
+		std::filesystem::path cachePath = TextureDiskCache::GetCacheDirectory().lexically_relative(AssetManager::s_EnvironmentDirectory) /
+			TextureDiskCache::GetEntryName(sourceHash, TextureFormat::Unspecified, conversion);
+		std::vector<uint8_t> decoded = TextureDiskCache::Serialize(*chain, sourceHash);
+		return writer.AddEntry(cachePath.u8string(), decoded.data(), decoded.size());
+	}
+
+	bool ExportEnvironmentPack(const Environment& env, std::string path, bool predecodeTextures)
+	{
+		AssetPackWriter writer;
+		if (!writer.Open(path))
+			return false;
+
+		std::vector<uint8_t> envData = BinaryEnvironment::Serialize(env);
+		bool succeeded = writer.AddEntry(c_AssetPackEnvironmentEntry, envData.data(), envData.size());
+
+		//only files the environment references are packed, with the conversions they are loaded with
+		for (size_t i = 0; i < env.Objects.size() && succeeded; i++)
+		{
+			if (env.Objects[i]->Type == ParticleSystemType)
+			{
+				const ParticleSystem& ps = *(const ParticleSystem*)env.Objects[i].get();
+				if (!ps.Customizer.m_TextureCustomizer.UseDefaultTexture && ps.Customizer.m_TextureCustomizer.m_TexturePath != "")
+					succeeded = AddAssetToPack(writer, ps.Customizer.m_TextureCustomizer.m_TexturePath, true, TextureConversion::None, predecodeTextures);
+				if (succeeded && ps.Customizer.m_BakeCustomizer.GetBakePath() != "")
+					succeeded = AddAssetToPack(writer, ps.Customizer.m_BakeCustomizer.GetBakePath(), false, TextureConversion::None, false);
+			}
+			else if (env.Objects[i]->Type == SpriteType)
+			{
+				const Sprite& sprite = *(const Sprite*)env.Objects[i].get();
+				if (sprite.m_TexturePath != "")
+					succeeded = AddAssetToPack(writer, sprite.m_TexturePath, true, TextureConversion::GrayScaleToRGB, predecodeTextures);
+			}
+		}
+
+		return writer.Close() && succeeded;
+	}
+
+	bool ExportEnvironmentToJson(const Environment& env, std::string path)
 	{
 		json data;
 
@@ -68,9 +136,8 @@ namespace Ainan {
 
 		std::string jsonString = data.dump(4);
 
-		FILE* file = (FILE*)1;
-		auto error = fopen_s(&file, path.c_str(), "w");
-		if (error == 0) {
+		FILE* file = fopen(path.c_str(), "w");
+		if (file) {
 			fwrite(jsonString.c_str(), 1, jsonString.size(), file);
 			fclose(file);
 		}
@@ -133,6 +200,13 @@ namespace Ainan {
 		j[id + "UseDefaultTexture"] = ps.Customizer.m_TextureCustomizer.UseDefaultTexture;
 		j[id + "TexturePath"] = ps.Customizer.m_TextureCustomizer.m_TexturePath.u8string();
 
+		//Bake data
+		j[id + "PlayBaked"] = ps.Customizer.m_BakeCustomizer.m_PlayBaked;
+		j[id + "BakeWarmup"] = ps.Customizer.m_BakeCustomizer.m_Warmup;
+		j[id + "BakeDuration"] = ps.Customizer.m_BakeCustomizer.m_Duration;
+		j[id + "BakeFramerate"] = ps.Customizer.m_BakeCustomizer.m_Framerate;
+		j[id + "BakePath"] = ps.Customizer.m_BakeCustomizer.m_BakePath.u8string();
+
 		//Force data
 		{
 			size_t i = 0;
@@ -4,8 +4,10 @@
 namespace Ainan {
 	class Environment;
 	class ParticleSystem;
+	class BinaryEnvironment;
 }
 
 #define EXPOSE_CUSTOMIZER_TO_JSON friend void toJson(nlohmann::json& j, const ParticleSystem& ps, size_t objectOrder);\
 								  friend void ParticleSystemFromJson(Environment* env, nlohmann::json& data, std::string id);\
-								  friend class ParticleSystem;
+								  friend class ParticleSystem;\
+								  friend class BinaryEnvironment;
@@ -93,6 +93,8 @@ namespace Ainan {
 		shader->BindUniformBuffer(m_UniformBuffer, 1, RenderingStage::VertexShader);
 		shader->BindUniformBuffer(m_UniformBuffer, 1, RenderingStage::FragmentShader);
 
+		Renderer::BeginPass(RenderPass::LitSprite);
 		Renderer::Draw(m_VertexBuffer, shader, Primitive::Triangles, 6);
+		Renderer::EndPass();
 	}
 }
\ No newline at end of file
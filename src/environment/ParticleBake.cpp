@@ -0,0 +1,164 @@
+#include "ParticleBake.h"
+#include "file/AssetManager.h"
+
+namespace Ainan {
+
+	struct ParticleBakeLayout
+	{
+		size_t FrameOffsetsOffset;
+		size_t PaletteOffset;
+		size_t ParticlesOffset;
+		size_t Size;
+	};
+
+	static size_t AlignTo16(size_t offset)
+	{
+		return (offset + 15) & ~(size_t)15;
+	}
+
+	static ParticleBakeLayout GetLayout(uint32_t frameCount, uint32_t particleCount)
+	{
+		ParticleBakeLayout layout;
+		layout.FrameOffsetsOffset = sizeof(ParticleBakeHeader);
+		layout.PaletteOffset = AlignTo16(layout.FrameOffsetsOffset + ((size_t)frameCount + 1) * sizeof(uint32_t));
+		layout.ParticlesOffset = layout.PaletteOffset + c_ParticleBakePaletteSize * sizeof(glm::vec4);
+		layout.Size = layout.ParticlesOffset + (size_t)particleCount * sizeof(BakedParticle);
+		return layout;
+	}
+
+	static uint16_t Quantize(float value, float min, float max)
+	{
+		float normalized = max > min ? (value - min) / (max - min) : 0.0f;
+		return (uint16_t)std::round(std::clamp(normalized, 0.0f, 1.0f) * 65535.0f);
+	}
+
+	ParticleBakeRecorder::ParticleBakeRecorder(float framerate) :
+		m_Framerate(framerate)
+	{}
+
+	void ParticleBakeRecorder::BeginFrame()
+	{
+		m_FrameOffsets.push_back((uint32_t)m_Particles.size());
+	}
+
+	void ParticleBakeRecorder::AddParticle(const glm::vec2& relativePosition, float scale, float lifeFraction)
+	{
+		assert(m_FrameOffsets.size() > 0);
+		m_Particles.push_back({ relativePosition, scale, lifeFraction });
+	}
+
+	bool ParticleBakeRecorder::Save(const std::filesystem::path& path, const std::array<glm::vec4, c_ParticleBakePaletteSize>& palette) const
+	{
+		ParticleBakeHeader header = {};
+		header.Magic = c_ParticleBakeMagic;
+		header.Version = c_ParticleBakeVersion;
+		header.FrameCount = (uint32_t)m_FrameOffsets.size();
+		header.ParticleCount = (uint32_t)m_Particles.size();
+		header.Framerate = m_Framerate;
+		header.MaxScale = 0.0f;
+		header.BoundsMin = glm::vec2(0.0f);
+		header.BoundsMax = glm::vec2(0.0f);
+
+		if (m_Particles.size() > 0)
+		{
+			header.BoundsMin = m_Particles[0].Position;
+			header.BoundsMax = m_Particles[0].Position;
+		}
+		for (auto& particle : m_Particles)
+		{
+			header.BoundsMin = glm::min(header.BoundsMin, particle.Position);
+			header.BoundsMax = glm::max(header.BoundsMax, particle.Position);
+			header.MaxScale = std::max(header.MaxScale, particle.Scale);
+		}
+
+		ParticleBakeLayout layout = GetLayout(header.FrameCount, header.ParticleCount);
+		std::vector<uint8_t> data(layout.Size, 0);
+		memcpy(data.data(), &header, sizeof(header));
+
+		uint32_t* frameOffsets = (uint32_t*)&data[layout.FrameOffsetsOffset];
+		memcpy(frameOffsets, m_FrameOffsets.data(), m_FrameOffsets.size() * sizeof(uint32_t));
+		frameOffsets[header.FrameCount] = header.ParticleCount;
+
+		memcpy(&data[layout.PaletteOffset], palette.data(), palette.size() * sizeof(glm::vec4));
+
+		BakedParticle* particles = (BakedParticle*)&data[layout.ParticlesOffset];
+		for (size_t i = 0; i < m_Particles.size(); i++)
+		{
+			const RecordedParticle& particle = m_Particles[i];
+			particles[i].X = Quantize(particle.Position.x, header.BoundsMin.x, header.BoundsMax.x);
+			particles[i].Y = Quantize(particle.Position.y, header.BoundsMin.y, header.BoundsMax.y);
+			particles[i].Scale = Quantize(particle.Scale, 0.0f, header.MaxScale);
+			particles[i].ColorIndex = (uint8_t)std::round(std::clamp(particle.LifeFraction, 0.0f, 1.0f) * (c_ParticleBakePaletteSize - 1));
+			particles[i].Padding = 0;
+		}
+
+		std::error_code error;
+		std::filesystem::create_directories(path.parent_path(), error);
+
+		FILE* file = fopen(path.u8string().c_str(), "wb");
+		if (!file)
+		{
+			AINAN_LOG_ERROR("Could not write particle bake to " + path.u8string());
+			return false;
+		}
+
+		bool succeeded = fwrite(data.data(), 1, data.size(), file) == data.size();
+		succeeded = fclose(file) == 0 && succeeded;
+		if (!succeeded)
+			AINAN_LOG_ERROR("Could not write particle bake to " + path.u8string());
+		return succeeded;
+	}
+
+	std::shared_ptr<ParticleBake> ParticleBake::Load(const std::filesystem::path& path)
+	{
+		std::shared_ptr<ParticleBake> bake(new ParticleBake());
+		bake->m_File = AssetManager::MapFile(path);
+		if (!bake->m_File.IsValid() || bake->m_File.GetSize() < sizeof(ParticleBakeHeader))
+			return nullptr;
+
+		const uint8_t* data = bake->m_File.GetData();
+		const ParticleBakeHeader* header = (const ParticleBakeHeader*)data;
+		if (header->Magic != c_ParticleBakeMagic || header->Version != c_ParticleBakeVersion ||
+			header->FrameCount == 0 || !(header->Framerate > 0.0f))
+			return nullptr;
+
+		ParticleBakeLayout layout = GetLayout(header->FrameCount, header->ParticleCount);
+		if (layout.Size != bake->m_File.GetSize())
+			return nullptr;
+
+		//make sure reading any frame stays inside the file
+		const uint32_t* frameOffsets = (const uint32_t*)(data + layout.FrameOffsetsOffset);
+		for (uint32_t i = 0; i < header->FrameCount; i++)
+			if (frameOffsets[i] > frameOffsets[i + 1])
+				return nullptr;
+		if (frameOffsets[0] != 0 || frameOffsets[header->FrameCount] != header->ParticleCount)
+			return nullptr;
+
+		bake->m_Header = header;
+		bake->m_FrameOffsets = frameOffsets;
+		bake->m_Palette = (const glm::vec4*)(data + layout.PaletteOffset);
+		bake->m_Particles = (const BakedParticle*)(data + layout.ParticlesOffset);
+		return bake;
+	}
+
+	size_t ParticleBake::DecodeFrame(uint32_t frame, const glm::vec2& origin, glm::vec2* positions, float* scales, glm::vec4* colors, size_t maxCount) const
+	{
+		assert(frame < m_Header->FrameCount);
+
+		const BakedParticle* particles = m_Particles + m_FrameOffsets[frame];
+		size_t count = std::min((size_t)GetParticleCount(frame), maxCount);
+
+		glm::vec2 positionStep = (m_Header->BoundsMax - m_Header->BoundsMin) / 65535.0f;
+		glm::vec2 positionBase = origin + m_Header->BoundsMin;
+		float scaleStep = m_Header->MaxScale / 65535.0f;
+
+		for (size_t i = 0; i < count; i++)
+		{
+			positions[i] = positionBase + glm::vec2(particles[i].X, particles[i].Y) * positionStep;
+			scales[i] = particles[i].Scale * scaleStep;
+			colors[i] = m_Palette[particles[i].ColorIndex];
+		}
+
+		return count;
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "file/MappedFile.h"
+
+namespace Ainan {
+
+	const uint32_t c_ParticleBakeMagic = 0x4b425041; //"APBK"
+	const uint32_t c_ParticleBakeVersion = 1;
+	//colors are stored as an index into a palette sampled along the particle lifetime
+	const size_t c_ParticleBakePaletteSize = 256;
+
+	//a particle in a baked frame, positions and scales are quantized to the range of the whole bake
+	struct BakedParticle
+	{
+		uint16_t X;
+		uint16_t Y;
+		uint16_t Scale;
+		uint8_t ColorIndex;
+		uint8_t Padding;
+	};
+	static_assert(sizeof(BakedParticle) == 8);
+
+	//a bake file is this header followed by FrameCount + 1 particle offsets (uint32_t, one past the last frame is ParticleCount),
+	//the palette (glm::vec4) and the particles, every section starts 16 byte aligned and everything is in the native byte order
+	struct ParticleBakeHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t FrameCount;
+		uint32_t ParticleCount;
+		float Framerate;
+		float MaxScale;
+		//positions are relative to the spawn position, so baked effects can still be moved
+		glm::vec2 BoundsMin;
+		glm::vec2 BoundsMax;
+		uint32_t Reserved[2];
+	};
+	static_assert(sizeof(ParticleBakeHeader) == 48);
+
+	//collects the particles of every frame while a particle system is simulated, then quantizes and saves them
+	class ParticleBakeRecorder
+	{
+	public:
+		ParticleBakeRecorder(float framerate);
+
+		void BeginFrame();
+		//lifeFraction is 0 when the particle spawned and 1 when it dies
+		void AddParticle(const glm::vec2& relativePosition, float scale, float lifeFraction);
+		bool Save(const std::filesystem::path& path, const std::array<glm::vec4, c_ParticleBakePaletteSize>& palette) const;
+
+	private:
+		struct RecordedParticle
+		{
+			glm::vec2 Position;
+			float Scale;
+			float LifeFraction;
+		};
+
+		float m_Framerate;
+		std::vector<uint32_t> m_FrameOffsets;
+		std::vector<RecordedParticle> m_Particles;
+	};
+
+	//a bake file mapped into memory, frames are decoded straight out of the mapping so playing it back costs no simulation
+	class ParticleBake
+	{
+	public:
+		//nullptr if the file can't be mapped or isn't a valid bake
+		static std::shared_ptr<ParticleBake> Load(const std::filesystem::path& path);
+
+		uint32_t GetFrameCount() const { return m_Header->FrameCount; }
+		float GetFramerate() const { return m_Header->Framerate; }
+		float GetDuration() const { return m_Header->FrameCount / m_Header->Framerate; }
+		size_t GetSize() const { return m_File.GetSize(); }
+		uint32_t GetParticleCount(uint32_t frame) const { return m_FrameOffsets[frame + 1] - m_FrameOffsets[frame]; }
+
+		//writes at most maxCount particles of a frame into the draw buffers and returns how many were written
+		size_t DecodeFrame(uint32_t frame, const glm::vec2& origin, glm::vec2* positions, float* scales, glm::vec4* colors, size_t maxCount) const;
+
+	private:
+		ParticleBake() = default;
+
+	private:
+		MappedFile m_File;
+		const ParticleBakeHeader* m_Header = nullptr;
+		const uint32_t* m_FrameOffsets = nullptr;
+		const glm::vec4* m_Palette = nullptr;
+		const BakedParticle* m_Particles = nullptr;
+	};
+}
@@ -1,5 +1,7 @@
 #include "ParticleSystem.h"
 
+#include "file/AssetManager.h"
+
 namespace Ainan {
 	static std::shared_ptr<Texture> DefaultTexture;
 	static int s_DefaultTextureUserCount = 0;
@@ -28,7 +30,7 @@ namespace Ainan {
 		s_DefaultTextureUserCount++;
 		if (s_DefaultTextureUserCount == 1)
 		{
-			DefaultTexture = Renderer::CreateTexture(Image::LoadFromFile("res/Circle.png"));
+			DefaultTexture = TextureCache::Get("res/Circle.png");
 		}
 	}
 
@@ -40,6 +42,18 @@ namespace Ainan {
 	}
 
 	void ParticleSystem::Update(const float deltaTime)
+	{
+		if (IsPlayingBake())
+		{
+			m_BakePlaybackTime += deltaTime;
+			ActiveParticleCount = m_Bake->GetParticleCount((uint32_t)(m_BakePlaybackTime * m_Bake->GetFramerate()) % m_Bake->GetFrameCount());
+			return;
+		}
+
+		Simulate(deltaTime);
+	}
+
+	void ParticleSystem::Simulate(const float deltaTime)
 	{
 		SpawnAllParticlesOnQue(deltaTime);
 
@@ -103,8 +117,33 @@ namespace Ainan {
 		}
 	}
 
+	float ParticleSystem::GetLifeFraction(size_t particle) const
+	{
+		return (m_Particles.LifeTime[particle] - m_Particles.RemainingLifeTime[particle]) / m_Particles.LifeTime[particle];
+	}
+
+	float ParticleSystem::GetScale(size_t particle, float lifeFraction)
+	{
+		//use the t value to get the scale of the particle using it's not using a Custom Curve
+		if (Customizer.m_ScaleCustomizer.m_InterpolationType != Custom)
+		{
+			return Interpolation::Interporpolate(Customizer.m_ScaleCustomizer.m_InterpolationType,
+				m_Particles.StartScale[particle],
+				m_Particles.EndScale[particle],
+				lifeFraction);
+		}
+		else
+			return Customizer.m_ScaleCustomizer.m_Curve.Interpolate(m_Particles.StartScale[particle], m_Particles.EndScale[particle], lifeFraction);
+	}
+
 	void ParticleSystem::Draw()
 	{
+		if (IsPlayingBake())
+		{
+			DrawBaked();
+			return;
+		}
+
 		//reset the amount of particles to be drawn every frame
 		m_ParticleDrawCount = 0;
 
@@ -117,24 +156,11 @@ namespace Ainan {
 				//get a value from 0 to 1, showing how much the particle lived.
 				//1 meaning it's lifetime is over and it is going to die (get deactivated and not rendered).
 				//0 meaning it's just been spawned (activated).
-				float t = (m_Particles.LifeTime[i] - m_Particles.RemainingLifeTime[i]) / m_Particles.LifeTime[i];
-
-				//use the t value to get the scale of the particle using it's not using a Custom Curve
-				float scale = 0.0f;
-				if (Customizer.m_ScaleCustomizer.m_InterpolationType != Custom)
-				{
-					scale = 
-						Interpolation::Interporpolate(Customizer.m_ScaleCustomizer.m_InterpolationType,
-						m_Particles.StartScale[i],
-						m_Particles.EndScale[i],
-						t);
-				}
-				else
-					scale = Customizer.m_ScaleCustomizer.m_Curve.Interpolate(m_Particles.StartScale[i], m_Particles.EndScale[i], t);
+				float t = GetLifeFraction(i);
 
 				//put the drawing properties of the particles in the draw buffers that would be drawn this frame
 				m_ParticleDrawTranslationBuffer[m_ParticleDrawCount] = m_Particles.Position[i];
-				m_ParticleDrawScaleBuffer[m_ParticleDrawCount] = scale;
+				m_ParticleDrawScaleBuffer[m_ParticleDrawCount] = GetScale(i, t);
 
 				m_ParticleDrawColorBuffer[m_ParticleDrawCount] =
 					Interpolation::Interporpolate(Customizer.m_ColorCustomizer.m_InterpolationType,
@@ -186,6 +212,7 @@ namespace Ainan {
 	{
 		//deactivate all particles which will make them stop rendering
 		m_Particles.IsActive.assign(m_Particles.IsActive.size(), false);
+		m_BakePlaybackTime = 0.0f;
 	}
 
 	ParticleSystem::ParticleSystem(const ParticleSystem& Psystem) :
@@ -196,6 +223,10 @@ namespace Ainan {
 		m_ParticleDrawScaleBuffer.resize(Psystem.m_ParticleDrawScaleBuffer.size());
 		m_ParticleDrawColorBuffer.resize(Psystem.m_ParticleDrawColorBuffer.size());
 
+		//the bake file belongs to the original, the copy has to be baked on its own
+		Customizer.m_BakeCustomizer.m_BakePath = "";
+		Customizer.m_BakeCustomizer.BakeStatus = "";
+
 		//copy other variables
 		m_Particles = Psystem.m_Particles;
 		m_Name = Psystem.m_Name;
@@ -215,6 +246,123 @@ namespace Ainan {
 		if (EditorOpen)
 			Customizer.DisplayGUI(m_Name, EditorOpen);
 		ImGui::PopID();
+
+		if (Customizer.m_BakeCustomizer.BakeRequested)
+		{
+			Customizer.m_BakeCustomizer.BakeRequested = false;
+			Bake();
+		}
+	}
+
+	bool ParticleSystem::Bake()
+	{
+		BakeCustomizer& settings = Customizer.m_BakeCustomizer;
+		if (AssetManager::s_EnvironmentDirectory == "")
+		{
+			settings.BakeStatus = "Save the environment before baking";
+			return false;
+		}
+
+		//the bake is simulated on this system's own state, which is put back afterwards
+		ParticlesData savedParticles = m_Particles;
+		float savedTimeTillNextParticleSpawn = TimeTillNextParticleSpawn;
+		uint32_t savedActiveParticleCount = ActiveParticleCount;
+		m_Particles.IsActive.assign(m_Particles.IsActive.size(), false);
+		TimeTillNextParticleSpawn = 0.0f;
+
+		const float deltaTime = 1.0f / settings.m_Framerate;
+		const int32_t warmupFrameCount = (int32_t)std::round(settings.m_Warmup * settings.m_Framerate);
+		const int32_t frameCount = std::max((int32_t)std::round(settings.m_Duration * settings.m_Framerate), 1);
+		const glm::vec2 origin = Customizer.m_SpawnPosition * c_GlobalScaleFactor;
+
+		for (int32_t i = 0; i < warmupFrameCount; i++)
+			Simulate(deltaTime);
+
+		ParticleBakeRecorder recorder((float)settings.m_Framerate);
+		for (int32_t i = 0; i < frameCount; i++)
+		{
+			Simulate(deltaTime);
+
+			recorder.BeginFrame();
+			for (size_t j = 0; j < c_ParticlePoolSize; j++)
+			{
+				if (!m_Particles.IsActive[j])
+					continue;
+
+				float t = GetLifeFraction(j);
+				recorder.AddParticle(m_Particles.Position[j] - origin, GetScale(j, t), t);
+			}
+		}
+
+		m_Particles = savedParticles;
+		TimeTillNextParticleSpawn = savedTimeTillNextParticleSpawn;
+		ActiveParticleCount = savedActiveParticleCount;
+
+		std::array<glm::vec4, c_ParticleBakePaletteSize> palette;
+		for (size_t i = 0; i < palette.size(); i++)
+		{
+			palette[i] = Interpolation::Interporpolate(Customizer.m_ColorCustomizer.m_InterpolationType,
+				Customizer.m_ColorCustomizer.StartColor,
+				Customizer.m_ColorCustomizer.EndColor,
+				(float)i / (palette.size() - 1));
+		}
+
+		//every bake gets a new file so the old one can stay mapped until the new one is ready
+		std::mt19937 mt(std::random_device{}());
+		std::string fileName = "Bakes/bake_" + std::to_string(mt()) + ".pbake";
+		if (!recorder.Save(AssetManager::s_EnvironmentDirectory / fileName, palette))
+		{
+			settings.BakeStatus = "Could not save the bake";
+			return false;
+		}
+
+		std::filesystem::path oldBakePath = settings.m_BakePath;
+		settings.m_BakePath = fileName;
+		if (!LoadBake())
+			return false;
+
+		if (oldBakePath != "")
+		{
+			std::error_code error;
+			std::filesystem::remove(AssetManager::s_EnvironmentDirectory / oldBakePath, error);
+		}
+
+		settings.m_PlayBaked = true;
+		return true;
+	}
+
+	bool ParticleSystem::LoadBake()
+	{
+		BakeCustomizer& settings = Customizer.m_BakeCustomizer;
+		m_Bake.reset();
+		if (settings.m_BakePath == "")
+			return false;
+
+		m_Bake = ParticleBake::Load(AssetManager::s_EnvironmentDirectory / settings.m_BakePath);
+		if (!m_Bake)
+		{
+			AINAN_LOG_WARNING("Could not load particle bake " + settings.m_BakePath.u8string() + ", " + m_Name + " is simulated instead");
+			settings.BakeStatus = "The bake file is missing or invalid";
+			return false;
+		}
+
+		settings.BakeStatus = std::to_string(m_Bake->GetFrameCount()) + " frames baked, " +
+			std::to_string(m_Bake->GetSize() / 1024) + " KB";
+		return true;
+	}
+
+	void ParticleSystem::DrawBaked()
+	{
+		uint32_t frame = (uint32_t)(m_BakePlaybackTime * m_Bake->GetFramerate()) % m_Bake->GetFrameCount();
+		m_ParticleDrawCount = m_Bake->DecodeFrame(frame, Customizer.m_SpawnPosition * c_GlobalScaleFactor,
+			m_ParticleDrawTranslationBuffer.data(), m_ParticleDrawScaleBuffer.data(), m_ParticleDrawColorBuffer.data(), c_ParticlePoolSize);
+
+		if (Customizer.m_TextureCustomizer.UseDefaultTexture)
+			Renderer::DrawQuadv(m_ParticleDrawTranslationBuffer.data(), m_ParticleDrawColorBuffer.data(),
+				m_ParticleDrawScaleBuffer.data(), m_ParticleDrawCount, DefaultTexture);
+		else
+			Renderer::DrawQuadv(m_ParticleDrawTranslationBuffer.data(), m_ParticleDrawColorBuffer.data(),
+				m_ParticleDrawScaleBuffer.data(), m_ParticleDrawCount, Customizer.m_TextureCustomizer.ParticleTexture);
 	}
 
 	void ParticleSystem::SpawnAllParticlesOnQue(const float& deltaTime)
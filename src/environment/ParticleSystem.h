@@ -7,6 +7,7 @@
 #include "editor/Gizmo.h"
 #include "renderer/ShaderProgram.h"
 #include "renderer/Renderer.h"
+#include "ParticleBake.h"
 
 namespace Ainan {
 
@@ -25,6 +26,12 @@ namespace Ainan {
 		void ClearParticles();
 		void DisplayGUI() override;
 
+		//simulates the bake window set in the BakeCustomizer and saves it in the environment folder
+		bool Bake();
+		//maps the bake file the BakeCustomizer points to, if there is one
+		bool LoadBake();
+		bool IsPlayingBake() const { return m_Bake && Customizer.m_BakeCustomizer.m_PlayBaked; }
+
 		glm::vec2* GetPositionRef() override { return &Customizer.m_SpawnPosition; };
 		ParticleSystem(const ParticleSystem& Psystem);
 		ParticleSystem operator=(const ParticleSystem& Psystem);
@@ -58,5 +65,16 @@ namespace Ainan {
 		size_t m_ParticleDrawCount = 0;
 
 		ParticlesData m_Particles;
+
+		std::shared_ptr<ParticleBake> m_Bake;
+		//time since play mode started, used to pick the baked frame
+		float m_BakePlaybackTime = 0.0f;
+
+	private:
+		void Simulate(const float deltaTime);
+		//0 when the particle spawned and 1 when it dies
+		float GetLifeFraction(size_t particle) const;
+		float GetScale(size_t particle, float lifeFraction);
+		void DrawBaked();
 	};
 }
\ No newline at end of file
@@ -8,11 +8,7 @@ namespace Ainan {
 		m_Name = "Sprite";
 		EditorOpen = false;
 
-		Image img = Image::LoadFromFile("res/CheckerBoard.png");
-
-		Image::GrayScaleToRGBA(img);
-
-		m_Texture = Renderer::CreateTexture(img);
+		m_Texture = TextureCache::Get("res/CheckerBoard.png", TextureFormat::Unspecified, TextureConversion::GrayScaleToRGBA);
 	}
 
 	void Sprite::Update(const float deltaTime)
@@ -46,7 +42,7 @@ namespace Ainan {
 				LoadTextureFromFile("res/CheckerBoard.png");
 				m_TexturePath = "";
 			}
-			for (auto& tex : textures)
+			for (auto& tex : *textures)
 			{
 				std::string textureFileName = std::filesystem::path(tex).filename().u8string();
 				if (ImGui::Selectable(textureFileName.c_str(), &selected))
@@ -91,15 +87,7 @@ namespace Ainan {
 
 	void Sprite::LoadTextureFromFile(const std::string& path)
 	{
-		m_Texture.reset();
-
-
-		Image img = Image::LoadFromFile(path);
-
-		if (img.Format == TextureFormat::R)
-			Image::GrayScaleToRGB(img);
-
-		m_Texture = Renderer::CreateTexture(img);
+		m_Texture = TextureCache::Get(path, TextureFormat::Unspecified, TextureConversion::GrayScaleToRGB);
 	}
 
 }
\ No newline at end of file
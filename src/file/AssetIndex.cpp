@@ -0,0 +1,403 @@
+#include "AssetIndex.h"
+
+#ifdef PLATFORM_LINUX
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif // PLATFORM_LINUX
+
+namespace Ainan {
+
+	//how long the index thread waits before checking if it should stop
+	const int32_t c_AssetIndexStopCheckMs = 100;
+
+	AssetIndex::AssetIndex(const std::filesystem::path& root, const std::vector<std::filesystem::path>& extraTextures) :
+		m_Root(root),
+		m_ExtraTextures(extraTextures),
+		m_Snapshot(std::make_shared<Snapshot>())
+	{
+		m_IndexThread = std::thread([this]() { IndexThreadLoop(); });
+	}
+
+	AssetIndex::~AssetIndex()
+	{
+		m_Stop = true;
+		if (m_IndexThread.joinable())
+			m_IndexThread.join();
+
+#ifdef PLATFORM_LINUX
+		if (m_InotifyFd >= 0)
+			close(m_InotifyFd);
+#endif // PLATFORM_LINUX
+	}
+
+	bool AssetIndex::IsReady() const
+	{
+		std::lock_guard lock(m_SnapshotMutex);
+		return m_Snapshot->Ready;
+	}
+
+	std::shared_ptr<const std::vector<AssetIndexEntry>> AssetIndex::GetDirectory(const std::filesystem::path& directory) const
+	{
+		std::shared_ptr<const Snapshot> snapshot;
+		{
+			std::lock_guard lock(m_SnapshotMutex);
+			snapshot = m_Snapshot;
+		}
+
+		auto it = snapshot->Directories.find(GetKey(directory));
+		if (it == snapshot->Directories.end())
+			return nullptr;
+		return it->second;
+	}
+
+	std::shared_ptr<const std::vector<std::filesystem::path>> AssetIndex::GetTextures() const
+	{
+		std::lock_guard lock(m_SnapshotMutex);
+		return m_Snapshot->Textures;
+	}
+
+	std::vector<std::filesystem::path> AssetIndex::TakeChangedFiles()
+	{
+		std::set<std::string> changedFiles;
+		{
+			std::lock_guard lock(m_ChangesMutex);
+			if (m_ChangedFiles.empty())
+				return {};
+			changedFiles.swap(m_ChangedFiles);
+		}
+
+		std::vector<std::filesystem::path> result;
+		result.reserve(changedFiles.size());
+		for (const std::string& path : changedFiles)
+			result.push_back(std::filesystem::u8path(path));
+		return result;
+	}
+
+	bool AssetIndex::IsTextureFile(const std::filesystem::path& path)
+	{
+		std::string extension = path.extension().u8string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return (char)std::tolower((uint8_t)c); });
+		return extension == ".jpg" || extension == ".jpeg" || extension == ".bmp" || extension == ".png";
+	}
+
+	//the same folder always gets the same key no matter how the path was put together
+	std::string AssetIndex::GetKey(const std::filesystem::path& path)
+	{
+		std::string key = path.lexically_normal().u8string();
+		while (key.size() > 1 && key.back() == (char)std::filesystem::path::preferred_separator)
+			key.pop_back();
+		return key;
+	}
+
+	void AssetIndex::IndexThreadLoop()
+	{
+#ifdef PLATFORM_LINUX
+		m_InotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (m_InotifyFd < 0)
+			AINAN_LOG_WARNING("Could not watch " + m_Root.u8string() + ", the asset list is updated periodically instead");
+		else
+			m_TrackWriteTimes = false;
+#endif // PLATFORM_LINUX
+
+		Rescan();
+
+		while (!m_Stop)
+		{
+#ifdef PLATFORM_LINUX
+			if (m_InotifyFd >= 0)
+			{
+				pollfd pollInfo = { m_InotifyFd, POLLIN, 0 };
+				if (poll(&pollInfo, 1, c_AssetIndexStopCheckMs) <= 0)
+					continue;
+
+				//operations like copying a folder produce bursts of events, they are applied together
+				ReadEvents();
+				while (!m_Stop && poll(&pollInfo, 1, (int)c_AssetIndexBatchDelay.count()) > 0)
+					ReadEvents();
+
+				Publish();
+				continue;
+			}
+#endif // PLATFORM_LINUX
+
+			auto rescanTime = std::chrono::steady_clock::now() + c_AssetIndexRescanInterval;
+			while (!m_Stop && std::chrono::steady_clock::now() < rescanTime)
+				std::this_thread::sleep_for(std::chrono::milliseconds(c_AssetIndexStopCheckMs));
+
+			if (!m_Stop)
+				Rescan();
+		}
+	}
+
+	void AssetIndex::Rescan()
+	{
+#ifdef PLATFORM_LINUX
+		for (auto& [watch, directory] : m_Watches)
+			inotify_rm_watch(m_InotifyFd, watch);
+		m_Watches.clear();
+#endif // PLATFORM_LINUX
+
+		auto oldDirectories = std::move(m_Directories);
+		auto oldTextures = std::move(m_Textures);
+		auto oldWriteTimes = std::move(m_WriteTimes);
+		m_Directories.clear();
+		m_Textures.clear();
+		m_WriteTimes.clear();
+
+		ScanDirectory(m_Root);
+		if (m_Stop)
+			return;
+
+		//everything is new on the first scan, that isn't a change
+		bool firstScan = !IsReady();
+		for (auto& [path, writeTime] : m_WriteTimes)
+		{
+			auto it = oldWriteTimes.find(path);
+			if (!firstScan && (it == oldWriteTimes.end() || it->second != writeTime))
+				AddChangedFile(std::filesystem::u8path(path));
+		}
+
+		//only what actually changed is rebuilt
+		m_DirtyDirectories.clear();
+		for (auto& [key, entries] : m_Directories)
+		{
+			auto it = oldDirectories.find(key);
+			if (it == oldDirectories.end() || it->second != entries)
+				m_DirtyDirectories.insert(key);
+		}
+		for (auto& [key, entries] : oldDirectories)
+			if (m_Directories.find(key) == m_Directories.end())
+				m_DirtyDirectories.insert(key);
+		m_TexturesDirty = m_Textures != oldTextures;
+
+		Publish();
+	}
+
+	void AssetIndex::ScanDirectory(const std::filesystem::path& directory)
+	{
+#ifdef PLATFORM_LINUX
+		//watched before listing it so nothing created while it is listed is missed
+		WatchDirectory(directory);
+#endif // PLATFORM_LINUX
+
+		std::string key = GetKey(directory);
+		m_Directories[key].clear();
+		m_DirtyDirectories.insert(key);
+
+		std::error_code error;
+		std::filesystem::directory_iterator it(directory, error);
+		for (; !error && it != std::filesystem::directory_iterator() && !m_Stop; it.increment(error))
+		{
+			std::error_code typeError;
+			bool isDirectory = it->is_directory(typeError);
+			std::string name = it->path().filename().u8string();
+			m_Directories[key][name] = isDirectory;
+
+			//links aren't followed so they can't make the scan loop forever
+			if (isDirectory && !it->is_symlink(typeError))
+				ScanDirectory(it->path());
+			else if (!isDirectory && IsTextureFile(it->path()))
+			{
+				m_Textures.insert(it->path().lexically_normal().u8string());
+				m_TexturesDirty = true;
+			}
+
+			if (!isDirectory && m_TrackWriteTimes)
+			{
+				auto writeTime = it->last_write_time(typeError);
+				if (!typeError)
+					m_WriteTimes[it->path().lexically_normal().u8string()] = writeTime.time_since_epoch().count();
+			}
+		}
+	}
+
+	void AssetIndex::RemoveDirectory(const std::string& key)
+	{
+		std::string prefix = key + (char)std::filesystem::path::preferred_separator;
+		auto isInside = [&](const std::string& path) { return path == key || path.compare(0, prefix.size(), prefix) == 0; };
+
+		for (auto it = m_Directories.begin(); it != m_Directories.end();)
+		{
+			if (isInside(it->first))
+			{
+				m_DirtyDirectories.insert(it->first);
+				it = m_Directories.erase(it);
+			}
+			else
+				it++;
+		}
+
+		for (auto it = m_Textures.lower_bound(prefix); it != m_Textures.end() && isInside(*it);)
+		{
+			it = m_Textures.erase(it);
+			m_TexturesDirty = true;
+		}
+
+#ifdef PLATFORM_LINUX
+		for (auto it = m_Watches.begin(); it != m_Watches.end();)
+		{
+			if (isInside(GetKey(it->second)))
+			{
+				inotify_rm_watch(m_InotifyFd, it->first);
+				it = m_Watches.erase(it);
+			}
+			else
+				it++;
+		}
+#endif // PLATFORM_LINUX
+	}
+
+	void AssetIndex::AddEntry(const std::filesystem::path& directory, const std::string& name, bool isDirectory)
+	{
+		std::string key = GetKey(directory);
+		m_Directories[key][name] = isDirectory;
+		m_DirtyDirectories.insert(key);
+
+		std::filesystem::path path = directory / std::filesystem::u8path(name);
+		if (isDirectory)
+			ScanDirectory(path);
+		else if (IsTextureFile(path))
+		{
+			m_Textures.insert(path.lexically_normal().u8string());
+			m_TexturesDirty = true;
+		}
+	}
+
+	void AssetIndex::RemoveEntry(const std::filesystem::path& directory, const std::string& name)
+	{
+		std::string key = GetKey(directory);
+		auto dir = m_Directories.find(key);
+		if (dir == m_Directories.end())
+			return;
+
+		auto entry = dir->second.find(name);
+		if (entry == dir->second.end())
+			return;
+
+		bool isDirectory = entry->second;
+		dir->second.erase(entry);
+		m_DirtyDirectories.insert(key);
+
+		std::filesystem::path path = directory / std::filesystem::u8path(name);
+		if (isDirectory)
+			RemoveDirectory(GetKey(path));
+		else if (m_Textures.erase(path.lexically_normal().u8string()) > 0)
+			m_TexturesDirty = true;
+	}
+
+	void AssetIndex::Publish()
+	{
+		std::shared_ptr<const Snapshot> oldSnapshot;
+		{
+			std::lock_guard lock(m_SnapshotMutex);
+			oldSnapshot = m_Snapshot;
+		}
+
+		if (oldSnapshot->Ready && m_DirtyDirectories.empty() && !m_TexturesDirty)
+			return;
+
+		//unchanged directories share their lists with the old snapshot
+		auto snapshot = std::make_shared<Snapshot>(*oldSnapshot);
+		for (const std::string& key : m_DirtyDirectories)
+		{
+			auto dir = m_Directories.find(key);
+			if (dir == m_Directories.end())
+			{
+				snapshot->Directories.erase(key);
+				continue;
+			}
+
+			auto entries = std::make_shared<std::vector<AssetIndexEntry>>();
+			entries->reserve(dir->second.size());
+			std::filesystem::path directory = std::filesystem::u8path(key);
+			for (auto& [name, isDirectory] : dir->second)
+				entries->push_back({ directory / std::filesystem::u8path(name), name, isDirectory });
+			snapshot->Directories[key] = entries;
+		}
+
+		if (m_TexturesDirty || !snapshot->Textures)
+		{
+			auto textures = std::make_shared<std::vector<std::filesystem::path>>();
+			textures->reserve(m_Textures.size() + m_ExtraTextures.size());
+			for (const std::string& texture : m_Textures)
+				textures->push_back(std::filesystem::u8path(texture));
+			for (auto& texture : m_ExtraTextures)
+				if (m_Textures.find(texture.lexically_normal().u8string()) == m_Textures.end())
+					textures->push_back(texture);
+			snapshot->Textures = textures;
+		}
+
+		snapshot->Ready = true;
+		m_DirtyDirectories.clear();
+		m_TexturesDirty = false;
+
+		std::lock_guard lock(m_SnapshotMutex);
+		m_Snapshot = snapshot;
+	}
+
+	void AssetIndex::AddChangedFile(const std::filesystem::path& path)
+	{
+		std::lock_guard lock(m_ChangesMutex);
+		m_ChangedFiles.insert(path.lexically_normal().u8string());
+	}
+
+#ifdef PLATFORM_LINUX
+	void AssetIndex::WatchDirectory(const std::filesystem::path& directory)
+	{
+		if (m_InotifyFd < 0)
+			return;
+
+		int watch = inotify_add_watch(m_InotifyFd, directory.c_str(), IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE | IN_ONLYDIR);
+		if (watch >= 0)
+			m_Watches[watch] = directory;
+	}
+
+	void AssetIndex::ReadEvents()
+	{
+		alignas(inotify_event) char buffer[16 * 1024];
+		while (true)
+		{
+			ssize_t size = read(m_InotifyFd, buffer, sizeof(buffer));
+			if (size <= 0)
+				return;
+
+			for (char* ptr = buffer; ptr < buffer + size;)
+			{
+				const inotify_event* event = (const inotify_event*)ptr;
+				ptr += sizeof(inotify_event) + event->len;
+
+				//events were dropped so the index can't be trusted anymore
+				if (event->mask & IN_Q_OVERFLOW)
+				{
+					Rescan();
+					return;
+				}
+
+				if (event->mask & IN_IGNORED)
+				{
+					m_Watches.erase(event->wd);
+					continue;
+				}
+
+				auto watch = m_Watches.find(event->wd);
+				if (watch == m_Watches.end() || event->len == 0)
+					continue;
+
+				//copied because adding and removing entries can change the watches
+				std::filesystem::path directory = watch->second;
+				std::string name = event->name;
+				bool isDirectory = (event->mask & IN_ISDIR) != 0;
+				if (event->mask & (IN_CREATE | IN_MOVED_TO))
+					AddEntry(directory, name, isDirectory);
+				else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+					RemoveEntry(directory, name);
+
+				//created files are reported once they are closed, files saved by replacing them are moved in
+				if (!isDirectory && (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)))
+					AddChangedFile(directory / std::filesystem::u8path(name));
+			}
+		}
+	}
+#endif // PLATFORM_LINUX
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <thread>
+
+namespace Ainan {
+
+	//how often the folder is scanned again on platforms where changes aren't watched
+	const std::chrono::milliseconds c_AssetIndexRescanInterval(2000);
+	//changes arriving within this time of each other are published together
+	const std::chrono::milliseconds c_AssetIndexBatchDelay(50);
+
+	struct AssetIndexEntry
+	{
+		std::filesystem::path Path;
+		std::string Name;
+		bool IsDirectory = false;
+	};
+
+	//list of every file and folder inside a folder, built on a background thread and kept up to date with inotify on linux
+	//(and by scanning again periodically everywhere else), so the gui can query it every frame without touching the disk,
+	//queries return shared immutable lists that are swapped out when something changes,
+	//files that are written to after the first scan are also collected so they can be reloaded
+	class AssetIndex
+	{
+	public:
+		//extraTextures are listed with the textures found on disk, used for textures inside a mounted pack
+		AssetIndex(const std::filesystem::path& root, const std::vector<std::filesystem::path>& extraTextures = {});
+		~AssetIndex();
+
+		AssetIndex(const AssetIndex&) = delete;
+		AssetIndex& operator=(const AssetIndex&) = delete;
+
+		//false until the first scan is done, the lists are empty until then
+		bool IsReady() const;
+		//sorted by name, nullptr if the directory isn't inside the root or doesn't exist
+		std::shared_ptr<const std::vector<AssetIndexEntry>> GetDirectory(const std::filesystem::path& directory) const;
+		//every jpg, jpeg, bmp and png inside the root, sorted by path
+		std::shared_ptr<const std::vector<std::filesystem::path>> GetTextures() const;
+
+		//files that were written, created or moved in since the last call, each listed once
+		std::vector<std::filesystem::path> TakeChangedFiles();
+
+		static bool IsTextureFile(const std::filesystem::path& path);
+
+	private:
+		struct Snapshot
+		{
+			std::unordered_map<std::string, std::shared_ptr<const std::vector<AssetIndexEntry>>> Directories;
+			std::shared_ptr<const std::vector<std::filesystem::path>> Textures;
+			bool Ready = false;
+		};
+
+		static std::string GetKey(const std::filesystem::path& path);
+
+		void IndexThreadLoop();
+		//everything below is only touched by the index thread
+		void Rescan();
+		void ScanDirectory(const std::filesystem::path& directory);
+		void RemoveDirectory(const std::string& key);
+		void AddEntry(const std::filesystem::path& directory, const std::string& name, bool isDirectory);
+		void RemoveEntry(const std::filesystem::path& directory, const std::string& name);
+		void Publish();
+		void AddChangedFile(const std::filesystem::path& path);
+#ifdef PLATFORM_LINUX
+		void WatchDirectory(const std::filesystem::path& directory);
+		void ReadEvents();
+#endif // PLATFORM_LINUX
+
+	private:
+		std::filesystem::path m_Root;
+		std::vector<std::filesystem::path> m_ExtraTextures;
+
+		std::thread m_IndexThread;
+		std::atomic<bool> m_Stop = false;
+
+		mutable std::mutex m_SnapshotMutex;
+		std::shared_ptr<const Snapshot> m_Snapshot;
+
+		std::mutex m_ChangesMutex;
+		std::set<std::string> m_ChangedFiles;
+
+		//directory key -> entry name -> is directory
+		std::unordered_map<std::string, std::map<std::string, bool>> m_Directories;
+		std::set<std::string> m_Textures;
+		std::set<std::string> m_DirtyDirectories;
+		bool m_TexturesDirty = false;
+		//file -> last write time, only kept when changes are found by scanning again
+		std::unordered_map<std::string, int64_t> m_WriteTimes;
+		bool m_TrackWriteTimes = true;
+#ifdef PLATFORM_LINUX
+		int m_InotifyFd = -1;
+		std::unordered_map<int, std::filesystem::path> m_Watches;
+#endif // PLATFORM_LINUX
+	};
+}
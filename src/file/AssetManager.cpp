@@ -4,11 +4,54 @@ namespace Ainan
 {
 	std::filesystem::path AssetManager::s_EnvironmentDirectory = "";
 	std::filesystem::path AssetManager::s_CurrentDirectory = "";
+	std::unique_ptr<AssetIndex> AssetManager::s_Index = nullptr;
+	std::mutex AssetManager::s_PackMutex;
+	std::shared_ptr<AssetPack> AssetManager::s_Pack = nullptr;
+	std::string AssetManager::s_PackRoot = "";
 
 	void AssetManager::Init(const std::filesystem::path& environmentDirectory)
+	{
+		Init(environmentDirectory, nullptr);
+	}
+
+	bool AssetManager::MountPack(const std::filesystem::path& packPath)
+	{
+		std::shared_ptr<AssetPack> pack = AssetPack::Open(packPath);
+		Init(packPath.parent_path(), pack);
+		return pack != nullptr;
+	}
+
+	void AssetManager::Init(const std::filesystem::path& environmentDirectory, const std::shared_ptr<AssetPack>& pack)
 	{
 		s_EnvironmentDirectory = environmentDirectory;
 		s_CurrentDirectory = environmentDirectory;
+
+		//textures inside the pack show up as if they were in the environment folder
+		std::vector<std::filesystem::path> packTextures;
+		if (pack)
+			for (const std::string& entryPath : pack->GetEntryPaths())
+				if (AssetIndex::IsTextureFile(std::filesystem::u8path(entryPath)))
+					packTextures.push_back(environmentDirectory / std::filesystem::u8path(entryPath));
+
+		//the old index is stopped before the new one starts
+		s_Index = nullptr;
+		s_Index = std::make_unique<AssetIndex>(environmentDirectory, packTextures);
+
+		std::lock_guard lock(s_PackMutex);
+		s_Pack = pack;
+		s_PackRoot = "";
+		if (pack)
+		{
+			s_PackRoot = AssetPack::NormalizePath(std::filesystem::absolute(s_EnvironmentDirectory).u8string());
+			if (s_PackRoot.back() != '/')
+				s_PackRoot += '/';
+		}
+	}
+
+	bool AssetManager::IsPackMounted()
+	{
+		std::lock_guard lock(s_PackMutex);
+		return s_Pack != nullptr;
 	}
 
 	void AssetManager::Terminate()
@@ -17,6 +60,19 @@ namespace Ainan
 		assert(s_EnvironmentDirectory != "");
 
 		s_EnvironmentDirectory = "";
+		s_Index = nullptr;
+
+		std::lock_guard lock(s_PackMutex);
+		s_Pack = nullptr;
+		s_PackRoot = "";
+	}
+
+	std::vector<std::filesystem::path> AssetManager::TakeChangedFiles()
+	{
+		if (!s_Index)
+			return {};
+
+		return s_Index->TakeChangedFiles();
 	}
 
 	void AssetManager::DisplayGUI()
@@ -32,19 +88,22 @@ namespace Ainan
 					s_CurrentDirectory = s_CurrentDirectory.parent_path();
 				}
 
-			for (const auto& entry : std::filesystem::directory_iterator(s_CurrentDirectory))
+			auto entries = s_Index ? s_Index->GetDirectory(s_CurrentDirectory) : nullptr;
+			if (entries)
 			{
-				if (entry.status().type() == std::filesystem::file_type::directory)
+				for (const AssetIndexEntry& entry : *entries)
 				{
-					if (ImGui::Button(entry.path().filename().u8string().c_str()))
+					if (entry.IsDirectory)
 					{
-						s_CurrentDirectory += "\\";
-						s_CurrentDirectory += entry.path().filename();
+						if (ImGui::Button(entry.Name.c_str()))
+							s_CurrentDirectory = entry.Path;
 					}
+					else
+						ImGui::Text(entry.Name.c_str());
 				}
-				else
-					ImGui::Text(entry.path().filename().u8string().c_str());
 			}
+			else if (s_Index && !s_Index->IsReady())
+				ImGui::Text("Indexing...");
 
 			ImGui::ListBoxFooter();
 		}
@@ -52,38 +111,46 @@ namespace Ainan
 		ImGui::End();
 	}
 
-	std::vector<std::filesystem::path> AssetManager::GetAll2DTextures()
+	std::shared_ptr<const std::vector<std::filesystem::path>> AssetManager::GetAll2DTextures()
 	{
-		std::vector<std::filesystem::path> result;
-		for (const auto& entry : std::filesystem::recursive_directory_iterator(s_EnvironmentDirectory)) 
+		std::shared_ptr<const std::vector<std::filesystem::path>> textures = s_Index ? s_Index->GetTextures() : nullptr;
+		if (!textures)
 		{
-			//check if the files format contains any of the supported image formats(jpg, bmp and png)
-			if(entry.path().filename().u8string().find(".jpg") != std::string::npos ||
-				entry.path().filename().u8string().find(".jpeg") != std::string::npos ||
-				entry.path().filename().u8string().find(".bmp") != std::string::npos ||
-				entry.path().filename().u8string().find(".png") != std::string::npos)
-				result.push_back(entry.path());
+			static const auto empty = std::make_shared<const std::vector<std::filesystem::path>>();
+			return empty;
 		}
 
-		return result;
+		return textures;
 	}
 
 	std::string AssetManager::ReadEntireTextFile(const std::string& path)
 	{
-		std::string file_content;
-
-		FILE* file = fopen(path.c_str(), "r");
-
-		fseek(file, 0, SEEK_END);
-		int content_length = ftell(file);
-		file_content.resize(content_length + 1);
-		fseek(file, 0, SEEK_SET);
+		MappedFile file = MapFile(path);
+		return std::string(file.GetText());
+	}
 
-		fread((void*)file_content.data(), sizeof(char), content_length, file);
+	MappedFile AssetManager::MapFile(const std::filesystem::path& path)
+	{
+		std::shared_ptr<AssetPack> pack;
+		std::string packRoot;
+		{
+			std::lock_guard lock(s_PackMutex);
+			pack = s_Pack;
+			packRoot = s_PackRoot;
+		}
 
-		fclose(file);
+		if (pack)
+		{
+			std::string normalizedPath = AssetPack::NormalizePath(std::filesystem::absolute(path).u8string());
+			if (normalizedPath.compare(0, packRoot.size(), packRoot) == 0)
+			{
+				MappedFile view = pack->Map(normalizedPath.substr(packRoot.size()));
+				if (view.IsValid())
+					return view;
+			}
+		}
 
-		return file_content;
+		return MappedFile(path);
 	}
 
 	void BrowserWindowSizeCallback(ImGuiSizeCallbackData* data)
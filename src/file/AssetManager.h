@@ -1,5 +1,9 @@
 #pragma once
 
+#include "file/MappedFile.h"
+#include "file/AssetPack.h"
+#include "file/AssetIndex.h"
+
 #define BROWSER_LIST_BOX_HEIGHT    15
 #define BROWSER_WINDOW_WIDTH   400
 #define BROWSER_MIN_WINDOW_HEIGHT  350
@@ -10,12 +14,31 @@ namespace Ainan {
 	{
 	public:
 		static void Init(const std::filesystem::path& environmentDirectory);
+		//inits the asset manager in the folder of the pack and serves files from the pack before looking on disk,
+		//returns false if the pack is invalid, the pack is unmounted by the next Init or Terminate
+		static bool MountPack(const std::filesystem::path& packPath);
+		static bool IsPackMounted();
 		static void Terminate();
 
 		static void DisplayGUI();
 
-		static std::vector<std::filesystem::path> GetAll2DTextures();
+		//from the asset index so it is cheap to call every frame, empty while the environment folder is first scanned
+		static std::shared_ptr<const std::vector<std::filesystem::path>> GetAll2DTextures();
+		//files in the environment folder that changed on disk since the last call
+		static std::vector<std::filesystem::path> TakeChangedFiles();
 		static std::string ReadEntireTextFile(const std::string& path);
+		//read only view of the whole file that stays valid as long as the returned object is alive,
+		//invalid if the file can't be opened or is empty, safe to call from any thread
+		static MappedFile MapFile(const std::filesystem::path& path);
+	private:
+		static void Init(const std::filesystem::path& environmentDirectory, const std::shared_ptr<AssetPack>& pack);
+
+	private:
+		static std::unique_ptr<AssetIndex> s_Index;
+		static std::mutex s_PackMutex;
+		static std::shared_ptr<AssetPack> s_Pack;
+		//normalized environment directory with a trailing slash, paths inside it are looked up in the pack
+		static std::string s_PackRoot;
 	public:
 		//this a path to the environment directory
 		static std::filesystem::path s_EnvironmentDirectory;
@@ -0,0 +1,198 @@
+#include "AssetPack.h"
+
+namespace Ainan {
+
+	const uint64_t c_AssetPackAlignment = 16;
+
+	std::shared_ptr<AssetPack> AssetPack::Open(const std::filesystem::path& path)
+	{
+		auto file = std::make_shared<MappedFile>(path);
+		if (!file->IsValid() || file->GetSize() < sizeof(AssetPackHeader))
+			return nullptr;
+
+		const AssetPackHeader* header = (const AssetPackHeader*)file->GetData();
+		if (memcmp(header->Magic, c_AssetPackMagic, sizeof(c_AssetPackMagic)) != 0 || header->Version > c_AssetPackVersion)
+			return nullptr;
+
+		uint64_t size = file->GetSize();
+		if (header->IndexOffset > size || (uint64_t)header->EntryCount * sizeof(AssetPackEntry) > size - header->IndexOffset ||
+			header->PathsOffset > size || header->PathsSize > size - header->PathsOffset || header->IndexOffset % 8 != 0)
+			return nullptr;
+
+		std::shared_ptr<AssetPack> pack(new AssetPack());
+		pack->m_Entries = (const AssetPackEntry*)(file->GetData() + header->IndexOffset);
+		pack->m_EntryCount = header->EntryCount;
+		pack->m_Paths = (const char*)(file->GetData() + header->PathsOffset);
+
+		//check everything once so lookups don't have to
+		for (uint32_t i = 0; i < pack->m_EntryCount; i++)
+		{
+			const AssetPackEntry& entry = pack->m_Entries[i];
+			if (entry.DataOffset > size || entry.DataSize > size - entry.DataOffset ||
+				(uint64_t)entry.PathOffset + entry.PathLength > header->PathsSize ||
+				(i > 0 && pack->m_Entries[i - 1].PathHash > entry.PathHash))
+				return nullptr;
+		}
+
+		pack->m_File = file;
+		return pack;
+	}
+
+	std::string AssetPack::NormalizePath(const std::string& path)
+	{
+		std::string result = path;
+		std::replace(result.begin(), result.end(), '\\', '/');
+		result = std::filesystem::u8path(result).lexically_normal().generic_u8string();
+
+		if (result.size() > 2 && result[0] == '.' && result[1] == '/')
+			result.erase(0, 2);
+		return result;
+	}
+
+	//FNV-1a
+	uint64_t AssetPack::GetPathHash(const std::string& normalizedPath)
+	{
+		uint64_t hash = 0xcbf29ce484222325;
+		for (char c : normalizedPath)
+		{
+			hash ^= (uint8_t)c;
+			hash *= 0x100000001b3;
+		}
+		return hash;
+	}
+
+	MappedFile AssetPack::Map(const std::string& path) const
+	{
+		const AssetPackEntry* entry = Find(NormalizePath(path));
+		if (!entry)
+			return MappedFile();
+
+		return MappedFile::CreateSubView(m_File, entry->DataOffset, entry->DataSize);
+	}
+
+	bool AssetPack::Contains(const std::string& path) const
+	{
+		return Find(NormalizePath(path)) != nullptr;
+	}
+
+	std::vector<std::string> AssetPack::GetEntryPaths() const
+	{
+		std::vector<std::string> result;
+		result.reserve(m_EntryCount);
+		for (uint32_t i = 0; i < m_EntryCount; i++)
+			result.push_back(std::string(m_Paths + m_Entries[i].PathOffset, m_Entries[i].PathLength));
+		return result;
+	}
+
+	const AssetPackEntry* AssetPack::Find(const std::string& normalizedPath) const
+	{
+		uint64_t hash = GetPathHash(normalizedPath);
+		const AssetPackEntry* end = m_Entries + m_EntryCount;
+		const AssetPackEntry* entry = std::lower_bound(m_Entries, end, hash,
+			[](const AssetPackEntry& entry, uint64_t hash) { return entry.PathHash < hash; });
+
+		//paths are compared too in case two of them have the same hash
+		for (; entry != end && entry->PathHash == hash; entry++)
+			if (normalizedPath.compare(0, std::string::npos, m_Paths + entry->PathOffset, entry->PathLength) == 0)
+				return entry;
+
+		return nullptr;
+	}
+
+	AssetPackWriter::~AssetPackWriter()
+	{
+		if (m_File)
+			fclose(m_File);
+	}
+
+	bool AssetPackWriter::Open(const std::filesystem::path& path)
+	{
+		m_File = fopen(path.u8string().c_str(), "wb");
+		if (!m_File)
+			return false;
+
+		//the header is written again with the real offsets when the pack is closed
+		AssetPackHeader header = {};
+		m_Failed = fwrite(&header, sizeof(AssetPackHeader), 1, m_File) != 1;
+		m_Offset = sizeof(AssetPackHeader);
+		return !m_Failed;
+	}
+
+	bool AssetPackWriter::AddEntry(const std::string& path, const uint8_t* data, size_t size)
+	{
+		assert(m_File);
+
+		std::string normalizedPath = AssetPack::NormalizePath(path);
+		if (!m_AddedPaths.insert(normalizedPath).second)
+			return true;
+
+		if (!WritePadding())
+			return false;
+
+		m_Entries.push_back({ normalizedPath, m_Offset, size });
+		if (size > 0 && fwrite(data, 1, size, m_File) != size)
+			m_Failed = true;
+		m_Offset += size;
+
+		return !m_Failed;
+	}
+
+	bool AssetPackWriter::Close()
+	{
+		assert(m_File);
+
+		std::sort(m_Entries.begin(), m_Entries.end(), [](const PendingEntry& a, const PendingEntry& b)
+			{
+				return AssetPack::GetPathHash(a.Path) < AssetPack::GetPathHash(b.Path);
+			});
+
+		std::vector<AssetPackEntry> index;
+		std::string paths;
+		for (auto& pending : m_Entries)
+		{
+			AssetPackEntry entry;
+			entry.PathHash = AssetPack::GetPathHash(pending.Path);
+			entry.DataOffset = pending.DataOffset;
+			entry.DataSize = pending.DataSize;
+			entry.PathOffset = (uint32_t)paths.size();
+			entry.PathLength = (uint32_t)pending.Path.size();
+			index.push_back(entry);
+			paths += pending.Path;
+		}
+
+		AssetPackHeader header = {};
+		memcpy(header.Magic, c_AssetPackMagic, sizeof(header.Magic));
+		header.Version = c_AssetPackVersion;
+		header.EntryCount = (uint32_t)index.size();
+
+		WritePadding();
+		header.IndexOffset = m_Offset;
+		if (index.size() > 0 && fwrite(index.data(), sizeof(AssetPackEntry), index.size(), m_File) != index.size())
+			m_Failed = true;
+		m_Offset += index.size() * sizeof(AssetPackEntry);
+
+		header.PathsOffset = m_Offset;
+		header.PathsSize = paths.size();
+		if (paths.size() > 0 && fwrite(paths.data(), 1, paths.size(), m_File) != paths.size())
+			m_Failed = true;
+
+		if (fseek(m_File, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(AssetPackHeader), 1, m_File) != 1)
+			m_Failed = true;
+
+		if (fclose(m_File) != 0)
+			m_Failed = true;
+		m_File = nullptr;
+
+		return !m_Failed;
+	}
+
+	bool AssetPackWriter::WritePadding()
+	{
+		const uint8_t zeros[c_AssetPackAlignment] = {};
+		uint64_t padding = (c_AssetPackAlignment - m_Offset % c_AssetPackAlignment) % c_AssetPackAlignment;
+		if (padding > 0 && fwrite(zeros, 1, padding, m_File) != padding)
+			m_Failed = true;
+		m_Offset += padding;
+		return !m_Failed;
+	}
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "file/MappedFile.h"
+
+#include <unordered_set>
+
+namespace Ainan {
+
+	const char c_AssetPackMagic[8] = { 'A', 'I', 'N', 'A', 'N', 'P', 'A', 'K' };
+	//bump when the layout changes
+	const uint32_t c_AssetPackVersion = 1;
+	const char* const c_AssetPackExtension = ".ainpak";
+	//the environment itself is stored in the binary format under this name
+	const char* const c_AssetPackEnvironmentEntry = "environment.env";
+
+	//a pack is the header, then the data of every entry aligned to 16 bytes, then the index sorted by path hash,
+	//then the paths of the entries, all offsets are from the start of the file
+	struct AssetPackHeader
+	{
+		char Magic[8];
+		uint32_t Version;
+		uint32_t EntryCount;
+		uint64_t IndexOffset;
+		uint64_t PathsOffset;
+		uint64_t PathsSize;
+	};
+	static_assert(sizeof(AssetPackHeader) == 40);
+
+	struct AssetPackEntry
+	{
+		uint64_t PathHash;
+		uint64_t DataOffset;
+		uint64_t DataSize;
+		uint32_t PathOffset;
+		uint32_t PathLength;
+	};
+	static_assert(sizeof(AssetPackEntry) == 32);
+
+	//read only archive of files mapped in one go, entries are looked up by their path relative to the environment folder
+	class AssetPack
+	{
+	public:
+		//returns nullptr if the file is missing or isn't a valid pack
+		static std::shared_ptr<AssetPack> Open(const std::filesystem::path& path);
+
+		//forward slashes, no "." or ".." parts, so the same file always gets the same key
+		static std::string NormalizePath(const std::string& path);
+		static uint64_t GetPathHash(const std::string& normalizedPath);
+
+		//the view keeps the pack mapped, invalid if there is no such entry
+		MappedFile Map(const std::string& path) const;
+		bool Contains(const std::string& path) const;
+		std::vector<std::string> GetEntryPaths() const;
+
+	private:
+		AssetPack() = default;
+		const AssetPackEntry* Find(const std::string& path) const;
+
+	private:
+		std::shared_ptr<const MappedFile> m_File;
+		const AssetPackEntry* m_Entries = nullptr;
+		uint32_t m_EntryCount = 0;
+		const char* m_Paths = nullptr;
+	};
+
+	//writes the data of entries as they are added so whole packs are never held in memory
+	class AssetPackWriter
+	{
+	public:
+		~AssetPackWriter();
+
+		bool Open(const std::filesystem::path& path);
+		//entries added twice are only stored the first time
+		bool AddEntry(const std::string& path, const uint8_t* data, size_t size);
+		//writes the index and closes the file
+		bool Close();
+
+	private:
+		struct PendingEntry
+		{
+			std::string Path;
+			uint64_t DataOffset;
+			uint64_t DataSize;
+		};
+
+		bool WritePadding();
+
+	private:
+		FILE* m_File = nullptr;
+		uint64_t m_Offset = 0;
+		std::vector<PendingEntry> m_Entries;
+		std::unordered_set<std::string> m_AddedPaths;
+		bool m_Failed = false;
+	};
+}
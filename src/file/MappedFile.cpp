@@ -0,0 +1,139 @@
+#include "MappedFile.h"
+
+#ifdef PLATFORM_WINDOWS
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // PLATFORM_WINDOWS
+
+namespace Ainan {
+
+	MappedFile::MappedFile(const std::filesystem::path& path)
+	{
+#ifdef PLATFORM_WINDOWS
+		HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return;
+		}
+
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping)
+		{
+			CloseHandle(file);
+			return;
+		}
+
+		void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!data)
+		{
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return;
+		}
+
+		m_FileHandle = file;
+		m_MappingHandle = mapping;
+		m_Data = (const uint8_t*)data;
+		m_Size = (size_t)size.QuadPart;
+#else
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return;
+
+		struct stat info;
+		if (fstat(fd, &info) != 0 || info.st_size == 0)
+		{
+			close(fd);
+			return;
+		}
+
+		void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		//the mapping stays valid after the descriptor is closed
+		close(fd);
+		if (data == MAP_FAILED)
+			return;
+
+		m_Data = (const uint8_t*)data;
+		m_Size = (size_t)info.st_size;
+#endif // PLATFORM_WINDOWS
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Unmap();
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+	{
+		*this = std::move(other);
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this == &other)
+			return *this;
+
+		Unmap();
+		m_Data = other.m_Data;
+		m_Size = other.m_Size;
+		m_Parent = std::move(other.m_Parent);
+		other.m_Data = nullptr;
+		other.m_Size = 0;
+#ifdef PLATFORM_WINDOWS
+		m_FileHandle = other.m_FileHandle;
+		m_MappingHandle = other.m_MappingHandle;
+		other.m_FileHandle = nullptr;
+		other.m_MappingHandle = nullptr;
+#endif // PLATFORM_WINDOWS
+		return *this;
+	}
+
+	MappedFile MappedFile::CreateSubView(const std::shared_ptr<const MappedFile>& file, size_t offset, size_t size)
+	{
+		MappedFile view;
+		if (!file || !file->IsValid() || size == 0 || offset > file->GetSize() || size > file->GetSize() - offset)
+			return view;
+
+		view.m_Data = file->GetData() + offset;
+		view.m_Size = size;
+		view.m_Parent = file;
+		return view;
+	}
+
+	void MappedFile::Unmap()
+	{
+		if (!m_Data)
+			return;
+
+		//views don't own their memory, the parent is unmapped when its last view is gone
+		if (m_Parent)
+		{
+			m_Parent.reset();
+			m_Data = nullptr;
+			m_Size = 0;
+			return;
+		}
+
+#ifdef PLATFORM_WINDOWS
+		UnmapViewOfFile(m_Data);
+		CloseHandle(m_MappingHandle);
+		CloseHandle(m_FileHandle);
+		m_FileHandle = nullptr;
+		m_MappingHandle = nullptr;
+#else
+		munmap((void*)m_Data, m_Size);
+#endif // PLATFORM_WINDOWS
+
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+}
\ No newline at end of file
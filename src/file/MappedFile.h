@@ -0,0 +1,40 @@
+#pragma once
+
+namespace Ainan {
+
+	//read only memory mapping of a whole file, unmapped when destroyed,
+	//it can also be a view into part of another mapping which it keeps alive
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		MappedFile(const std::filesystem::path& path);
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		//invalid if the range is outside of the file
+		static MappedFile CreateSubView(const std::shared_ptr<const MappedFile>& file, size_t offset, size_t size);
+
+		//false if the file couldn't be opened or mapped, empty files are never mapped
+		bool IsValid() const { return m_Data != nullptr; }
+		const uint8_t* GetData() const { return m_Data; }
+		size_t GetSize() const { return m_Size; }
+		std::string_view GetText() const { return std::string_view((const char*)m_Data, m_Size); }
+
+	private:
+		void Unmap();
+
+	private:
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+		std::shared_ptr<const MappedFile> m_Parent;
+#ifdef PLATFORM_WINDOWS
+		void* m_FileHandle = nullptr;
+		void* m_MappingHandle = nullptr;
+#endif // PLATFORM_WINDOWS
+	};
+}
\ No newline at end of file
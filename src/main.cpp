@@ -1,9 +1,10 @@
 #include "editor/Window.h"
 #include "editor/Editor.h"
 #include "editor/EditorPreferences.h"
+#include "editor/HeadlessExport.h"
 #include "renderer/Renderer.h"
 
-int main() 
+int main(int argc, char* argv[]) 
 {
 	using namespace Ainan;
 
@@ -11,6 +12,10 @@ int main()
 	InitAinanLogger();;
 #endif // !NDEBUG
 
+	//render an environment to an image without opening a window
+	if (IsHeadlessExportCommand(argc, argv))
+		return RunHeadlessExport(argc, argv);
+
 	auto api = EditorPreferences::LoadFromDefaultPath().RenderingBackend;
 
 	Window::Init(api);
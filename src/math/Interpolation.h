@@ -34,6 +34,14 @@ namespace Ainan {
 
 	namespace Interpolation {
 
+		//declared before Interporpolate so they are found instead of the InterpolationType values with the same names
+		template<typename type>
+		type Linear(const type& start, const type& end, float t);
+		template<typename type>
+		type Cubic(const type& start, const type& end, float t);
+		template<typename type>
+		type Smoothstep(const type& start, const type& end, float t);
+
 		template<typename type>
 		type Interporpolate(InterpolationType interpolationType, const type& start, const type& end, float t)
 		{
@@ -26,5 +26,9 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#ifdef PLATFORM_WINDOWS
 #define STARTING_BROWSER_DIRECTORY "C:\\"
+#else
+#define STARTING_BROWSER_DIRECTORY "/"
+#endif // PLATFORM_WINDOWS
 #define PI 3.14159f
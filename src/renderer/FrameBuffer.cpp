@@ -0,0 +1,85 @@
+#include "FrameBuffer.h"
+#include "Renderer.h"
+
+namespace Ainan {
+
+	std::future<Image> FrameBuffer::ReadPixelsAsync()
+	{
+		auto promise = std::make_shared<std::promise<Image>>();
+		std::future<Image> future = promise->get_future();
+
+		//the size is read on the renderer thread because that is where Resize changes it
+		auto func = [this, promise]()
+		{
+			glm::vec2 size = GetSize();
+			auto image = std::make_shared<Image>();
+			image->m_Width = (int32_t)size.x;
+			image->m_Height = (int32_t)size.y;
+			image->m_Data = new uint8_t[(size_t)image->m_Width * image->m_Height * 4];
+			image->Format = TextureFormat::RGBA;
+
+			ReadbackRequest request;
+			request.Target = image->m_Data;
+			request.Width = image->m_Width;
+			request.Height = image->m_Height;
+			request.OnComplete = [image, promise](bool succeeded)
+			{
+				if (succeeded)
+					promise->set_value(std::move(*image));
+				else
+					promise->set_value(Image());
+			};
+			ReadPixelsAsyncUnsafe(request);
+		};
+
+		if (!Renderer::PushCommand(func))
+			promise->set_value(Image());
+
+		return future;
+	}
+
+	std::future<bool> FrameBuffer::ReadPixelsAsync(uint8_t* target, const glm::ivec2& size, const glm::ivec2& origin)
+	{
+		auto promise = std::make_shared<std::promise<bool>>();
+		std::future<bool> future = promise->get_future();
+
+		auto func = [this, target, size, origin, promise]()
+		{
+			//target is only big enough for size, so the whole rectangle has to be inside the framebuffer
+			glm::ivec2 currentSize = glm::ivec2(GetSize());
+			if (origin.x < 0 || origin.y < 0 || size.x <= 0 || size.y <= 0 ||
+				origin.x + size.x > currentSize.x || origin.y + size.y > currentSize.y)
+			{
+				AINAN_LOG_ERROR("Framebuffer readback rectangle isn't inside the framebuffer");
+				promise->set_value(false);
+				return;
+			}
+
+			ReadbackRequest request;
+			request.Target = target;
+			request.X = origin.x;
+			request.Y = origin.y;
+			request.Width = size.x;
+			request.Height = size.y;
+			request.OnComplete = [promise](bool succeeded)
+			{
+				promise->set_value(succeeded);
+			};
+			ReadPixelsAsyncUnsafe(request);
+		};
+
+		if (!Renderer::PushCommand(func))
+			promise->set_value(false);
+
+		return future;
+	}
+
+	void FrameBuffer::FlushReadbacks()
+	{
+		auto func = [this]()
+		{
+			FlushReadbacksUnsafe();
+		};
+		Renderer::PushCommand(func, true);
+	}
+}
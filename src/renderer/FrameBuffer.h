@@ -2,10 +2,29 @@
 
 #include "Image.h"
 
+#include <future>
+
 namespace Ainan {
 
 	class Texture;
 
+	//how many async readbacks can be in flight at once, when more are requested the oldest one is waited for
+	//so the pixels of frame N are available when frame N + c_ReadbackRingSize is requested
+	const uint32_t c_ReadbackRingSize = 3;
+
+	//a ReadPixelsAsync call, the Width x Height rectangle starting at the X, Y pixel (from the bottom left) is written as RGBA
+	//to Target (rows bottom to top like ReadPixels) and then OnComplete is called, with false if the pixels couldn't be read
+	//and Target wasn't written. the rectangle is always inside the framebuffer when the request reaches the backend
+	struct ReadbackRequest
+	{
+		uint8_t* Target = nullptr;
+		int32_t X = 0;
+		int32_t Y = 0;
+		int32_t Width = 0;
+		int32_t Height = 0;
+		std::function<void(bool succeeded)> OnComplete;
+	};
+
 	class FrameBuffer
 	{
 	public:
@@ -22,11 +41,26 @@ namespace Ainan {
 		//will read the entire framebuffer if no arguments are specified
 		virtual Image ReadPixels(glm::vec2 bottomLeftPixel = { 0,0 }, glm::vec2 topRightPixel = { 0,0 }) = 0;
 
+		//reads the entire framebuffer without waiting for the renderer or the gpu, the size is the one the framebuffer has
+		//when the renderer thread gets to the request (after any queued Resize). the future is ready once the copy finishes
+		//which can take up to c_ReadbackRingSize more readbacks, call FlushReadbacks after the last one so the ones still
+		//in flight complete. the image has no data if the readback failed (for example because the window is minimized
+		//and the renderer is dropping commands)
+		std::future<Image> ReadPixelsAsync();
+		//same but reads the size rectangle starting at origin (the bottom left pixel) into target instead of allocating an image,
+		//target must hold size.x * size.y * 4 bytes and stay valid until the future is ready. the future is false and target
+		//is untouched if the readback failed or the rectangle isn't inside the framebuffer by the time the renderer thread reads it
+		std::future<bool> ReadPixelsAsync(uint8_t* target, const glm::ivec2& size, const glm::ivec2& origin = { 0, 0 });
+		//not dropped while the window is minimized so pending readbacks always complete
+		void FlushReadbacks();
+
 		virtual void Bind() const = 0;
 
 	private:
 		virtual void BindUnsafe() const = 0;
 		virtual void ResizeUnsafe(const glm::vec2& newSize) = 0;
+		virtual void ReadPixelsAsyncUnsafe(ReadbackRequest request) = 0;
+		virtual void FlushReadbacksUnsafe() = 0;
 
 		friend class Renderer;
 	};
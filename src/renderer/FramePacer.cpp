@@ -0,0 +1,104 @@
+#include "FramePacer.h"
+
+namespace Ainan {
+
+	void FramePacer::SetMode(FramePacingMode mode, int32_t targetFramerate)
+	{
+		m_Mode = mode;
+		m_TargetFramerate = std::clamp(targetFramerate, c_MinTargetFramerate, c_MaxTargetFramerate);
+		m_Deadline = Clock::now();
+	}
+
+	double FramePacer::WaitForNextFrame()
+	{
+		if (m_Mode == FramePacingMode::Limited)
+		{
+			auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_TargetFramerate));
+
+			//schedule from the previous deadline and not from now so the error doesn't accumulate,
+			//unless we fell behind by a whole frame, then there is no point in trying to catch up
+			m_Deadline += period;
+			auto now = Clock::now();
+			if (now > m_Deadline + period)
+				m_Deadline = now;
+
+			auto sleepUntil = m_Deadline - std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(c_SpinMargin + m_SleepOvershoot));
+			if (now < sleepUntil)
+			{
+				std::this_thread::sleep_until(sleepUntil);
+
+				//keep track of how late the os wakes us up
+				double overshoot = std::chrono::duration<double>(Clock::now() - sleepUntil).count();
+				m_SleepOvershoot = std::max(m_SleepOvershoot * 0.9, overshoot);
+			}
+
+			while (Clock::now() < m_Deadline)
+				std::this_thread::yield();
+		}
+
+		auto frameStart = Clock::now();
+		double deltaTime = std::chrono::duration<double>(frameStart - m_LastFrameStart).count();
+		m_LastFrameStart = frameStart;
+
+		m_FrameTimes[m_FrameTimeIndex] = (float)(deltaTime * 1000.0);
+		m_FrameTimeIndex = (m_FrameTimeIndex + 1) % m_FrameTimes.size();
+		m_FrameTimeCount = std::min(m_FrameTimeCount + 1, m_FrameTimes.size());
+
+		return deltaTime;
+	}
+
+	FrameTimePercentiles FramePacer::GetFrameTimePercentiles() const
+	{
+		FrameTimePercentiles percentiles;
+		if (m_FrameTimeCount == 0)
+			return percentiles;
+
+		std::array<float, c_FrameTimeHistorySize> sorted = m_FrameTimes;
+		std::sort(sorted.begin(), sorted.begin() + m_FrameTimeCount);
+
+		auto percentile = [&](double p)
+		{
+			size_t index = (size_t)std::ceil(p * m_FrameTimeCount) - 1;
+			return (double)sorted[std::min(index, m_FrameTimeCount - 1)];
+		};
+
+		percentiles.P50 = percentile(0.50);
+		percentiles.P95 = percentile(0.95);
+		percentiles.P99 = percentile(0.99);
+		return percentiles;
+	}
+
+	std::string FramePacingModeStr(FramePacingMode mode)
+	{
+		switch (mode)
+		{
+		case FramePacingMode::Limited:
+			return "Limited";
+
+		case FramePacingMode::VSync:
+			return "VSync";
+
+		case FramePacingMode::Uncapped:
+			return "Uncapped";
+
+		default:
+			assert(false);
+			return "";
+		}
+	}
+
+	FramePacingMode FramePacingModeVal(const std::string& name)
+	{
+		if (name == "Limited")
+			return FramePacingMode::Limited;
+
+		if (name == "VSync")
+			return FramePacingMode::VSync;
+
+		if (name == "Uncapped")
+			return FramePacingMode::Uncapped;
+
+		assert(false);
+		return FramePacingMode::Limited;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+namespace Ainan {
+
+	const int32_t c_DefaultTargetFramerate = 60;
+	const int32_t c_MinTargetFramerate = 10;
+	const int32_t c_MaxTargetFramerate = 500;
+
+	enum class FramePacingMode
+	{
+		//sleep then spin until the target framerate's deadline
+		Limited,
+		//let the swapchain wait for the display's vertical sync
+		VSync,
+		//no waiting at all, used for benchmarking
+		Uncapped
+	};
+
+	std::string FramePacingModeStr(FramePacingMode mode);
+	FramePacingMode FramePacingModeVal(const std::string& name);
+
+	//in milliseconds
+	struct FrameTimePercentiles
+	{
+		double P50 = 0.0;
+		double P95 = 0.0;
+		double P99 = 0.0;
+	};
+
+	//decides when the next frame starts, sleeping instead of busy waiting for most of the frame
+	class FramePacer
+	{
+	public:
+		void SetMode(FramePacingMode mode, int32_t targetFramerate);
+		FramePacingMode GetMode() const { return m_Mode; }
+		int32_t GetTargetFramerate() const { return m_TargetFramerate; }
+
+		//blocks until the next frame should start and returns the time since the previous frame started in seconds
+		double WaitForNextFrame();
+
+		//of the last c_FrameTimeHistorySize frames
+		FrameTimePercentiles GetFrameTimePercentiles() const;
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		//sleep this long before the deadline and spin for the rest, sleep is not precise enough to hit it exactly
+		static constexpr double c_SpinMargin = 0.001;
+		static constexpr size_t c_FrameTimeHistorySize = 240;
+
+		FramePacingMode m_Mode = FramePacingMode::Limited;
+		int32_t m_TargetFramerate = c_DefaultTargetFramerate;
+		Clock::time_point m_LastFrameStart = Clock::now();
+		Clock::time_point m_Deadline = Clock::now();
+		//how much longer than asked the os slept recently, added to the margin on platforms with coarse timers
+		double m_SleepOvershoot = 0.0;
+
+		std::array<float, c_FrameTimeHistorySize> m_FrameTimes = {};
+		size_t m_FrameTimeIndex = 0;
+		size_t m_FrameTimeCount = 0;
+	};
+}
\ No newline at end of file
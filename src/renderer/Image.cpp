@@ -1,58 +1,18 @@
 #include "Image.h"
-#include <thread>
+#include "ImageWriter.h"
+#include "file/AssetManager.h"
 
 namespace Ainan {
 
-	//this should not be called outside of this file
-	//this runs on a seperate thread to not block the program
-	//this will call delete[] on the dataCpy, so you should first copy the data to a seperate buffer with new then pass it here.
-	//that is to make sure we dont have threading problems
-	static void t_SaveToFile(std::string path, int width, int height, int comp, unsigned char* dataCpy, ImageFormat format)
-	{
-		stbi_flip_vertically_on_write(true);
-
-		switch (format)
-		{
-		case ImageFormat::png:
-			stbi_write_png(path.c_str(), width, height, comp, dataCpy, width * comp);
-			break;
-
-		case ImageFormat::jpeg:
-			stbi_write_jpg(path.c_str(), width, height, comp, dataCpy, 100);
-			break;
-
-		case ImageFormat::bmp:
-			stbi_write_bmp(path.c_str(), width, height, comp, dataCpy);
-			break;
-
-		default:
-			break;
-		}
-
-		delete[] dataCpy;
-	}
-
 	Image::~Image()
 	{
 		if (m_Data)
 			delete[] m_Data;
 	}
 
-	Image Image::LoadFromFile(const std::string& pathAndName, TextureFormat desiredFormat)
+	//sets the format of an image stb_image decoded into
+	static void SetDecodedFormat(Image& image, TextureFormat desiredFormat, int comp)
 	{
-		Image image;
-
-		int comp = 0;
-
-		stbi_set_flip_vertically_on_load(true);
-
-		if(desiredFormat == TextureFormat::RGBA)
-			image.m_Data = stbi_load(pathAndName.c_str(), &image.m_Width, &image.m_Height, &comp, 4);
-		else if(desiredFormat == TextureFormat::RGB)
-			image.m_Data = stbi_load(pathAndName.c_str(), &image.m_Width, &image.m_Height, &comp, 3);
-		else
-			image.m_Data = stbi_load(pathAndName.c_str(), &image.m_Width, &image.m_Height, &comp, 0);
-
 		if (desiredFormat != TextureFormat::Unspecified)
 			image.Format = desiredFormat;
 		else 
@@ -68,18 +28,69 @@ namespace Ainan {
 			else
 				assert(false);
 		}
+	}
+
+	static int GetDesiredComponents(TextureFormat desiredFormat)
+	{
+		if (desiredFormat == TextureFormat::RGBA)
+			return 4;
+		else if (desiredFormat == TextureFormat::RGB)
+			return 3;
+		else
+			return 0;
+	}
+
+	Image Image::LoadFromFile(const std::string& pathAndName, TextureFormat desiredFormat)
+	{
+		//let the caller handle missing or corrupt files
+		MappedFile file = AssetManager::MapFile(pathAndName);
+		if (!file.IsValid())
+			return Image();
+
+		return LoadFromMemory(file.GetData(), file.GetSize(), desiredFormat);
+	}
+
+	Image Image::LoadFromMemory(const uint8_t* data, size_t size, TextureFormat desiredFormat)
+	{
+		Image image;
+
+		int comp = 0;
+
+		//this is global in stb_image, but it is always set to the same value so it's fine when loading from multiple threads
+		stbi_set_flip_vertically_on_load(true);
+
+		image.m_Data = stbi_load_from_memory(data, (int)size, &image.m_Width, &image.m_Height, &comp, GetDesiredComponents(desiredFormat));
+
+		if (!image.m_Data)
+			return image;
+
+		SetDecodedFormat(image, desiredFormat, comp);
 
 		return image;
 	}
 
-	void Image::SaveToFile(const std::string& path, const ImageFormat& format)
+	std::future<bool> Image::SaveToFile(const std::string& path, const ImageFormat& format, ImageCompression compression)
 	{
-		uint32_t comp = GetBytesPerPixel(Format);
+		int32_t comp = GetBytesPerPixel(Format);
+		int32_t width = m_Width;
+		int32_t height = m_Height;
+		int32_t rowSize = width * comp;
+
+		//copied because the image can change or be deleted before it is written
+		auto pixels = std::make_shared<std::vector<uint8_t>>(m_Data, m_Data + (size_t)rowSize * height);
 
-		unsigned char* dataCpy = new unsigned char[m_Width * m_Height * comp * sizeof(unsigned char)];
-		memcpy(dataCpy, m_Data, m_Width * m_Height * comp * sizeof(unsigned char));
-		std::thread thread(t_SaveToFile, path, m_Width, m_Height, comp, dataCpy, format);
-		thread.detach();
+		auto job = [path, pixels, width, height, comp, rowSize, format, compression](ImageEncoder& encoder)
+		{
+			//images are stored bottom to top
+			const uint8_t* lastRow = pixels->data() + (size_t)(height - 1) * rowSize;
+			if (!encoder.Encode(lastRow, width, height, comp, -rowSize, format, compression) || !encoder.WriteToFile(path))
+			{
+				AINAN_LOG_ERROR("Could not save image to " + path);
+				return false;
+			}
+			return true;
+		};
+		return ImageWriter::Submit(job);
 	}
 
 	Image::Image(const Image& image)
@@ -91,6 +102,15 @@ namespace Ainan {
 		memcpy(m_Data, image.m_Data, m_Width * m_Height * GetBytesPerPixel(Format) * sizeof(unsigned char));
 	}
 
+	Image::Image(Image&& image) noexcept
+	{
+		m_Width = image.m_Width;
+		m_Height = image.m_Height;
+		Format = image.Format;
+		m_Data = image.m_Data;
+		image.m_Data = nullptr;
+	}
+
 	Image Image::operator=(const Image& image)
 	{
 		return Image(image);
@@ -125,6 +145,10 @@ namespace Ainan {
 
 		case ImageFormat::jpeg:
 			return "jpeg";
+
+		case ImageFormat::qoi:
+			return "qoi";
+
 		default:
 			return "";
 		}
@@ -3,13 +3,24 @@
 #include "stb/stb_image_write.h"
 #include "stb/stb_image.h"
 
+#include <future>
+
 namespace Ainan {
 
 	enum class ImageFormat 
 	{
 		png,
 		jpeg,
-		bmp
+		bmp,
+		qoi
+	};
+
+	enum class ImageCompression
+	{
+		//smallest files the format's encoder makes in reasonable time
+		Default,
+		//for writing many images quickly, png is stored without compression and qoi is always fast
+		Fast
 	};
 
 	enum class TextureFormat
@@ -56,9 +67,14 @@ namespace Ainan {
 		~Image();
 
 		static Image LoadFromFile(const std::string& pathAndName, TextureFormat desiredFormat = TextureFormat::Unspecified);
-		void SaveToFile(const std::string& pathAndName, const ImageFormat& format);
+		//decodes an encoded image (png, jpeg etc) that is already in memory
+		static Image LoadFromMemory(const uint8_t* data, size_t size, TextureFormat desiredFormat = TextureFormat::Unspecified);
+		//the image is copied and written by the ImageWriter threads, the future tells whether it was written
+		std::future<bool> SaveToFile(const std::string& pathAndName, const ImageFormat& format,
+			ImageCompression compression = ImageCompression::Default);
 
 		Image(const Image& image);
+		Image(Image&& image) noexcept;
 		Image operator=(const Image& image);
 
 		void FlipHorizontally();
@@ -0,0 +1,513 @@
+#include "ImageEncoder.h"
+
+namespace Ainan {
+
+	static void AppendToBuffer(void* context, void* data, int size)
+	{
+		auto& buffer = *(std::vector<uint8_t>*)context;
+		buffer.insert(buffer.end(), (uint8_t*)data, (uint8_t*)data + size);
+	}
+
+	static void AppendBigEndian(std::vector<uint8_t>& buffer, uint32_t value)
+	{
+		buffer.push_back((uint8_t)(value >> 24));
+		buffer.push_back((uint8_t)(value >> 16));
+		buffer.push_back((uint8_t)(value >> 8));
+		buffer.push_back((uint8_t)value);
+	}
+
+	static uint32_t GetCRC32(const uint8_t* data, size_t size)
+	{
+		static const std::array<uint32_t, 256> table = []()
+		{
+			std::array<uint32_t, 256> result;
+			for (uint32_t i = 0; i < 256; i++)
+			{
+				uint32_t value = i;
+				for (int32_t j = 0; j < 8; j++)
+					value = value & 1 ? 0xedb88320u ^ (value >> 1) : value >> 1;
+				result[i] = value;
+			}
+			return result;
+		}();
+
+		uint32_t crc = 0xffffffffu;
+		for (size_t i = 0; i < size; i++)
+			crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+		return crc ^ 0xffffffffu;
+	}
+
+	//start with an adler of 1 and keep passing the result to checksum data that arrives in pieces
+	static uint32_t UpdateAdler32(uint32_t adler, const uint8_t* data, size_t size)
+	{
+		//the sums can't overflow in this many bytes, so the modulo is only taken once per chunk
+		const size_t c_ChunkSize = 5552;
+
+		uint32_t a = adler & 0xffff;
+		uint32_t b = adler >> 16;
+		while (size > 0)
+		{
+			size_t chunkSize = std::min(size, c_ChunkSize);
+			for (size_t i = 0; i < chunkSize; i++)
+			{
+				a += data[i];
+				b += a;
+			}
+			a %= 65521;
+			b %= 65521;
+			data += chunkSize;
+			size -= chunkSize;
+		}
+		return (b << 16) | a;
+	}
+
+	//returns the offset of the chunk type, which is where the crc starts
+	static size_t BeginPNGChunk(std::vector<uint8_t>& buffer, const char* type, uint32_t size)
+	{
+		AppendBigEndian(buffer, size);
+		buffer.insert(buffer.end(), type, type + 4);
+		return buffer.size() - 4;
+	}
+
+	static void EndPNGChunk(std::vector<uint8_t>& buffer, size_t typeOffset)
+	{
+		AppendBigEndian(buffer, GetCRC32(&buffer[typeOffset], buffer.size() - typeOffset));
+	}
+
+	//the signature and the IHDR chunk
+	static void AppendPNGHeader(std::vector<uint8_t>& buffer, int32_t width, int32_t height, int32_t comp)
+	{
+		const uint8_t c_ColorTypes[] = { 0, 4, 2, 6 }; //gray, gray alpha, rgb, rgba
+		const uint8_t c_Signature[] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+		buffer.insert(buffer.end(), c_Signature, c_Signature + sizeof(c_Signature));
+
+		size_t chunk = BeginPNGChunk(buffer, "IHDR", 13);
+		AppendBigEndian(buffer, width);
+		AppendBigEndian(buffer, height);
+		buffer.push_back(8);
+		buffer.push_back(c_ColorTypes[comp - 1]);
+		buffer.push_back(0);
+		buffer.push_back(0);
+		buffer.push_back(0);
+		EndPNGChunk(buffer, chunk);
+	}
+
+	const size_t c_MaxStoredBlockSize = 65535;
+
+	static size_t GetStoredBlockCount(size_t size)
+	{
+		return (size + c_MaxStoredBlockSize - 1) / c_MaxStoredBlockSize;
+	}
+
+	//splits data into stored (uncompressed) deflate blocks, the last one is marked final only if final is set
+	static void AppendStoredBlocks(std::vector<uint8_t>& buffer, const uint8_t* data, size_t size, bool final)
+	{
+		size_t blockCount = std::max<size_t>(GetStoredBlockCount(size), 1);
+		for (size_t offset = 0, i = 0; i < blockCount; i++)
+		{
+			size_t blockSize = std::min(size - offset, c_MaxStoredBlockSize);
+			buffer.push_back(final && i == blockCount - 1 ? 1 : 0);
+			buffer.push_back((uint8_t)blockSize);
+			buffer.push_back((uint8_t)(blockSize >> 8));
+			buffer.push_back((uint8_t)~blockSize);
+			buffer.push_back((uint8_t)(~blockSize >> 8));
+			buffer.insert(buffer.end(), data + offset, data + offset + blockSize);
+			offset += blockSize;
+		}
+	}
+
+	static void AppendQOIHeader(std::vector<uint8_t>& buffer, int32_t width, int32_t height, int32_t comp)
+	{
+		const char c_Magic[] = "qoif";
+		buffer.insert(buffer.end(), c_Magic, c_Magic + 4);
+		AppendBigEndian(buffer, width);
+		AppendBigEndian(buffer, height);
+		buffer.push_back((uint8_t)comp);
+		buffer.push_back(0); //srgb with linear alpha
+	}
+
+	static void AppendQOIEnd(std::vector<uint8_t>& buffer)
+	{
+		const uint8_t c_EndMarker[] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+		buffer.insert(buffer.end(), c_EndMarker, c_EndMarker + sizeof(c_EndMarker));
+	}
+
+	static void AppendLittleEndian(std::vector<uint8_t>& buffer, uint32_t value, int32_t byteCount)
+	{
+		for (int32_t i = 0; i < byteCount; i++)
+			buffer.push_back((uint8_t)(value >> (8 * i)));
+	}
+
+	//32 bit bgra with a negative height, which stores the rows top to bottom,
+	//used by both the one shot and the streamed bitmaps so they keep the alpha channel
+	static void AppendBMPHeader(std::vector<uint8_t>& buffer, int32_t width, int32_t height)
+	{
+		uint64_t imageSize = (uint64_t)width * height * 4;
+		uint64_t fileSize = imageSize + 54;
+		buffer.push_back('B');
+		buffer.push_back('M');
+		//the sizes are optional for uncompressed bitmaps, they are left 0 if they don't fit
+		AppendLittleEndian(buffer, fileSize > UINT32_MAX ? 0 : (uint32_t)fileSize, 4);
+		AppendLittleEndian(buffer, 0, 4);
+		AppendLittleEndian(buffer, 54, 4);
+		AppendLittleEndian(buffer, 40, 4);
+		AppendLittleEndian(buffer, (uint32_t)width, 4);
+		AppendLittleEndian(buffer, (uint32_t)-height, 4);
+		AppendLittleEndian(buffer, 1, 2);
+		AppendLittleEndian(buffer, 32, 2);
+		AppendLittleEndian(buffer, 0, 4); //uncompressed
+		AppendLittleEndian(buffer, fileSize > UINT32_MAX ? 0 : (uint32_t)imageSize, 4);
+		AppendLittleEndian(buffer, 2835, 4); //72 dpi
+		AppendLittleEndian(buffer, 2835, 4);
+		AppendLittleEndian(buffer, 0, 4);
+		AppendLittleEndian(buffer, 0, 4);
+	}
+
+	//gray images are expanded and images without alpha get an opaque one
+	static void AppendBMPRows(std::vector<uint8_t>& buffer, const uint8_t* firstRow, int32_t width, int32_t rowCount, int32_t comp, int32_t stride)
+	{
+		size_t rowSize = (size_t)width * 4;
+		size_t start = buffer.size();
+		buffer.resize(start + rowSize * rowCount);
+		for (int32_t y = 0; y < rowCount; y++)
+		{
+			const uint8_t* source = firstRow + (ptrdiff_t)y * stride;
+			uint8_t* target = &buffer[start + rowSize * y];
+			for (int32_t x = 0; x < width; x++)
+			{
+				const uint8_t* pixel = source + x * comp;
+				bool gray = comp < 3;
+				target[x * 4 + 0] = gray ? pixel[0] : pixel[2];
+				target[x * 4 + 1] = gray ? pixel[0] : pixel[1];
+				target[x * 4 + 2] = pixel[0];
+				target[x * 4 + 3] = comp == 2 || comp == 4 ? pixel[comp - 1] : 255;
+			}
+		}
+	}
+
+	bool ImageEncoder::Encode(const uint8_t* firstRow, int32_t width, int32_t height, int32_t comp, int32_t stride,
+		ImageFormat format, ImageCompression compression)
+	{
+		m_Data.clear();
+
+		switch (format)
+		{
+		case ImageFormat::png:
+			if (compression == ImageCompression::Fast)
+				EncodeStoredPNG(firstRow, width, height, comp, stride);
+			else
+				stbi_write_png_to_func(AppendToBuffer, &m_Data, width, height, comp, firstRow, stride);
+			break;
+
+		//the stb jpeg writer doesn't take a stride
+		case ImageFormat::jpeg:
+			stbi_write_jpg_to_func(AppendToBuffer, &m_Data, width, height, comp, GetPackedRows(firstRow, width, height, comp, stride), 100);
+			break;
+
+		case ImageFormat::bmp:
+			AppendBMPHeader(m_Data, width, height);
+			AppendBMPRows(m_Data, firstRow, width, height, comp, stride);
+			break;
+
+		case ImageFormat::qoi:
+			if (comp != 3 && comp != 4)
+			{
+				AINAN_LOG_ERROR("QOI images need 3 or 4 components");
+				return false;
+			}
+			EncodeQOI(firstRow, width, height, comp, stride);
+			break;
+
+		default:
+			assert(false);
+			return false;
+		}
+
+		return m_Data.size() > 0;
+	}
+
+	bool ImageEncoder::WriteToFile(const std::string& path) const
+	{
+		FILE* file = fopen(path.c_str(), "wb");
+		if (!file)
+			return false;
+
+		bool succeeded = fwrite(m_Data.data(), 1, m_Data.size(), file) == m_Data.size();
+		succeeded = fclose(file) == 0 && succeeded;
+		return succeeded;
+	}
+
+	//a png with its image data in stored (uncompressed) deflate blocks, which costs little more than copying the pixels
+	void ImageEncoder::EncodeStoredPNG(const uint8_t* firstRow, int32_t width, int32_t height, int32_t comp, int32_t stride)
+	{
+		//every row starts with its filter type, 0 is none
+		size_t rowSize = (size_t)width * comp;
+		m_Rows.resize((rowSize + 1) * height);
+		for (int32_t y = 0; y < height; y++)
+		{
+			uint8_t* row = &m_Rows[(rowSize + 1) * y];
+			row[0] = 0;
+			memcpy(row + 1, firstRow + (ptrdiff_t)y * stride, rowSize);
+		}
+
+		AppendPNGHeader(m_Data, width, height, comp);
+
+		size_t blockCount = std::max<size_t>(GetStoredBlockCount(m_Rows.size()), 1);
+		size_t zlibSize = 2 + m_Rows.size() + blockCount * 5 + 4;
+		m_Data.reserve(m_Data.size() + zlibSize + 24);
+
+		size_t chunk = BeginPNGChunk(m_Data, "IDAT", (uint32_t)zlibSize);
+		//zlib header for deflate with the default window and no preset dictionary
+		m_Data.push_back(0x78);
+		m_Data.push_back(0x01);
+		AppendStoredBlocks(m_Data, m_Rows.data(), m_Rows.size(), true);
+		AppendBigEndian(m_Data, UpdateAdler32(1, m_Rows.data(), m_Rows.size()));
+		EndPNGChunk(m_Data, chunk);
+
+		EndPNGChunk(m_Data, BeginPNGChunk(m_Data, "IEND", 0));
+	}
+
+	//see https://qoiformat.org/qoi-specification.pdf
+	void QOIEncoderState::EncodeRow(std::vector<uint8_t>& buffer, const uint8_t* row, int32_t width, int32_t comp, bool lastRow)
+	{
+		const uint8_t c_OpIndex = 0x00;
+		const uint8_t c_OpDiff = 0x40;
+		const uint8_t c_OpLuma = 0x80;
+		const uint8_t c_OpRun = 0xc0;
+		const uint8_t c_OpRGB = 0xfe;
+		const uint8_t c_OpRGBA = 0xff;
+
+		for (int32_t x = 0; x < width; x++)
+		{
+			const uint8_t* pixelData = row + (size_t)x * comp;
+			std::array<uint8_t, 4> pixel = { pixelData[0], pixelData[1], pixelData[2], comp == 4 ? pixelData[3] : (uint8_t)255 };
+			bool last = lastRow && x == width - 1;
+
+			if (pixel == Previous)
+			{
+				Run++;
+				if (Run == 62 || last)
+				{
+					buffer.push_back(c_OpRun | (uint8_t)(Run - 1));
+					Run = 0;
+				}
+				continue;
+			}
+
+			if (Run > 0)
+			{
+				buffer.push_back(c_OpRun | (uint8_t)(Run - 1));
+				Run = 0;
+			}
+
+			int32_t indexPosition = (pixel[0] * 3 + pixel[1] * 5 + pixel[2] * 7 + pixel[3] * 11) % 64;
+			if (Index[indexPosition] == pixel)
+				buffer.push_back(c_OpIndex | (uint8_t)indexPosition);
+			else
+			{
+				Index[indexPosition] = pixel;
+
+				if (pixel[3] == Previous[3])
+				{
+					int8_t dr = (int8_t)(pixel[0] - Previous[0]);
+					int8_t dg = (int8_t)(pixel[1] - Previous[1]);
+					int8_t db = (int8_t)(pixel[2] - Previous[2]);
+					int8_t drg = dr - dg;
+					int8_t dbg = db - dg;
+
+					if (dr > -3 && dr < 2 && dg > -3 && dg < 2 && db > -3 && db < 2)
+						buffer.push_back(c_OpDiff | (uint8_t)((dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+					else if (drg > -9 && drg < 8 && dg > -33 && dg < 32 && dbg > -9 && dbg < 8)
+					{
+						buffer.push_back(c_OpLuma | (uint8_t)(dg + 32));
+						buffer.push_back((uint8_t)((drg + 8) << 4 | (dbg + 8)));
+					}
+					else
+					{
+						buffer.push_back(c_OpRGB);
+						buffer.insert(buffer.end(), pixel.begin(), pixel.begin() + 3);
+					}
+				}
+				else
+				{
+					buffer.push_back(c_OpRGBA);
+					buffer.insert(buffer.end(), pixel.begin(), pixel.end());
+				}
+			}
+			Previous = pixel;
+		}
+	}
+
+	void ImageEncoder::EncodeQOI(const uint8_t* firstRow, int32_t width, int32_t height, int32_t comp, int32_t stride)
+	{
+		m_Data.reserve((size_t)width * height * (comp + 1) + 22);
+		AppendQOIHeader(m_Data, width, height, comp);
+
+		QOIEncoderState state;
+		for (int32_t y = 0; y < height; y++)
+			state.EncodeRow(m_Data, firstRow + (ptrdiff_t)y * stride, width, comp, y == height - 1);
+
+		AppendQOIEnd(m_Data);
+	}
+
+	const uint8_t* ImageEncoder::GetPackedRows(const uint8_t* firstRow, int32_t width, int32_t height, int32_t comp, int32_t stride)
+	{
+		size_t rowSize = (size_t)width * comp;
+		if (stride == (ptrdiff_t)rowSize)
+			return firstRow;
+
+		m_Rows.resize(rowSize * height);
+		for (int32_t y = 0; y < height; y++)
+			memcpy(&m_Rows[rowSize * y], firstRow + (ptrdiff_t)y * stride, rowSize);
+		return m_Rows.data();
+	}
+
+	ImageStreamWriter::~ImageStreamWriter()
+	{
+		if (m_File)
+			fclose(m_File);
+	}
+
+	bool ImageStreamWriter::Open(const std::string& path, int32_t width, int32_t height, ImageFormat format)
+	{
+		assert(!m_File);
+		assert(width > 0 && height > 0);
+
+		if (format == ImageFormat::jpeg)
+		{
+			AINAN_LOG_ERROR("JPEG images can't be written in rows");
+			return false;
+		}
+
+		m_File = fopen(path.c_str(), "wb");
+		if (!m_File)
+		{
+			AINAN_LOG_ERROR("Could not open " + path + " for writing");
+			return false;
+		}
+
+		m_Format = format;
+		m_Width = width;
+		m_Height = height;
+		m_WrittenRowCount = 0;
+		m_Failed = false;
+		m_Adler = 1;
+		m_QOIState = QOIEncoderState();
+		m_Data.clear();
+
+		switch (format)
+		{
+		case ImageFormat::png:
+			AppendPNGHeader(m_Data, width, height, 4);
+			break;
+
+		case ImageFormat::bmp:
+			AppendBMPHeader(m_Data, width, height);
+			break;
+
+		case ImageFormat::qoi:
+			AppendQOIHeader(m_Data, width, height, 4);
+			break;
+
+		default:
+			assert(false);
+			break;
+		}
+
+		return WriteData();
+	}
+
+	bool ImageStreamWriter::WriteRows(const uint8_t* firstRow, int32_t rowCount, int32_t stride)
+	{
+		assert(m_File);
+		assert(m_WrittenRowCount + rowCount <= m_Height);
+
+		size_t rowSize = (size_t)m_Width * 4;
+		m_Data.clear();
+
+		switch (m_Format)
+		{
+		case ImageFormat::png:
+		{
+			//every row starts with its filter type, 0 is none
+			m_Rows.resize((rowSize + 1) * rowCount);
+			for (int32_t y = 0; y < rowCount; y++)
+			{
+				uint8_t* row = &m_Rows[(rowSize + 1) * y];
+				row[0] = 0;
+				memcpy(row + 1, firstRow + (ptrdiff_t)y * stride, rowSize);
+			}
+
+			//every call writes an IDAT chunk and they all continue the same zlib stream,
+			//the final block and the checksum are written by Close
+			bool first = m_WrittenRowCount == 0;
+			size_t zlibSize = (first ? 2 : 0) + m_Rows.size() + GetStoredBlockCount(m_Rows.size()) * 5;
+			size_t chunk = BeginPNGChunk(m_Data, "IDAT", (uint32_t)zlibSize);
+			if (first)
+			{
+				m_Data.push_back(0x78);
+				m_Data.push_back(0x01);
+			}
+			AppendStoredBlocks(m_Data, m_Rows.data(), m_Rows.size(), false);
+			EndPNGChunk(m_Data, chunk);
+			m_Adler = UpdateAdler32(m_Adler, m_Rows.data(), m_Rows.size());
+			break;
+		}
+
+		case ImageFormat::bmp:
+			AppendBMPRows(m_Data, firstRow, m_Width, rowCount, 4, stride);
+			break;
+
+		case ImageFormat::qoi:
+			for (int32_t y = 0; y < rowCount; y++)
+				m_QOIState.EncodeRow(m_Data, firstRow + (ptrdiff_t)y * stride, m_Width, 4, m_WrittenRowCount + y == m_Height - 1);
+			break;
+
+		default:
+			assert(false);
+			break;
+		}
+
+		m_WrittenRowCount += rowCount;
+		return WriteData();
+	}
+
+	bool ImageStreamWriter::Close()
+	{
+		if (!m_File)
+			return false;
+
+		bool complete = m_WrittenRowCount == m_Height;
+		if (!complete)
+			AINAN_LOG_ERROR("Image closed after " + std::to_string(m_WrittenRowCount) + " of its " + std::to_string(m_Height) + " rows");
+
+		m_Data.clear();
+		if (m_Format == ImageFormat::png)
+		{
+			//an empty final block ends the deflate stream
+			size_t chunk = BeginPNGChunk(m_Data, "IDAT", 5 + 4);
+			AppendStoredBlocks(m_Data, nullptr, 0, true);
+			AppendBigEndian(m_Data, m_Adler);
+			EndPNGChunk(m_Data, chunk);
+			EndPNGChunk(m_Data, BeginPNGChunk(m_Data, "IEND", 0));
+		}
+		else if (m_Format == ImageFormat::qoi)
+			AppendQOIEnd(m_Data);
+
+		bool succeeded = WriteData();
+		succeeded = fclose(m_File) == 0 && succeeded;
+		m_File = nullptr;
+
+		return succeeded && complete;
+	}
+
+	bool ImageStreamWriter::WriteData()
+	{
+		if (!m_Failed && fwrite(m_Data.data(), 1, m_Data.size(), m_File) != m_Data.size())
+		{
+			AINAN_LOG_ERROR("Could not write image rows");
+			m_Failed = true;
+		}
+		return !m_Failed;
+	}
+}
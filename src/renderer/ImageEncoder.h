@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Image.h"
+
+namespace Ainan {
+
+	//the running state of a qoi encoder, kept between rows so an image can be encoded a few rows at a time
+	struct QOIEncoderState
+	{
+		std::array<std::array<uint8_t, 4>, 64> Index = {};
+		std::array<uint8_t, 4> Previous = { 0, 0, 0, 255 };
+		int32_t Run = 0;
+
+		void EncodeRow(std::vector<uint8_t>& buffer, const uint8_t* row, int32_t width, int32_t comp, bool lastRow);
+	};
+
+	//encodes images into a buffer that is reused between images, so an encoder per thread doesn't allocate once it warmed up
+	class ImageEncoder
+	{
+	public:
+		//stride is the distance between rows in bytes, it can be negative to write the rows bottom to top,
+		//qoi only supports 3 and 4 components
+		bool Encode(const uint8_t* firstRow, int32_t width, int32_t height, int32_t comp, int32_t stride,
+			ImageFormat format, ImageCompression compression = ImageCompression::Default);
+
+		//writes the last encoded image
+		bool WriteToFile(const std::string& path) const;
+		const std::vector<uint8_t>& GetData() const { return m_Data; }
+
+	private:
+		void EncodeStoredPNG(const uint8_t* firstRow, int32_t width, int32_t height, int32_t comp, int32_t stride);
+		void EncodeQOI(const uint8_t* firstRow, int32_t width, int32_t height, int32_t comp, int32_t stride);
+		//returns the rows packed top to bottom, copying them into m_Rows only if they aren't already
+		const uint8_t* GetPackedRows(const uint8_t* firstRow, int32_t width, int32_t height, int32_t comp, int32_t stride);
+
+	private:
+		std::vector<uint8_t> m_Data;
+		std::vector<uint8_t> m_Rows;
+	};
+
+	//writes an rgba image to a file a few rows at a time, so images too big for memory can be exported,
+	//rows are given top to bottom, png is written with stored deflate blocks like ImageCompression::Fast
+	//and jpeg isn't supported because it can't be encoded in rows
+	class ImageStreamWriter
+	{
+	public:
+		ImageStreamWriter() = default;
+		~ImageStreamWriter();
+
+		ImageStreamWriter(const ImageStreamWriter&) = delete;
+		ImageStreamWriter operator=(const ImageStreamWriter&) = delete;
+
+		bool Open(const std::string& path, int32_t width, int32_t height, ImageFormat format);
+		//stride is the distance between rows in bytes, it can be negative if the rows are stored bottom to top
+		bool WriteRows(const uint8_t* firstRow, int32_t rowCount, int32_t stride);
+		//fails if not every row was written
+		bool Close();
+
+		int32_t GetWrittenRowCount() const { return m_WrittenRowCount; }
+
+	private:
+		bool WriteData();
+
+	private:
+		FILE* m_File = nullptr;
+		ImageFormat m_Format = ImageFormat::png;
+		int32_t m_Width = 0;
+		int32_t m_Height = 0;
+		int32_t m_WrittenRowCount = 0;
+		bool m_Failed = false;
+		uint32_t m_Adler = 1;
+		QOIEncoderState m_QOIState;
+		std::vector<uint8_t> m_Data;
+		std::vector<uint8_t> m_Rows;
+	};
+}
@@ -0,0 +1,54 @@
+#include "ImageWriter.h"
+
+namespace Ainan {
+
+	std::vector<std::thread> ImageWriter::s_WorkerThreads;
+	std::unique_ptr<BoundedQueue<ImageWriter::QueuedJob>> ImageWriter::s_Jobs;
+
+	void ImageWriter::Init()
+	{
+		//leave a core for the main thread and one for the renderer thread
+		uint32_t threadCount = std::thread::hardware_concurrency();
+		threadCount = std::clamp(threadCount > 2 ? threadCount - 2 : 1, 1u, 8u);
+
+		s_Jobs = std::make_unique<BoundedQueue<QueuedJob>>(c_ImageWriteQueueSize);
+		for (uint32_t i = 0; i < threadCount; i++)
+			s_WorkerThreads.push_back(std::thread(WorkerThreadLoop));
+	}
+
+	void ImageWriter::Terminate()
+	{
+		//images that were already submitted are still written
+		s_Jobs->Close();
+		for (auto& thread : s_WorkerThreads)
+			thread.join();
+		s_WorkerThreads.clear();
+		s_Jobs.reset();
+	}
+
+	std::future<bool> ImageWriter::Submit(Job job)
+	{
+		QueuedJob queued;
+		queued.Function = std::move(job);
+		queued.Result = std::make_shared<std::promise<bool>>();
+		std::future<bool> result = queued.Result->get_future();
+
+		std::shared_ptr<std::promise<bool>> promise = queued.Result;
+		if (!s_Jobs->Push(std::move(queued)))
+			promise->set_value(false);
+
+		return result;
+	}
+
+	void ImageWriter::WorkerThreadLoop()
+	{
+		ImageEncoder encoder;
+
+		QueuedJob job;
+		while (s_Jobs->Pop(job))
+		{
+			job.Result->set_value(job.Function(encoder));
+			job = QueuedJob();
+		}
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "ImageEncoder.h"
+#include "editor/BoundedQueue.h"
+
+namespace Ainan {
+
+	//how many images can wait for a writer thread, submitting more blocks until one is taken
+	const uint32_t c_ImageWriteQueueSize = 16;
+
+	//encodes and writes images on a small pool of threads so saving them doesn't block the caller,
+	//every thread has its own ImageEncoder so its buffers are reused between images
+	class ImageWriter
+	{
+	public:
+		//gets the thread's encoder, returns whether the image was written
+		using Job = std::function<bool(ImageEncoder& encoder)>;
+
+		//called by the Renderer
+		static void Init();
+		static void Terminate();
+
+		//blocks while the queue is full, the future is ready once the job ran
+		static std::future<bool> Submit(Job job);
+
+		static uint32_t GetThreadCount() { return (uint32_t)s_WorkerThreads.size(); }
+
+	private:
+		struct QueuedJob
+		{
+			Job Function;
+			std::shared_ptr<std::promise<bool>> Result;
+		};
+
+		static void WorkerThreadLoop();
+
+	private:
+		static std::vector<std::thread> s_WorkerThreads;
+		static std::unique_ptr<BoundedQueue<QueuedJob>> s_Jobs;
+	};
+}
@@ -8,6 +8,26 @@
 #include "opengl/OpenGLFrameBuffer.h"
 #include "opengl/OpenGLUniformBuffer.h"
 
+#ifdef PLATFORM_LINUX
+#include "opengl/OpenGLHeadlessRendererAPI.h"
+#endif // PLATFORM_LINUX
+
+#include "software/SoftwareRendererAPI.h"
+#include "software/SoftwareShaderProgram.h"
+#include "software/SoftwareVertexBuffer.h"
+#include "software/SoftwareIndexBuffer.h"
+#include "software/SoftwareTexture.h"
+#include "software/SoftwareFrameBuffer.h"
+#include "software/SoftwareUniformBuffer.h"
+
+#include "null/NullRendererAPI.h"
+#include "null/NullShaderProgram.h"
+#include "null/NullVertexBuffer.h"
+#include "null/NullIndexBuffer.h"
+#include "null/NullTexture.h"
+#include "null/NullFrameBuffer.h"
+#include "null/NullUniformBuffer.h"
+
 #include <GLFW/glfw3.h>
 
 #ifdef PLATFORM_WINDOWS
@@ -29,7 +49,6 @@ bool WantUpdateMonitors = true;
 
 namespace Ainan {
 
-	double LastFrameFinishTime = 0.0;
 	double LastFrameDeltaTime = 0.0;
 
 	Renderer::RendererData* Renderer::Rdata = nullptr;
@@ -52,17 +71,24 @@ namespace Ainan {
 		{ "GridShader"          , "shaders/Grid"          , "shaders/Grid"           },
 		{ "ImageShader"         , "shaders/Image"         , "shaders/Image"          },
 		{ "QuadBatchShader"     , "shaders/QuadBatch"     , "shaders/QuadBatch"      },
-		{ "LitSpriteShader"     , "shaders/LitSprite"     , "shaders/LitSprite"      }
+		{ "LitSpriteShader"     , "shaders/LitSprite"     , "shaders/LitSprite"      },
+		{ "YUV420Shader"        , "shaders/Image"         , "shaders/YUV420"         }
 	};
 
-	void Renderer::Init(RendererType api)
+	void Renderer::Init(RendererType api, bool headless, const glm::vec2& headlessSurfaceSize)
 	{
+		//the software and null renderers have no window surface to present to
+		if (api == RendererType::Software || api == RendererType::Null)
+			headless = true;
+
 		//allocate renderer memory
 		Rdata = new RendererData();
+		Rdata->Headless = headless;
+		Rdata->HeadlessSurfaceSize = headlessSurfaceSize;
 
-		auto initFunc = [api]()
+		auto initFunc = [api, headless]()
 		{
-			Renderer::InternalInit(api);
+			Renderer::InternalInit(api, headless);
 			AINAN_LOG_INFO("Renderer Initilized\nBackend: " + RendererTypeStr(Rdata->CurrentActiveAPI->GetContext()->GetType()) +
 						   "             Version: " + Rdata->CurrentActiveAPI->GetContext()->GetVersionString() +
 						   "             Physical Device: " + Rdata->CurrentActiveAPI->GetContext()->GetPhysicalDeviceName());
@@ -74,10 +100,17 @@ namespace Ainan {
 
 		//wait until the renderer thread finished initializing
 		WaitUntilRendererIdle();
+
+		TextureLoader::Init();
+		ImageWriter::Init();
 	}
 
 	void Renderer::Terminate()
 	{
+		TextureCache::Clear();
+		TextureLoader::Terminate();
+		ImageWriter::Terminate();
+
 		//signal and wait for the renderer thread to stop
 		Rdata->DestroyThread = true;
 		Rdata->cv.notify_all();
@@ -87,7 +120,12 @@ namespace Ainan {
 		delete Rdata;
 	}
 
-	void Renderer::InternalInit(RendererType api)
+	glm::vec2 Renderer::GetSurfaceSizeUnsafe()
+	{
+		return Rdata->Headless ? Rdata->HeadlessSurfaceSize : Window::FramebufferSize;
+	}
+
+	void Renderer::InternalInit(RendererType api, bool headless)
 	{
 		std::lock_guard lock(Rdata->DataMutex);
 
@@ -96,19 +134,51 @@ namespace Ainan {
 		{
 #ifdef PLATFORM_WINDOWS
 		case RendererType::D3D11:
+			assert(!headless);
 			Rdata->CurrentActiveAPI = new D3D11::D3D11RendererAPI();
 			break;
 #endif
 
 		case RendererType::OpenGL:
-			Rdata->CurrentActiveAPI = new OpenGL::OpenGLRendererAPI();
+			if (headless)
+			{
+#ifdef PLATFORM_LINUX
+				Rdata->CurrentActiveAPI = new OpenGL::OpenGLHeadlessRendererAPI();
+#else
+				AINAN_LOG_FATAL("Headless rendering is not supported on this platform");
+#endif // PLATFORM_LINUX
+			}
+			else
+				Rdata->CurrentActiveAPI = new OpenGL::OpenGLRendererAPI();
+			break;
+
+		case RendererType::Software:
+			Rdata->CurrentActiveAPI = new Software::SoftwareRendererAPI(GetSurfaceSizeUnsafe());
+			break;
+
+		case RendererType::Null:
+			Rdata->CurrentActiveAPI = new Null::NullRendererAPI();
 			break;
 		}
 
 		//load shaders
-		for (auto& shaderInfo : CompileOnInit)
+		if (api == RendererType::OpenGL)
+		{
+			//compile all the shaders together so the driver can do it in parallel
+			std::vector<std::pair<std::string, std::string>> shaderPaths;
+			for (auto& shaderInfo : CompileOnInit)
+				shaderPaths.push_back({ shaderInfo.VertexCodePath, shaderInfo.FragmentCodePath });
+
+			auto shaders = OpenGL::OpenGLShaderProgram::CreateMultiple(shaderPaths);
+			for (size_t i = 0; i < CompileOnInit.size(); i++)
+				Rdata->ShaderLibrary[CompileOnInit[i].Name] = shaders[i];
+		}
+		else
 		{
-			Rdata->ShaderLibrary[shaderInfo.Name] = CreateShaderProgram(shaderInfo.VertexCodePath, shaderInfo.FragmentCodePath);
+			for (auto& shaderInfo : CompileOnInit)
+			{
+				Rdata->ShaderLibrary[shaderInfo.Name] = CreateShaderProgram(shaderInfo.VertexCodePath, shaderInfo.FragmentCodePath);
+			}
 		}
 
 		//setup batch renderer
@@ -154,7 +224,7 @@ namespace Ainan {
 		Rdata->QuadBatchTextures[0]->SetImageUnsafe(img);
 
 		//setup postprocessing
-		Rdata->BlurFrameBuffer = CreateFrameBufferUnsafe(Window::FramebufferSize);
+		Rdata->BlurFrameBuffer = CreateFrameBufferUnsafe(GetSurfaceSizeUnsafe());
 
 		{
 			auto vertices = GetTexturedQuadVertices();
@@ -172,7 +242,16 @@ namespace Ainan {
 				VertexLayoutElement("u_Radius",0, ShaderVariableType::Float)
 			};
 			Rdata->BlurUniformBuffer = CreateUniformBufferUnsafe("BlurData", 1, layout, nullptr);
-			Rdata->ShaderLibrary["BlurShader"]->BindUniformBufferUnsafe(Rdata->BlurUniformBuffer, 1, RenderingStage::FragmentShader);
+		}
+
+		{
+			VertexLayout layout =
+			{
+				VertexLayoutElement("u_VideoSize",0, ShaderVariableType::Vec2),
+				VertexLayoutElement("u_SourceHeight",0, ShaderVariableType::Float),
+				VertexLayoutElement("u_FlipVertically",0, ShaderVariableType::Float)
+			};
+			Rdata->YUVConversionUniformBuffer = CreateUniformBufferUnsafe("YUVConversionData", 1, layout, nullptr);
 		}
 
 		Rdata->CurrentActiveAPI->SetBlendMode(Rdata->m_CurrentBlendMode);
@@ -195,14 +274,15 @@ namespace Ainan {
 			};
 
 			Rdata->SceneUniformbuffer = CreateUniformBufferUnsafe("FrameData", 0, layout, nullptr);
-
-			for (auto& shaderTuple : Rdata->ShaderLibrary)
-			{
-				shaderTuple.second->BindUniformBufferUnsafe(Rdata->SceneUniformbuffer, 0, RenderingStage::VertexShader);
-				shaderTuple.second->BindUniformBufferUnsafe(Rdata->SceneUniformbuffer, 0, RenderingStage::FragmentShader);
-			}
 		}
 
+		for (auto& shaderTuple : Rdata->ShaderLibrary)
+			BindShaderUniformBuffersUnsafe(shaderTuple.first, shaderTuple.second);
+
+		//there is no window to draw the ui on
+		if (headless)
+			return;
+
 		ImGui::CreateContext();
 		ImGuiIO& io = ImGui::GetIO();
 		io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;           // Enable Docking
@@ -245,7 +325,9 @@ namespace Ainan {
 			data->Window = glfwCreateWindow((int)viewport->Size.x, (int)viewport->Size.y, "No Title Yet", NULL, share_window);
 			data->WindowOwned = true;
 			viewport->PlatformHandle = (void*)data->Window;
+#ifdef PLATFORM_WINDOWS
 			viewport->PlatformHandleRaw = glfwGetWin32Window(data->Window);
+#endif // PLATFORM_WINDOWS
 			glfwSetWindowPos(data->Window, (int)viewport->Pos.x, (int)viewport->Pos.y);
 
 			// Install callbacks
@@ -378,6 +460,77 @@ namespace Ainan {
 		Rdata->CurrentActiveAPI->InitImGui();
 	}
 
+	void Renderer::BindShaderUniformBuffersUnsafe(const std::string& name, std::shared_ptr<ShaderProgram>& shader)
+	{
+		shader->BindUniformBufferUnsafe(Rdata->SceneUniformbuffer, 0, RenderingStage::VertexShader);
+		shader->BindUniformBufferUnsafe(Rdata->SceneUniformbuffer, 0, RenderingStage::FragmentShader);
+
+		if (name == "BlurShader")
+			shader->BindUniformBufferUnsafe(Rdata->BlurUniformBuffer, 1, RenderingStage::FragmentShader);
+		else if (name == "YUV420Shader")
+			shader->BindUniformBufferUnsafe(Rdata->YUVConversionUniformBuffer, 1, RenderingStage::FragmentShader);
+	}
+
+	void Renderer::ReloadShaders(const std::vector<std::filesystem::path>& changedFiles)
+	{
+		//find which shaders the files belong to, shared include files are used by every shader
+		std::vector<const ShaderLoadInfo*> reloaded;
+		bool reloadAll = false;
+		for (auto& path : changedFiles)
+		{
+			std::string extension = path.extension().u8string();
+			std::string stem = path.stem().u8string();
+			bool isVertex = extension == ".vert" || (extension == ".cso" && stem.size() > 3 && stem.substr(stem.size() - 3) == "_vs");
+			bool isFragment = extension == ".frag" || (extension == ".cso" && stem.size() > 3 && stem.substr(stem.size() - 3) == "_fs");
+			if (extension == ".cso" && (isVertex || isFragment))
+				stem.erase(stem.size() - 3);
+
+			if (extension == ".glsli")
+				reloadAll = true;
+			else if (isVertex || isFragment)
+			{
+				for (auto& shaderInfo : CompileOnInit)
+				{
+					bool usesFile = (isVertex && std::filesystem::path(shaderInfo.VertexCodePath).filename().u8string() == stem) ||
+						(isFragment && std::filesystem::path(shaderInfo.FragmentCodePath).filename().u8string() == stem);
+					if (usesFile && std::find(reloaded.begin(), reloaded.end(), &shaderInfo) == reloaded.end())
+						reloaded.push_back(&shaderInfo);
+				}
+			}
+		}
+
+		if (reloadAll)
+		{
+			reloaded.clear();
+			for (auto& shaderInfo : CompileOnInit)
+				reloaded.push_back(&shaderInfo);
+		}
+
+		if (reloaded.empty())
+			return;
+
+		auto func = [reloaded]()
+		{
+			for (const ShaderLoadInfo* shaderInfo : reloaded)
+			{
+				std::shared_ptr<ShaderProgram> shader = CreateShaderProgram(shaderInfo->VertexCodePath, shaderInfo->FragmentCodePath);
+				if (!shader || !shader->IsValid())
+				{
+					AINAN_LOG_ERROR("Reloading " + shaderInfo->Name + " failed, the old shader is kept");
+					continue;
+				}
+
+				BindShaderUniformBuffersUnsafe(shaderInfo->Name, shader);
+				Rdata->ShaderLibrary[shaderInfo->Name] = shader;
+				AINAN_LOG_INFO("Reloaded " + shaderInfo->Name);
+			}
+		};
+		PushCommand(func);
+
+		//the ShaderLibrary is read by the main thread, so it must not be changed while the caller keeps going
+		WaitUntilRendererIdle();
+	}
+
 	void Renderer::RendererThreadLoop()
 	{
 		while (true)
@@ -390,6 +543,7 @@ namespace Ainan {
 					Rdata->cv.wait(lock, []() { return Rdata->payload == true || Rdata->DestroyThread; });
 				}
 				std::function<void()> func = nullptr;
+				Rdata->CommandBatchStart = std::chrono::high_resolution_clock::now();
 				while (Rdata->CommandBuffer.size() > 0)
 				{
 					{
@@ -399,6 +553,7 @@ namespace Ainan {
 					}
 					func();
 				}
+				Rdata->CurrentRenderThreadBusyTime += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - Rdata->CommandBatchStart).count();
 				Rdata->payload = false;
 				Rdata->WorkDoneCV.notify_all();
 			}
@@ -409,24 +564,33 @@ namespace Ainan {
 	{
 		Rdata->ShaderLibrary.erase(Rdata->ShaderLibrary.begin(), Rdata->ShaderLibrary.end());
 
-		delete Rdata->CurrentActiveAPI;
-
 		//batch renderer data
 		Rdata->QuadBatchVertexBuffer.reset();
 		Rdata->QuadBatchIndexBuffer.reset();
 		delete[] Rdata->QuadBatchVertexBufferDataOrigin;
 		Rdata->QuadBatchTextures[0].reset();
+
+		//postprocessing data
+		Rdata->BlurFrameBuffer.reset();
+		Rdata->BlurVertexBuffer.reset();
+		Rdata->BlurUniformBuffer.reset();
+		Rdata->YUVConversionUniformBuffer.reset();
+		Rdata->SceneUniformbuffer.reset();
+
+		//released after every gpu resource so the api can delete them while it still has a valid context
+		delete Rdata->CurrentActiveAPI;
 	}
 
-	void Renderer::PushCommand(std::function<void()> func)
+	bool Renderer::PushCommand(std::function<void()> func, bool runWhenMinimized)
 	{
-		if (Window::Minimized)
-			return;
+		if (Window::Minimized && !runWhenMinimized)
+			return false;
 
 		std::unique_lock lock(Rdata->QueueMutex);
 		Rdata->CommandBuffer.push(func);
 		Rdata->payload = true;
 		Rdata->cv.notify_one();
+		return true;
 	}
 
 	void Renderer::BeginScene(const SceneDescription& desc)
@@ -868,40 +1032,107 @@ namespace Ainan {
 	{
 		auto func = []()
 		{
-			Rdata->CurrentActiveAPI->ClearScreen();
+			ClearScreenUnsafe();
 		};
 		PushCommand(func);
 	}
 
 	void Renderer::ClearScreenUnsafe()
 	{
+		BeginPassUnsafe(RenderPass::Clear);
 		Rdata->CurrentActiveAPI->ClearScreen();
+		EndPassUnsafe();
+	}
+
+	void Renderer::BeginPass(RenderPass pass)
+	{
+		auto func = [pass]()
+		{
+			BeginPassUnsafe(pass);
+		};
+		PushCommand(func);
+	}
+
+	void Renderer::EndPass()
+	{
+		auto func = []()
+		{
+			EndPassUnsafe();
+		};
+		PushCommand(func);
+	}
+
+	void Renderer::BeginPassUnsafe(RenderPass pass)
+	{
+		Rdata->PassDepth++;
+		if (Rdata->PassDepth > 1)
+			return;
+
+		Rdata->ActivePass = pass;
+		Rdata->ActivePassStart = std::chrono::high_resolution_clock::now();
+		Rdata->CurrentActiveAPI->BeginGPUTimer(pass);
+	}
+
+	void Renderer::EndPassUnsafe()
+	{
+		assert(Rdata->PassDepth > 0);
+		Rdata->PassDepth--;
+		if (Rdata->PassDepth > 0)
+			return;
+
+		Rdata->CurrentActiveAPI->EndGPUTimer();
+		auto now = std::chrono::high_resolution_clock::now();
+		Rdata->CurrentCPUPassTimes[(size_t)Rdata->ActivePass] += std::chrono::duration<double, std::milli>(now - Rdata->ActivePassStart).count();
+		Rdata->ActivePass = RenderPass::Count;
 	}
 
 	void Renderer::Present()
 	{
-		std::chrono::high_resolution_clock::now();
-		 
 		auto func = []()
 		{
 			Rdata->CurrentActiveAPI->Present();
+
+			//upload textures that finished loading for the next frame
+			TextureLoader::UploadPendingUnsafe();
+
+			//collect this frame's profiling data
+			Rdata->CurrentActiveAPI->ResolveGPUTimers(Rdata->GPUPassTimes);
+			Rdata->CPUPassTimes = Rdata->CurrentCPUPassTimes;
+			Rdata->CurrentCPUPassTimes.fill(0.0);
+
+			auto now = std::chrono::high_resolution_clock::now();
+			Rdata->RenderThreadBusyTime = Rdata->CurrentRenderThreadBusyTime + std::chrono::duration<double, std::milli>(now - Rdata->CommandBatchStart).count();
+			Rdata->CurrentRenderThreadBusyTime = 0.0;
+			Rdata->CommandBatchStart = now;
 		};
 		PushCommand(func);
+
+		auto waitStart = std::chrono::high_resolution_clock::now();
 		WaitUntilRendererIdle();
+		Rdata->PresentWaitTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - waitStart).count();
+
+		//headless rendering is used for offline work, so it runs as fast as possible
+		if (Rdata->Headless)
+			return;
 
-		bool running = true;
+		LastFrameDeltaTime = Rdata->Pacer.WaitForNextFrame();
+	}
+
+	void Renderer::SetFramePacing(FramePacingMode mode, int32_t targetFramerate)
+	{
+		Rdata->Pacer.SetMode(mode, targetFramerate);
 
-		while (running) 
+		bool vsync = mode == FramePacingMode::VSync;
+		auto func = [vsync]()
 		{
-			double time = glfwGetTime();
-			LastFrameDeltaTime = time - LastFrameFinishTime;
+			Rdata->CurrentActiveAPI->SetVSync(vsync);
+		};
+		PushCommand(func);
+	}
 
-			if (LastFrameDeltaTime >= c_ApplicationMaxFramePeriod)
-			{
-				LastFrameFinishTime = time;
-				break;
-			}
-		}
+	FrameTimePercentiles Renderer::GetFrameTimePercentiles()
+	{
+		return Rdata->Pacer.GetFrameTimePercentiles();
 	}
 
 	void Renderer::RecreateSwapchain(const glm::vec2& newSwapchainSize)
@@ -916,6 +1147,8 @@ namespace Ainan {
 	//Only called internally by the Renderer, and used only by the Renderer thread
 	void Renderer::Blur(std::shared_ptr<FrameBuffer>& target, float radius)
 	{
+		BeginPassUnsafe(RenderPass::Blur);
+
 		Rectangle lastViewport = Renderer::GetCurrentViewport();
 		RenderingBlendMode lastBlendMode = Rdata->m_CurrentBlendMode;
 		Rdata->CurrentActiveAPI->SetBlendMode(RenderingBlendMode::Screen);
@@ -974,10 +1207,73 @@ namespace Ainan {
 		Rdata->CurrentActiveAPI->SetViewport(lastViewport);
 		Rdata->CurrentActiveAPI->SetBlendMode(lastBlendMode);
 
+		EndPassUnsafe();
+
 		std::lock_guard lock(Rdata->DataMutex);
 		Rdata->CurrentNumberOfDrawCalls += 2;
 	}
 
+	void Renderer::ConvertToYUV420(std::shared_ptr<FrameBuffer>& source, std::shared_ptr<FrameBuffer>& target, bool flipVertically)
+	{
+		auto func = [source, target, flipVertically]() mutable
+		{
+			ConvertToYUV420Unsafe(source, target, flipVertically);
+		};
+		PushCommand(func);
+	}
+
+	void Renderer::ConvertToYUV420Unsafe(std::shared_ptr<FrameBuffer>& source, std::shared_ptr<FrameBuffer>& target, bool flipVertically)
+	{
+		BeginPassUnsafe(RenderPass::YUVConversion);
+
+		glm::ivec2 sourceSize = glm::ivec2(source->GetSize());
+		YUV420Layout layout(sourceSize);
+		target->ResizeUnsafe(glm::vec2(layout.TargetSize));
+
+		Rectangle lastViewport = Renderer::GetCurrentViewport();
+		RenderingBlendMode lastBlendMode = Rdata->m_CurrentBlendMode;
+		//every channel is data, so it has to overwrite the target as is
+		Rdata->CurrentActiveAPI->SetBlendMode(RenderingBlendMode::Overlay);
+
+		Rectangle viewport;
+		viewport.X = 0;
+		viewport.Y = 0;
+		viewport.Width = layout.TargetSize.x;
+		viewport.Height = layout.TargetSize.y;
+		Rdata->CurrentActiveAPI->SetViewport(viewport);
+
+		auto& shader = Rdata->ShaderLibrary["YUV420Shader"];
+		shader->BindUniformBufferUnsafe(Rdata->YUVConversionUniformBuffer, 1, RenderingStage::FragmentShader);
+
+		//make a buffer for all the uniform data
+		uint8_t bufferData[16];
+		glm::vec2 videoSize = layout.VideoSize;
+		float sourceHeight = (float)sourceSize.y;
+		float flip = flipVertically ? 1.0f : 0.0f;
+		memcpy(bufferData, &videoSize, sizeof(glm::vec2));
+		memcpy(bufferData + 8, &sourceHeight, sizeof(float));
+		memcpy(bufferData + 12, &flip, sizeof(float));
+		Rdata->YUVConversionUniformBuffer->UpdateDataUnsafe(bufferData);
+
+		target->BindUnsafe();
+		Rdata->CurrentActiveAPI->ClearScreen();
+
+		//the textured quad of the blur pass covers the whole target and uses the same vertex shader
+		shader->BindTextureUnsafe(source, 0, RenderingStage::FragmentShader);
+		{
+			Rdata->BlurVertexBuffer->Bind();
+			Rdata->CurrentActiveAPI->Draw(*shader, Primitive::Triangles, 6);
+		}
+
+		Rdata->CurrentActiveAPI->SetViewport(lastViewport);
+		Rdata->CurrentActiveAPI->SetBlendMode(lastBlendMode);
+
+		EndPassUnsafe();
+
+		std::lock_guard lock(Rdata->DataMutex);
+		Rdata->CurrentNumberOfDrawCalls++;
+	}
+
 	void Renderer::SetBlendMode(RenderingBlendMode blendMode)
 	{
 		auto func = [blendMode]()
@@ -1040,6 +1336,14 @@ namespace Ainan {
 			buffer = std::make_shared<OpenGL::OpenGLVertexBuffer>(data, size, layout, dynamic);
 			break;
 
+		case RendererType::Software:
+			buffer = std::make_shared<Software::SoftwareVertexBuffer>(data, size, layout);
+			break;
+
+		case RendererType::Null:
+			buffer = std::make_shared<Null::NullVertexBuffer>(data, size);
+			break;
+
 #ifdef PLATFORM_WINDOWS
 		case RendererType::D3D11:
 			buffer = std::make_shared<D3D11::D3D11VertexBuffer>(data, size, layout, shaderProgram, dynamic, Rdata->CurrentActiveAPI->GetContext());
@@ -1079,9 +1383,19 @@ namespace Ainan {
 			buffer = std::make_shared<OpenGL::OpenGLIndexBuffer>(data, count);
 			break;
 
+		case RendererType::Software:
+			buffer = std::make_shared<Software::SoftwareIndexBuffer>(data, count);
+			break;
+
+		case RendererType::Null:
+			buffer = std::make_shared<Null::NullIndexBuffer>(data, count);
+			break;
+
+#ifdef PLATFORM_WINDOWS
 		case RendererType::D3D11:
 			buffer = std::make_shared<D3D11::D3D11IndexBuffer>(data, count, Rdata->CurrentActiveAPI->GetContext());
 			break;
+#endif // PLATFORM_WINDOWS
 
 		default:
 			assert(false);
@@ -1115,6 +1429,14 @@ namespace Ainan {
 			buffer = std::make_shared<OpenGL::OpenGLUniformBuffer>(name, layout, data);
 			break;
 
+		case RendererType::Software:
+			buffer = std::make_shared<Software::SoftwareUniformBuffer>(name, layout, data);
+			break;
+
+		case RendererType::Null:
+			buffer = std::make_shared<Null::NullUniformBuffer>(name, layout, data);
+			break;
+
 #ifdef PLATFORM_WINDOWS
 		case RendererType::D3D11:
 			buffer = std::make_shared<D3D11::D3D11UniformBuffer>(name, reg, layout, data, Rdata->CurrentActiveAPI->GetContext());
@@ -1136,8 +1458,16 @@ namespace Ainan {
 		case RendererType::OpenGL:
 			return std::make_shared<OpenGL::OpenGLShaderProgram>(vertPath, fragPath);
 
+		case RendererType::Software:
+			return std::make_shared<Software::SoftwareShaderProgram>(vertPath, fragPath);
+
+		case RendererType::Null:
+			return std::make_shared<Null::NullShaderProgram>();
+
+#ifdef PLATFORM_WINDOWS
 		case RendererType::D3D11:
 			return std::make_shared<D3D11::D3D11ShaderProgram>(vertPath, fragPath, Rdata->CurrentActiveAPI->GetContext());
+#endif // PLATFORM_WINDOWS
 
 		default:
 			assert(false);
@@ -1153,6 +1483,15 @@ namespace Ainan {
 		{
 			switch (Rdata->CurrentActiveAPI->GetContext()->GetType())
 			{
+			//raw shaders can't be translated, draws with them are skipped
+			case RendererType::Software:
+				shader = std::make_shared<Software::SoftwareShaderProgram>();
+				break;
+
+			case RendererType::Null:
+				shader = std::make_shared<Null::NullShaderProgram>();
+				break;
+
 			case RendererType::OpenGL:
 				shader = OpenGL::OpenGLShaderProgram::CreateRaw(vertSrc, fragSrc);
 
@@ -1190,6 +1529,14 @@ namespace Ainan {
 		case RendererType::OpenGL:
 			buffer = std::make_shared<OpenGL::OpenGLFrameBuffer>(size);
 			break;
+
+		case RendererType::Software:
+			buffer = std::make_shared<Software::SoftwareFrameBuffer>(size);
+			break;
+
+		case RendererType::Null:
+			buffer = std::make_shared<Null::NullFrameBuffer>(size);
+			break;
 #ifdef PLATFORM_WINDOWS
 
 		case RendererType::D3D11:
@@ -1242,6 +1589,14 @@ namespace Ainan {
 			texture = std::make_shared<OpenGL::OpenGLTexture>(size, format, data);
 			break;
 
+		case RendererType::Software:
+			texture = std::make_shared<Software::SoftwareTexture>(size, format, data);
+			break;
+
+		case RendererType::Null:
+			texture = std::make_shared<Null::NullTexture>(size, format, data);
+			break;
+
 #ifdef PLATFORM_WINDOWS
 		case RendererType::D3D11:
 			texture = std::make_shared<D3D11::D3D11Texture>(size, format, data, Rdata->CurrentActiveAPI->GetContext());
@@ -1260,7 +1615,10 @@ namespace Ainan {
 	{
 		switch (Rdata->CurrentActiveAPI->GetContext()->GetType())
 		{
+		//the software and null renderers follow OpenGL conventions
 		case RendererType::OpenGL:
+		case RendererType::Software:
+		case RendererType::Null:
 		{
 			//these are in clockwise ordering
 			std::array<glm::vec2, 6> openglVertices =
@@ -1310,6 +1668,8 @@ namespace Ainan {
 		switch (Rdata->CurrentActiveAPI->GetContext()->GetType())
 		{
 		case RendererType::OpenGL:
+		case RendererType::Software:
+		case RendererType::Null:
 		{
 			quadVertices =
 			{
@@ -1324,6 +1684,7 @@ namespace Ainan {
 			break;
 		}
 
+#ifdef PLATFORM_WINDOWS
 		case RendererType::D3D11:
 		{
 			quadVertices =
@@ -1338,6 +1699,7 @@ namespace Ainan {
 			};
 			break;
 		}
+#endif // PLATFORM_WINDOWS
 		}
 
 		return quadVertices;
@@ -1345,6 +1707,8 @@ namespace Ainan {
 
 	void Renderer::FlushQuadBatch()
 	{
+		BeginPassUnsafe(RenderPass::QuadBatch);
+
 		for (size_t i = 0; i < Rdata->QuadBatchTextureSlotsUsed; i++)
 			Rdata->ShaderLibrary["QuadBatchShader"]->BindTextureUnsafe(Rdata->QuadBatchTextures[i], i, RenderingStage::FragmentShader);
 
@@ -1367,6 +1731,42 @@ namespace Ainan {
 		//reset data so we can accept the next batch
 		Rdata->QuadBatchVertexBufferDataPtr = Rdata->QuadBatchVertexBufferDataOrigin;
 		Rdata->QuadBatchTextureSlotsUsed = 1;
+
+		EndPassUnsafe();
+	}
+
+	std::string RenderPassStr(RenderPass pass)
+	{
+		switch (pass)
+		{
+		case RenderPass::Clear:
+			return "Clear";
+
+		case RenderPass::QuadBatch:
+			return "Quad Batch";
+
+		case RenderPass::LitSprite:
+			return "Lit Sprites";
+
+		case RenderPass::Blur:
+			return "Blur";
+
+		case RenderPass::YUVConversion:
+			return "YUV Conversion";
+
+		case RenderPass::Grid:
+			return "Grid";
+
+		case RenderPass::Gizmo:
+			return "Gizmo";
+
+		case RenderPass::ImGui:
+			return "ImGui";
+
+		default:
+			assert(false);
+			return "";
+		}
 	}
 
 	std::string RendererTypeStr(RendererType type)
@@ -1378,6 +1778,12 @@ namespace Ainan {
 			return "DirectX 11";
 #endif // PLATFORM_WINDOWS
 
+		case RendererType::Software:
+			return "Software";
+
+		case RendererType::Null:
+			return "Null";
+
 		case RendererType::OpenGL:
 		default:
 			return "OpenGL";
@@ -1394,6 +1800,12 @@ namespace Ainan {
 		if (name == "OpenGL")
 			return RendererType::OpenGL;
 
+		if (name == "Software")
+			return RendererType::Software;
+
+		if (name == "Null")
+			return RendererType::Null;
+
 		assert(false);
 		return RendererType::OpenGL;
 	}
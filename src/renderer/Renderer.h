@@ -10,12 +10,13 @@
 #include "FrameBuffer.h"
 #include "Rectangle.h"
 #include "UniformBuffer.h"
+#include "FramePacer.h"
+#include "TextureLoader.h"
+#include "TextureCache.h"
+#include "ImageWriter.h"
 
 namespace Ainan {
 
-	const int32_t c_ApplicationFramerate = 60;
-	const double c_ApplicationMaxFramePeriod = 1.0 / c_ApplicationFramerate;
-	extern double LastFrameFinishTime;
 	extern double LastFrameDeltaTime;
 
 	//lighting constants
@@ -36,6 +37,38 @@ namespace Ainan {
 		glm::vec2 TextureCoordinates;
 	};
 
+	//swscale shortens its vertical chroma filter for shorter videos, the yuv shader only has the full one
+	const int32_t c_MinGPUYUVConversionHeight = 8;
+
+	//how Renderer::ConvertToYUV420 packs a yuv420p frame into an rgba8 framebuffer, every texel holds 4 bytes of a plane:
+	//the first VideoSize.y rows are the y plane, then come the u and the v planes with two chroma rows in every row,
+	//so the planes can be handed to an encoder as they are read back
+	struct YUV420Layout
+	{
+		YUV420Layout(glm::ivec2 frameSize)
+		{
+			//yuv420 needs an even size
+			VideoSize = glm::ivec2(frameSize.x & ~1, frameSize.y & ~1);
+			//an even number of texels so a chroma row fits in each half of a row
+			int32_t rowTexels = (VideoSize.x + 7) / 8 * 2;
+			int32_t chromaPlaneRows = (VideoSize.y / 2 + 1) / 2;
+			TargetSize = glm::ivec2(rowTexels, VideoSize.y + chromaPlaneRows * 2);
+			LumaStride = rowTexels * 4;
+			ChromaStride = rowTexels * 2;
+			UOffset = (size_t)VideoSize.y * LumaStride;
+			VOffset = UOffset + (size_t)chromaPlaneRows * LumaStride;
+			Size = (size_t)TargetSize.x * TargetSize.y * 4;
+		}
+
+		glm::ivec2 VideoSize;
+		glm::ivec2 TargetSize; //in rgba texels
+		int32_t LumaStride;    //bytes between y rows
+		int32_t ChromaStride;  //bytes between u or v rows
+		size_t UOffset;
+		size_t VOffset;
+		size_t Size;
+	};
+
 	struct SceneDescription
 	{
 		Camera SceneCamera = {};								   //Required
@@ -70,7 +103,10 @@ namespace Ainan {
 	{
 	public:
 		//this initilizes the renderer and starts the rendering thread
-		static void Init(RendererType api);
+		//headless renderers don't need a window and can only draw to framebuffers (OpenGL on linux only),
+		//the Software and Null renderers are always headless,
+		//headlessSurfaceSize is the size of the output they render to and is used instead of the window size to size internal buffers
+		static void Init(RendererType api, bool headless = false, const glm::vec2& headlessSurfaceSize = glm::vec2(1.0f));
 
 		//this terminates the renderer and stops the rendering thread
 		static void Terminate();
@@ -106,11 +142,30 @@ namespace Ainan {
 		static void ClearScreen();
 		static void ClearScreenUnsafe();
 
+		//times everything submitted between them as one pass in the profiler, both on the gpu and on the renderer thread,
+		//a pass started inside another one is counted as part of the outer one
+		static void BeginPass(RenderPass pass);
+		static void EndPass();
+		static void BeginPassUnsafe(RenderPass pass);
+		static void EndPassUnsafe();
+
+		//submits the frame and waits until the next one should start according to the frame pacing mode
 		static void Present();
 
+		//targetFramerate is only used by FramePacingMode::Limited
+		static void SetFramePacing(FramePacingMode mode, int32_t targetFramerate = c_DefaultTargetFramerate);
+		static FrameTimePercentiles GetFrameTimePercentiles();
+
 		static void RecreateSwapchain(const glm::vec2& newSwapchainSize);
 
-		static void PushCommand(std::function<void()> func);
+		//converts source to yuv420 with BT.601 limited range and writes it to target packed as described by YUV420Layout,
+		//target is resized to fit, flipVertically is for sources whose rows are stored bottom to top (OpenGL),
+		//only the OpenGL and D3D11 renderers have the shader for it,
+		//the result is bit-exact with the swscale conversion of VideoEncoder for videos at least c_MinGPUYUVConversionHeight tall
+		static void ConvertToYUV420(std::shared_ptr<FrameBuffer>& source, std::shared_ptr<FrameBuffer>& target, bool flipVertically);
+
+		//commands are dropped while the window is minimized unless runWhenMinimized is true, returns false if func was dropped
+		static bool PushCommand(std::function<void()> func, bool runWhenMinimized = false);
 
 		static void SetBlendMode(RenderingBlendMode blendMode);
 
@@ -134,6 +189,9 @@ namespace Ainan {
 		static std::shared_ptr<ShaderProgram> CreateShaderProgram(const std::string& vertPath, const std::string& fragPath);
 		//this is used when you want to create shaders with source code and not from files
 		static std::shared_ptr<ShaderProgram> CreateShaderProgramRaw(const std::string& vertSrc, const std::string& fragSrc);
+		//compiles the CompileOnInit shaders that use any of the changed files again and swaps them into the ShaderLibrary,
+		//shaders that fail to compile keep their old program, blocks until the renderer thread has done it
+		static void ReloadShaders(const std::vector<std::filesystem::path>& changedFiles);
 
 		static std::shared_ptr<FrameBuffer> CreateFrameBuffer(const glm::vec2& size);
 
@@ -163,6 +221,8 @@ namespace Ainan {
 
 			//scene data
 			RendererAPI* CurrentActiveAPI = nullptr;
+			bool Headless = false;
+			glm::vec2 HeadlessSurfaceSize = glm::vec2(1.0f);
 			SceneDescription CurrentSceneDescription = {};
 			std::unordered_map<std::string, std::shared_ptr<ShaderProgram>> ShaderLibrary;
 			std::shared_ptr<UniformBuffer> SceneUniformbuffer = nullptr;
@@ -205,10 +265,27 @@ namespace Ainan {
 			std::shared_ptr<FrameBuffer> BlurFrameBuffer = nullptr;
 			std::shared_ptr<VertexBuffer> BlurVertexBuffer = nullptr;
 			std::shared_ptr<UniformBuffer> BlurUniformBuffer = nullptr;
+			std::shared_ptr<UniformBuffer> YUVConversionUniformBuffer = nullptr;
 
 			//profiling data
 			uint32_t NumberOfDrawCallsLastScene = 0;
 			uint32_t CurrentNumberOfDrawCalls = 0;
+			//per pass times in milliseconds, the gpu times lag a frame or two behind because they are read without waiting
+			RenderPassTimes GPUPassTimes = {};
+			RenderPassTimes CPUPassTimes = {};
+			RenderPassTimes CurrentCPUPassTimes = {};
+			RenderPass ActivePass = RenderPass::Count;
+			uint32_t PassDepth = 0;
+			std::chrono::high_resolution_clock::time_point ActivePassStart;
+			//how long the renderer thread was executing commands last frame
+			double RenderThreadBusyTime = 0.0;
+			double CurrentRenderThreadBusyTime = 0.0;
+			std::chrono::high_resolution_clock::time_point CommandBatchStart;
+			//how long the main thread waited for the renderer thread to finish the last frame
+			double PresentWaitTime = 0.0;
+
+			//only used by the main thread
+			FramePacer Pacer;
 			//refrences to created objects
 			std::vector<std::weak_ptr<Texture>> ReservedTextures;
 			std::vector<std::weak_ptr<VertexBuffer>> ReservedVertexBuffers;
@@ -235,11 +312,16 @@ namespace Ainan {
 
 		static std::shared_ptr<Texture> CreateTextureUnsafe(const glm::vec2& size, TextureFormat format, uint8_t* data = nullptr);
 
-		static void InternalInit(RendererType api);
+		static void InternalInit(RendererType api, bool headless);
+		//size of the surface the renderer draws to, the window framebuffer or the requested headless output
+		static glm::vec2 GetSurfaceSizeUnsafe();
+		//binds the uniform buffers the renderer owns to a shader from the ShaderLibrary
+		static void BindShaderUniformBuffersUnsafe(const std::string& name, std::shared_ptr<ShaderProgram>& shader);
 		static void RendererThreadLoop();
 		static void InternalTerminate();
 		static void DrawImGui(ImDrawData* drawData);
 		static void Blur(std::shared_ptr<FrameBuffer>& target, float radius);
+		static void ConvertToYUV420Unsafe(std::shared_ptr<FrameBuffer>& source, std::shared_ptr<FrameBuffer>& target, bool flipVertically);
 	};
 
 	struct ImGuiViewportDataGlfw
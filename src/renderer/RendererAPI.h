@@ -30,6 +30,25 @@ namespace Ainan {
 		FragmentShader
 	};
 
+	//parts of the frame that are timed separately by the profiler
+	enum class RenderPass
+	{
+		Clear,
+		QuadBatch,
+		LitSprite,
+		Blur,
+		Grid,
+		Gizmo,
+		ImGui,
+		YUVConversion,
+		Count
+	};
+
+	//defined in Renderer.cpp
+	std::string RenderPassStr(RenderPass pass);
+
+	using RenderPassTimes = std::array<double, (size_t)RenderPass::Count>;
+
 	//pure virtual class (interface) for each renderer api to inherit from
 	class RendererAPI
 	{
@@ -50,12 +69,22 @@ namespace Ainan {
 
 		virtual void Present() = 0;
 
+		//only applies to apis that present to a window
+		virtual void SetVSync(bool enabled) = 0;
+
 		virtual void RecreateSwapchain(const glm::vec2& newSwapchainSize) = 0;
 
 		virtual void SetBlendMode(RenderingBlendMode blendMode) = 0;
 
 		virtual void SetViewport(const Rectangle& viewport) = 0;
 
+		//gpu timers, passes are never nested and can be timed more than once per frame
+		virtual void BeginGPUTimer(RenderPass pass) = 0;
+		virtual void EndGPUTimer() = 0;
+		//called by the renderer thread once per frame after presenting, this must never wait for the gpu
+		//so the times are from the latest frame whose results are ready, returns false if there isn't one
+		virtual bool ResolveGPUTimers(RenderPassTimes& passTimesMs) = 0;
+
 		virtual RendererContext* GetContext() = 0;
 	};
 }
\ No newline at end of file
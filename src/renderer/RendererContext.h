@@ -7,7 +7,11 @@ namespace Ainan {
 #ifdef PLATFORM_WINDOWS
 		D3D11,
 #endif
-		OpenGL
+		OpenGL,
+		//multithreaded cpu rasterizer, always headless
+		Software,
+		//records calls without executing them, for measuring the renderer's cpu overhead, always headless
+		Null
 	};
 
 	//for converting between enum and string
@@ -12,6 +12,9 @@ namespace Ainan {
 	class ShaderProgram
 	{
 	public:
+		//false if the shader failed to compile or link
+		virtual bool IsValid() const = 0;
+
 		virtual void BindUniformBuffer(std::shared_ptr<UniformBuffer>& buffer, uint32_t slot, RenderingStage stage) = 0;
 		virtual void BindTexture(std::shared_ptr<Texture>& texture, uint32_t slot, RenderingStage stage) = 0;
 		virtual void BindTexture(std::shared_ptr<FrameBuffer>& framebuffer, uint32_t slot, RenderingStage stage) = 0;
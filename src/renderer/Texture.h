@@ -3,6 +3,7 @@
 namespace Ainan {
 
 	class Image;
+	struct TextureMipChain;
 
 
 	class Texture {
@@ -17,7 +18,10 @@ namespace Ainan {
 
 	private:
 		virtual void SetImageUnsafe(std::shared_ptr<Image> image) = 0;
+		//uploads every level as is instead of generating the mips on the gpu
+		virtual void SetMipChainUnsafe(std::shared_ptr<TextureMipChain> chain) = 0;
 
 		friend class Renderer;
+		friend class TextureLoader;
 	};
 }
\ No newline at end of file
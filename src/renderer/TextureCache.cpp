@@ -0,0 +1,150 @@
+#include "TextureCache.h"
+
+#include <unordered_set>
+
+namespace Ainan {
+
+	std::mutex TextureCache::s_Mutex;
+	std::unordered_map<std::string, TextureCache::Entry> TextureCache::s_Entries;
+	uint64_t TextureCache::s_AccessCounter = 0;
+	uint64_t TextureCache::s_UnusedBudget = c_DefaultTextureCacheUnusedBudget;
+
+	static std::filesystem::path GetCanonicalPath(const std::filesystem::path& path)
+	{
+		std::error_code error;
+		std::filesystem::path canonicalPath = std::filesystem::weakly_canonical(path, error);
+		if (error)
+			canonicalPath = std::filesystem::absolute(path, error).lexically_normal();
+		return canonicalPath;
+	}
+
+	static std::string GetCacheKey(const std::string& path, TextureFormat desiredFormat, TextureConversion conversion)
+	{
+		std::error_code error;
+		std::filesystem::path canonicalPath = GetCanonicalPath(path);
+
+		//a missing file has no modification time, it still gets cached so it isn't retried every frame
+		int64_t modificationTime = 0;
+		auto writeTime = std::filesystem::last_write_time(canonicalPath, error);
+		if (!error)
+			modificationTime = writeTime.time_since_epoch().count();
+
+		return canonicalPath.u8string() + "|" + std::to_string(modificationTime) +
+			"|" + std::to_string((int32_t)desiredFormat) + "|" + std::to_string((int32_t)conversion);
+	}
+
+	std::shared_ptr<Texture> TextureCache::Get(const std::string& path, TextureFormat desiredFormat, TextureConversion conversion)
+	{
+		std::string key = GetCacheKey(path, desiredFormat, conversion);
+
+		std::lock_guard lock(s_Mutex);
+
+		auto it = s_Entries.find(key);
+		if (it != s_Entries.end())
+		{
+			it->second.LastAccess = ++s_AccessCounter;
+			return it->second.CachedTexture;
+		}
+
+		Entry entry;
+		entry.CachedTexture = TextureLoader::LoadAsync(path, desiredFormat, conversion);
+		entry.LastAccess = ++s_AccessCounter;
+		entry.Path = path;
+		entry.CanonicalPath = GetCanonicalPath(path).u8string();
+		entry.DesiredFormat = desiredFormat;
+		entry.Conversion = conversion;
+		s_Entries[key] = entry;
+
+		//new entries are a good time to trim, that's when memory use grows
+		EvictUnused();
+
+		return entry.CachedTexture;
+	}
+
+	void TextureCache::Reload(const std::vector<std::filesystem::path>& changedFiles)
+	{
+		std::unordered_set<std::string> changedPaths;
+		for (auto& path : changedFiles)
+			changedPaths.insert(GetCanonicalPath(path).u8string());
+
+		std::lock_guard lock(s_Mutex);
+
+		std::vector<std::string> reloadedKeys;
+		for (auto& [key, entry] : s_Entries)
+			if (changedPaths.find(entry.CanonicalPath) != changedPaths.end())
+				reloadedKeys.push_back(key);
+
+		for (const std::string& oldKey : reloadedKeys)
+		{
+			Entry entry = s_Entries[oldKey];
+			TextureLoader::ReloadAsync(entry.CachedTexture, entry.Path, entry.DesiredFormat, entry.Conversion);
+
+			//the key has the modification time in it, keep the entry findable under the new one
+			s_Entries.erase(oldKey);
+			std::string newKey = GetCacheKey(entry.Path, entry.DesiredFormat, entry.Conversion);
+			if (s_Entries.find(newKey) == s_Entries.end())
+				s_Entries[newKey] = entry;
+		}
+
+		if (reloadedKeys.size() > 0)
+			AINAN_LOG_INFO("Reloaded " + std::to_string(reloadedKeys.size()) + " changed textures");
+	}
+
+	void TextureCache::SetUnusedBudget(uint64_t bytes)
+	{
+		std::lock_guard lock(s_Mutex);
+		s_UnusedBudget = bytes;
+		EvictUnused();
+	}
+
+	void TextureCache::Clear()
+	{
+		std::lock_guard lock(s_Mutex);
+		s_Entries.clear();
+	}
+
+	uint32_t TextureCache::GetEntryCount()
+	{
+		std::lock_guard lock(s_Mutex);
+		return (uint32_t)s_Entries.size();
+	}
+
+	uint64_t TextureCache::GetUnusedBytes()
+	{
+		std::lock_guard lock(s_Mutex);
+
+		uint64_t unusedBytes = 0;
+		for (auto& [key, entry] : s_Entries)
+			if (entry.CachedTexture.use_count() == 1)
+				unusedBytes += entry.CachedTexture->GetMemorySize();
+
+		return unusedBytes;
+	}
+
+	void TextureCache::EvictUnused()
+	{
+		//entries only the cache refers to, oldest first
+		std::vector<std::pair<uint64_t, std::string>> unused;
+		uint64_t unusedBytes = 0;
+		for (auto& [key, entry] : s_Entries)
+			if (entry.CachedTexture.use_count() == 1)
+			{
+				unused.push_back({ entry.LastAccess, key });
+				unusedBytes += entry.CachedTexture->GetMemorySize();
+			}
+
+		if (unusedBytes <= s_UnusedBudget)
+			return;
+
+		std::sort(unused.begin(), unused.end());
+		for (auto& [lastAccess, key] : unused)
+		{
+			if (unusedBytes <= s_UnusedBudget)
+				break;
+
+			auto it = s_Entries.find(key);
+			unusedBytes -= it->second.CachedTexture->GetMemorySize();
+			s_Entries.erase(it);
+		}
+	}
+}
\ No newline at end of file
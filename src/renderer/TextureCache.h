@@ -0,0 +1,53 @@
+#pragma once
+
+#include "TextureLoader.h"
+
+namespace Ainan {
+
+	//how many bytes of textures nobody uses anymore are kept around in case they are needed again
+	const uint64_t c_DefaultTextureCacheUnusedBudget = 64 * 1024 * 1024;
+
+	//hands out shared textures so loading the same file again doesn't decode and upload it again,
+	//entries are keyed by the canonical path and the file's modification time so edited files are reloaded,
+	//textures are refcounted by their shared_ptr and when only the cache holds one it is kept
+	//until the unused textures go over the byte budget, then the least recently used are released
+	class TextureCache
+	{
+	public:
+		//loads asynchronously through the TextureLoader on a miss
+		static std::shared_ptr<Texture> Get(const std::string& path, TextureFormat desiredFormat = TextureFormat::Unspecified,
+			TextureConversion conversion = TextureConversion::None);
+
+		//re-uploads the cached textures loaded from any of the files in place, so everything using them sees the new image
+		static void Reload(const std::vector<std::filesystem::path>& changedFiles);
+
+		static void SetUnusedBudget(uint64_t bytes);
+
+		//releases every texture the cache holds, called by the Renderer on termination
+		static void Clear();
+
+		static uint32_t GetEntryCount();
+		static uint64_t GetUnusedBytes();
+
+	private:
+		struct Entry
+		{
+			std::shared_ptr<Texture> CachedTexture;
+			uint64_t LastAccess = 0;
+
+			//what it was loaded from, used to load it again
+			std::string Path;
+			std::string CanonicalPath;
+			TextureFormat DesiredFormat = TextureFormat::Unspecified;
+			TextureConversion Conversion = TextureConversion::None;
+		};
+
+		static void EvictUnused();
+
+	private:
+		static std::mutex s_Mutex;
+		static std::unordered_map<std::string, Entry> s_Entries;
+		static uint64_t s_AccessCounter;
+		static uint64_t s_UnusedBudget;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,253 @@
+#include "TextureDiskCache.h"
+#include "file/AssetManager.h"
+
+namespace Ainan {
+
+	//"ATXC"
+	const uint32_t c_TextureCacheMagic = 0x43585441;
+	//bump when the file layout or the mip generation changes
+	const uint32_t c_TextureCacheVersion = 1;
+	//a 1x1 level is reached way before this for any texture size we can allocate
+	const uint32_t c_MaxTextureCacheMipCount = 32;
+	//the biggest texture d3d11 (and the OpenGL drivers we run on) can create, bigger entries can't be uploaded anyway
+	const int32_t c_MaxTextureCacheSize = 16384;
+
+	struct TextureCacheHeader
+	{
+		uint32_t Magic = c_TextureCacheMagic;
+		uint32_t Version = c_TextureCacheVersion;
+		uint64_t SourceHash = 0;
+		uint32_t Format = 0;
+		uint32_t MipCount = 0;
+	};
+
+	struct TextureCacheLevel
+	{
+		uint64_t Offset = 0; //from the start of the file
+		int32_t Width = 0;
+		int32_t Height = 0;
+	};
+
+	uint64_t TextureMipChain::GetSize() const
+	{
+		uint64_t size = 0;
+		for (auto& level : Levels)
+			size += (uint64_t)level.Width * level.Height * GetBytesPerPixel(Format);
+		return size;
+	}
+
+	//FNV-1a over 8 byte words, the sources can be several megabytes so going byte by byte is too slow
+	uint64_t TextureDiskCache::GetSourceHash(const uint8_t* data, size_t size)
+	{
+		uint64_t hash = 0xcbf29ce484222325;
+		size_t i = 0;
+		for (; i + 8 <= size; i += 8)
+		{
+			uint64_t word;
+			memcpy(&word, data + i, 8);
+			hash ^= word;
+			hash *= 0x100000001b3;
+		}
+		for (; i < size; i++)
+		{
+			hash ^= data[i];
+			hash *= 0x100000001b3;
+		}
+
+		hash ^= size;
+		hash *= 0x100000001b3;
+		return hash;
+	}
+
+	std::shared_ptr<TextureMipChain> TextureDiskCache::Load(const std::filesystem::path& cacheDirectory, uint64_t sourceHash,
+		TextureFormat desiredFormat, TextureConversion conversion)
+	{
+		//goes through the asset manager so entries pre-decoded into a mounted pack are found too
+		auto mapping = std::make_shared<MappedFile>(AssetManager::MapFile(GetEntryPath(cacheDirectory, sourceHash, desiredFormat, conversion)));
+		if (!mapping->IsValid() || mapping->GetSize() < sizeof(TextureCacheHeader))
+			return nullptr;
+
+		TextureCacheHeader header;
+		memcpy(&header, mapping->GetData(), sizeof(TextureCacheHeader));
+		if (header.Magic != c_TextureCacheMagic ||
+			header.Version != c_TextureCacheVersion ||
+			header.SourceHash != sourceHash ||
+			header.Format >= (uint32_t)TextureFormat::Unspecified ||
+			header.MipCount == 0 || header.MipCount > c_MaxTextureCacheMipCount)
+			return nullptr;
+
+		uint64_t levelTableEnd = sizeof(TextureCacheHeader) + header.MipCount * sizeof(TextureCacheLevel);
+		if (mapping->GetSize() < levelTableEnd)
+			return nullptr;
+
+		auto chain = std::make_shared<TextureMipChain>();
+		chain->Format = (TextureFormat)header.Format;
+		chain->Mapping = mapping;
+
+		const uint8_t* levelTable = mapping->GetData() + sizeof(TextureCacheHeader);
+		for (uint32_t i = 0; i < header.MipCount; i++)
+		{
+			TextureCacheLevel level;
+			memcpy(&level, levelTable + i * sizeof(TextureCacheLevel), sizeof(TextureCacheLevel));
+
+			//a truncated or corrupt file is treated as a miss and overwritten,
+			//the sizes are checked before they are multiplied so bogus values can't overflow
+			if (level.Width <= 0 || level.Height <= 0 || level.Width > c_MaxTextureCacheSize || level.Height > c_MaxTextureCacheSize)
+				return nullptr;
+
+			//every level is half the previous one, like GenerateMipChain makes them
+			if (i > 0)
+			{
+				const TextureMipLevel& previous = chain->Levels.back();
+				if (level.Width != std::max(previous.Width / 2, 1) || level.Height != std::max(previous.Height / 2, 1))
+					return nullptr;
+			}
+
+			uint64_t levelSize = (uint64_t)level.Width * level.Height * GetBytesPerPixel(chain->Format);
+			if (level.Offset < levelTableEnd || level.Offset > mapping->GetSize() || levelSize > mapping->GetSize() - level.Offset)
+				return nullptr;
+
+			chain->Levels.push_back({ level.Width, level.Height, mapping->GetData() + level.Offset });
+		}
+
+		return chain;
+	}
+
+	void TextureDiskCache::Save(const std::filesystem::path& cacheDirectory, const TextureMipChain& chain, uint64_t sourceHash,
+		TextureFormat desiredFormat, TextureConversion conversion)
+	{
+		std::error_code err;
+		std::filesystem::create_directories(cacheDirectory, err);
+
+		std::vector<uint8_t> data = Serialize(chain, sourceHash);
+
+		//write to a temporary file first so another thread or a crash can't leave a half written entry behind
+		std::filesystem::path path = GetEntryPath(cacheDirectory, sourceHash, desiredFormat, conversion);
+		std::filesystem::path tempPath = path.string() + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+		FILE* file = fopen(tempPath.string().c_str(), "wb");
+		if (!file)
+		{
+			AINAN_LOG_WARNING("Could not write texture cache entry: " + path.string());
+			return;
+		}
+
+		bool written = fwrite(data.data(), 1, data.size(), file) == data.size();
+		fclose(file);
+
+		if (written)
+			std::filesystem::rename(tempPath, path, err);
+		if (!written || err)
+			std::filesystem::remove(tempPath, err);
+	}
+
+	std::vector<uint8_t> TextureDiskCache::Serialize(const TextureMipChain& chain, uint64_t sourceHash)
+	{
+		TextureCacheHeader header;
+		header.SourceHash = sourceHash;
+		header.Format = (uint32_t)chain.Format;
+		header.MipCount = (uint32_t)chain.Levels.size();
+
+		std::vector<TextureCacheLevel> levels(chain.Levels.size());
+		uint64_t offset = sizeof(TextureCacheHeader) + levels.size() * sizeof(TextureCacheLevel);
+		for (size_t i = 0; i < levels.size(); i++)
+		{
+			levels[i].Offset = offset;
+			levels[i].Width = chain.Levels[i].Width;
+			levels[i].Height = chain.Levels[i].Height;
+			offset += (uint64_t)levels[i].Width * levels[i].Height * GetBytesPerPixel(chain.Format);
+		}
+
+		std::vector<uint8_t> data(offset);
+		memcpy(data.data(), &header, sizeof(TextureCacheHeader));
+		memcpy(data.data() + sizeof(TextureCacheHeader), levels.data(), levels.size() * sizeof(TextureCacheLevel));
+		for (size_t i = 0; i < levels.size(); i++)
+		{
+			size_t levelSize = (size_t)levels[i].Width * levels[i].Height * GetBytesPerPixel(chain.Format);
+			memcpy(data.data() + levels[i].Offset, chain.Levels[i].Data, levelSize);
+		}
+
+		return data;
+	}
+
+	std::shared_ptr<TextureMipChain> TextureDiskCache::GenerateMipChain(const Image& image)
+	{
+		auto chain = std::make_shared<TextureMipChain>();
+		chain->Format = image.Format;
+
+		//allocate every level up front so the pointers into OwnedData stay valid
+		uint32_t bytesPerPixel = GetBytesPerPixel(image.Format);
+		std::vector<TextureMipLevel> levels;
+		std::vector<size_t> offsets;
+		size_t totalSize = 0;
+		int32_t width = image.m_Width;
+		int32_t height = image.m_Height;
+		while (true)
+		{
+			levels.push_back({ width, height, nullptr });
+			offsets.push_back(totalSize);
+			totalSize += (size_t)width * height * bytesPerPixel;
+
+			if (width == 1 && height == 1)
+				break;
+			width = std::max(width / 2, 1);
+			height = std::max(height / 2, 1);
+		}
+
+		chain->OwnedData.resize(totalSize);
+		for (size_t i = 0; i < levels.size(); i++)
+			levels[i].Data = chain->OwnedData.data() + offsets[i];
+
+		memcpy(chain->OwnedData.data(), image.m_Data, (size_t)image.m_Width * image.m_Height * bytesPerPixel);
+
+		//2x2 box filter, when a side is odd or already 1 the last row/column is reused
+		for (size_t i = 1; i < levels.size(); i++)
+		{
+			const TextureMipLevel& source = levels[i - 1];
+			TextureMipLevel& target = levels[i];
+			uint8_t* targetData = chain->OwnedData.data() + offsets[i];
+
+			for (int32_t y = 0; y < target.Height; y++)
+			{
+				int32_t y0 = std::min(y * 2, source.Height - 1);
+				int32_t y1 = std::min(y * 2 + 1, source.Height - 1);
+				for (int32_t x = 0; x < target.Width; x++)
+				{
+					int32_t x0 = std::min(x * 2, source.Width - 1);
+					int32_t x1 = std::min(x * 2 + 1, source.Width - 1);
+					for (uint32_t c = 0; c < bytesPerPixel; c++)
+					{
+						uint32_t sum = source.Data[((size_t)y0 * source.Width + x0) * bytesPerPixel + c] +
+							source.Data[((size_t)y0 * source.Width + x1) * bytesPerPixel + c] +
+							source.Data[((size_t)y1 * source.Width + x0) * bytesPerPixel + c] +
+							source.Data[((size_t)y1 * source.Width + x1) * bytesPerPixel + c];
+						targetData[((size_t)y * target.Width + x) * bytesPerPixel + c] = (uint8_t)((sum + 2) / 4);
+					}
+				}
+			}
+		}
+
+		chain->Levels = std::move(levels);
+		return chain;
+	}
+
+	std::filesystem::path TextureDiskCache::GetCacheDirectory()
+	{
+		if (AssetManager::s_EnvironmentDirectory != "")
+			return AssetManager::s_EnvironmentDirectory / "texture_cache";
+		else
+			return "texture_cache";
+	}
+
+	std::filesystem::path TextureDiskCache::GetEntryPath(const std::filesystem::path& cacheDirectory, uint64_t sourceHash,
+		TextureFormat desiredFormat, TextureConversion conversion)
+	{
+		return cacheDirectory / GetEntryName(sourceHash, desiredFormat, conversion);
+	}
+
+	std::string TextureDiskCache::GetEntryName(uint64_t sourceHash, TextureFormat desiredFormat, TextureConversion conversion)
+	{
+		std::stringstream name;
+		name << std::hex << sourceHash << std::dec << "_" << (int32_t)desiredFormat << "_" << (int32_t)conversion << ".texcache";
+		return name.str();
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Image.h"
+#include "file/MappedFile.h"
+
+namespace Ainan {
+
+	//conversions applied to images after decoding, part of the cache keys because they change the texture
+	enum class TextureConversion
+	{
+		None,
+		GrayScaleToRGB,
+		GrayScaleToRGBA
+	};
+
+	struct TextureMipLevel
+	{
+		int32_t Width = 0;
+		int32_t Height = 0;
+		const uint8_t* Data = nullptr;
+	};
+
+	//a decoded texture with all of its mip levels, level 0 is the full size image,
+	//the levels point either into a memory mapped cache file or into OwnedData
+	struct TextureMipChain
+	{
+		TextureFormat Format = TextureFormat::Unspecified;
+		std::vector<TextureMipLevel> Levels;
+
+		std::shared_ptr<MappedFile> Mapping;
+		std::vector<uint8_t> OwnedData;
+
+		uint64_t GetSize() const;
+	};
+
+	//stores decoded images and their mip chains on disk so loading a texture again only maps a file instead of decoding it,
+	//entries are keyed by a hash of the encoded source file so editing the source invalidates them
+	class TextureDiskCache
+	{
+	public:
+		static uint64_t GetSourceHash(const uint8_t* data, size_t size);
+
+		//returns nullptr if there is no valid entry
+		static std::shared_ptr<TextureMipChain> Load(const std::filesystem::path& cacheDirectory, uint64_t sourceHash,
+			TextureFormat desiredFormat, TextureConversion conversion);
+		static void Save(const std::filesystem::path& cacheDirectory, const TextureMipChain& chain, uint64_t sourceHash,
+			TextureFormat desiredFormat, TextureConversion conversion);
+
+		//the contents of a cache entry, also used to store pre-decoded textures in asset packs
+		static std::vector<uint8_t> Serialize(const TextureMipChain& chain, uint64_t sourceHash);
+		//file name of the entry inside the cache directory
+		static std::string GetEntryName(uint64_t sourceHash, TextureFormat desiredFormat, TextureConversion conversion);
+
+		//box filters the image down to 1x1
+		static std::shared_ptr<TextureMipChain> GenerateMipChain(const Image& image);
+
+		//inside the environment folder if one is open, otherwise in the working directory,
+		//read it on the main thread because it changes when environments are opened
+		static std::filesystem::path GetCacheDirectory();
+
+	private:
+		static std::filesystem::path GetEntryPath(const std::filesystem::path& cacheDirectory, uint64_t sourceHash,
+			TextureFormat desiredFormat, TextureConversion conversion);
+	};
+}
@@ -0,0 +1,206 @@
+#include "TextureLoader.h"
+#include "Renderer.h"
+#include "file/AssetManager.h"
+
+namespace Ainan {
+
+	std::vector<std::thread> TextureLoader::s_WorkerThreads;
+	std::mutex TextureLoader::s_DecodeMutex;
+	std::condition_variable TextureLoader::s_DecodeCV;
+	std::queue<TextureLoader::DecodeJob> TextureLoader::s_DecodeQueue;
+	bool TextureLoader::s_DestroyThreads = false;
+	std::unordered_map<const Texture*, uint64_t> TextureLoader::s_LatestGenerations;
+	uint64_t TextureLoader::s_NextGeneration = 0;
+	std::mutex TextureLoader::s_StagingMutex;
+	std::deque<TextureLoader::StagedImage> TextureLoader::s_StagingQueue;
+	std::atomic<uint32_t> TextureLoader::s_PendingCount = 0;
+
+	void TextureLoader::Init()
+	{
+		//leave a core for the main thread and one for the renderer thread
+		uint32_t threadCount = std::thread::hardware_concurrency();
+		threadCount = std::clamp(threadCount > 2 ? threadCount - 2 : 1, 1u, 4u);
+
+		s_DestroyThreads = false;
+		for (uint32_t i = 0; i < threadCount; i++)
+			s_WorkerThreads.push_back(std::thread(WorkerThreadLoop));
+	}
+
+	void TextureLoader::Terminate()
+	{
+		{
+			std::lock_guard lock(s_DecodeMutex);
+			s_DestroyThreads = true;
+			s_DecodeQueue = {};
+			s_LatestGenerations.clear();
+		}
+		s_DecodeCV.notify_all();
+
+		for (auto& thread : s_WorkerThreads)
+			thread.join();
+		s_WorkerThreads.clear();
+
+		std::lock_guard lock(s_StagingMutex);
+		s_StagingQueue.clear();
+		s_PendingCount = 0;
+	}
+
+	std::shared_ptr<Texture> TextureLoader::LoadAsync(const std::string& path, TextureFormat desiredFormat, TextureConversion conversion)
+	{
+		uint8_t placeholderPixel[4] = { 0, 0, 0, 0 };
+		std::shared_ptr<Texture> texture = Renderer::CreateTexture(glm::vec2(1, 1), TextureFormat::RGBA, placeholderPixel);
+
+		ReloadAsync(texture, path, desiredFormat, conversion);
+
+		return texture;
+	}
+
+	void TextureLoader::ReloadAsync(const std::shared_ptr<Texture>& texture, const std::string& path, TextureFormat desiredFormat,
+		TextureConversion conversion)
+	{
+		s_PendingCount++;
+		{
+			std::lock_guard lock(s_DecodeMutex);
+			uint64_t generation = ++s_NextGeneration;
+			s_LatestGenerations[texture.get()] = generation;
+			s_DecodeQueue.push({ texture, texture.get(), generation, path, desiredFormat, conversion, TextureDiskCache::GetCacheDirectory() });
+		}
+		s_DecodeCV.notify_one();
+	}
+
+	uint32_t TextureLoader::GetPendingCount()
+	{
+		return s_PendingCount;
+	}
+
+	void TextureLoader::Flush()
+	{
+		while (s_PendingCount > 0)
+		{
+			//uploads normally only happen in Present, run them now (even if the window is minimized)
+			Renderer::PushCommand(UploadPendingUnsafe, true);
+			Renderer::WaitUntilRendererIdle();
+
+			//the rest is still being decoded
+			if (s_PendingCount > 0)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	void TextureLoader::UploadPendingUnsafe()
+	{
+		uint64_t uploadedBytes = 0;
+
+		while (uploadedBytes < c_TextureUploadBudgetPerFrame)
+		{
+			StagedImage staged;
+			{
+				std::lock_guard lock(s_StagingMutex);
+				if (s_StagingQueue.empty())
+					break;
+
+				staged = std::move(s_StagingQueue.front());
+				s_StagingQueue.pop_front();
+			}
+
+			//the texture could have been released or reloaded again while its image was being decoded
+			auto texture = staged.Target.lock();
+			if (texture && IsLatestGeneration(staged.Key, staged.Generation))
+			{
+				texture->SetMipChainUnsafe(staged.MipChain);
+				uploadedBytes += staged.MipChain->GetSize();
+			}
+			FinishGeneration(staged.Key, staged.Generation);
+			s_PendingCount--;
+		}
+	}
+
+	void TextureLoader::WorkerThreadLoop()
+	{
+		while (true)
+		{
+			DecodeJob job;
+			{
+				std::unique_lock lock(s_DecodeMutex);
+				s_DecodeCV.wait(lock, []() { return s_DestroyThreads || !s_DecodeQueue.empty(); });
+				if (s_DestroyThreads)
+					break;
+
+				job = std::move(s_DecodeQueue.front());
+				s_DecodeQueue.pop();
+			}
+
+			//don't bother decoding if nobody is waiting for it anymore or a newer request replaces it
+			if (job.Target.expired() || !IsLatestGeneration(job.Key, job.Generation))
+			{
+				FinishGeneration(job.Key, job.Generation);
+				s_PendingCount--;
+				continue;
+			}
+
+			auto chain = LoadMipChain(job);
+			if (!chain)
+			{
+				AINAN_LOG_ERROR("Failed to load texture: " + job.Path);
+				FinishGeneration(job.Key, job.Generation);
+				s_PendingCount--;
+				continue;
+			}
+
+			std::lock_guard lock(s_StagingMutex);
+			s_StagingQueue.push_back({ job.Target, job.Key, job.Generation, chain });
+		}
+	}
+
+	bool TextureLoader::IsLatestGeneration(const Texture* texture, uint64_t generation)
+	{
+		std::lock_guard lock(s_DecodeMutex);
+		auto it = s_LatestGenerations.find(texture);
+		return it != s_LatestGenerations.end() && it->second == generation;
+	}
+
+	void TextureLoader::FinishGeneration(const Texture* texture, uint64_t generation)
+	{
+		std::lock_guard lock(s_DecodeMutex);
+		auto it = s_LatestGenerations.find(texture);
+		if (it != s_LatestGenerations.end() && it->second == generation)
+			s_LatestGenerations.erase(it);
+	}
+
+	std::shared_ptr<TextureMipChain> TextureLoader::LoadMipChain(const DecodeJob& job)
+	{
+		//the source is hashed to find the cache entry, mapping it avoids copying it just to hash and decode it
+		MappedFile source = AssetManager::MapFile(job.Path);
+		if (!source.IsValid())
+			return nullptr;
+
+		uint64_t sourceHash = TextureDiskCache::GetSourceHash(source.GetData(), source.GetSize());
+		auto chain = TextureDiskCache::Load(job.CacheDirectory, sourceHash, job.DesiredFormat, job.Conversion);
+		if (chain)
+			return chain;
+
+		chain = DecodeMipChain(source.GetData(), source.GetSize(), job.DesiredFormat, job.Conversion);
+		if (!chain)
+			return nullptr;
+
+		TextureDiskCache::Save(job.CacheDirectory, *chain, sourceHash, job.DesiredFormat, job.Conversion);
+		return chain;
+	}
+
+	std::shared_ptr<TextureMipChain> TextureLoader::DecodeMipChain(const uint8_t* data, size_t size, TextureFormat desiredFormat, TextureConversion conversion)
+	{
+		Image image = Image::LoadFromMemory(data, size, desiredFormat);
+		if (!image.m_Data)
+			return nullptr;
+
+		if (image.Format == TextureFormat::R)
+		{
+			if (conversion == TextureConversion::GrayScaleToRGB)
+				Image::GrayScaleToRGB(image);
+			else if (conversion == TextureConversion::GrayScaleToRGBA)
+				Image::GrayScaleToRGBA(image);
+		}
+
+		return TextureDiskCache::GenerateMipChain(image);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Texture.h"
+#include "Image.h"
+#include "TextureDiskCache.h"
+
+#include <deque>
+#include <unordered_map>
+
+namespace Ainan {
+
+	//how many bytes of decoded images are uploaded each frame, bigger images are still uploaded but one per frame
+	const uint32_t c_TextureUploadBudgetPerFrame = 16 * 1024 * 1024;
+
+	//loads textures without blocking the calling thread:
+	//images are decoded on a pool of worker threads, then copied into the texture on the renderer thread
+	//a few per frame, until then the texture holds a transparent 1x1 placeholder,
+	//decoded images and their mips are kept in the TextureDiskCache so the next load skips decoding
+	class TextureLoader
+	{
+	public:
+		//called by the Renderer
+		static void Init();
+		static void Terminate();
+
+		//returns a placeholder texture right away, it gets replaced in place by the image once it is loaded
+		//so it is safe to keep using the returned pointer
+		static std::shared_ptr<Texture> LoadAsync(const std::string& path, TextureFormat desiredFormat = TextureFormat::Unspecified,
+			TextureConversion conversion = TextureConversion::None);
+
+		//decodes the file again and replaces the image of an existing texture in place,
+		//the texture keeps its old image if the file can't be decoded,
+		//if the texture is reloaded again before this finishes only the latest request is uploaded
+		static void ReloadAsync(const std::shared_ptr<Texture>& texture, const std::string& path, TextureFormat desiredFormat,
+			TextureConversion conversion);
+
+		//how many textures are still being decoded or waiting to be uploaded
+		static uint32_t GetPendingCount();
+
+		//blocks until every texture requested so far is decoded and uploaded, used before capturing frames
+		//so they don't contain placeholders, must not be called from the renderer thread
+		static void Flush();
+
+		//called by the renderer thread once per frame
+		static void UploadPendingUnsafe();
+
+		//decodes an encoded image and applies the conversion, blocks the calling thread
+		static std::shared_ptr<TextureMipChain> DecodeMipChain(const uint8_t* data, size_t size, TextureFormat desiredFormat,
+			TextureConversion conversion);
+
+	private:
+		struct DecodeJob
+		{
+			std::weak_ptr<Texture> Target;
+			//only used to find the generation, the texture could be released already
+			const Texture* Key;
+			uint64_t Generation;
+			std::string Path;
+			TextureFormat DesiredFormat;
+			TextureConversion Conversion;
+			std::filesystem::path CacheDirectory;
+		};
+
+		struct StagedImage
+		{
+			std::weak_ptr<Texture> Target;
+			const Texture* Key;
+			uint64_t Generation;
+			std::shared_ptr<TextureMipChain> MipChain;
+		};
+
+		static void WorkerThreadLoop();
+		//false if the texture was requested again after this generation, jobs can finish out of order
+		static bool IsLatestGeneration(const Texture* texture, uint64_t generation);
+		//forgets the texture once its latest request is done (uploaded, dropped or failed), does nothing for older generations
+		static void FinishGeneration(const Texture* texture, uint64_t generation);
+		static std::shared_ptr<TextureMipChain> LoadMipChain(const DecodeJob& job);
+
+	private:
+		static std::vector<std::thread> s_WorkerThreads;
+		static std::mutex s_DecodeMutex;
+		static std::condition_variable s_DecodeCV;
+		static std::queue<DecodeJob> s_DecodeQueue;
+		static bool s_DestroyThreads;
+		//latest request of every texture that is still loading, guarded by s_DecodeMutex
+		static std::unordered_map<const Texture*, uint64_t> s_LatestGenerations;
+		static uint64_t s_NextGeneration;
+
+		static std::mutex s_StagingMutex;
+		static std::deque<StagedImage> s_StagingQueue;
+
+		static std::atomic<uint32_t> s_PendingCount;
+	};
+}
\ No newline at end of file
@@ -54,6 +54,13 @@ namespace Ainan {
 			RenderTargetTextureView->Release();
 			RenderTargetView->Release();
 			RenderTargetTexture->Release();
+
+			//readbacks still in flight are dropped and reported as failed
+			for (auto& readback : InFlightReadbacks)
+				readback.Request.OnComplete(false);
+			for (auto stagingTexture : ReadbackStagingTextures)
+				if (stagingTexture)
+					stagingTexture->Release();
 		}
 
 		void D3D11FrameBuffer::Blit(FrameBuffer* otherBuffer, const glm::vec2& sourceSize, const glm::vec2& targetSize)
@@ -123,6 +130,112 @@ namespace Ainan {
 			return img;
 		}
 
+		void D3D11FrameBuffer::ReadPixelsAsyncUnsafe(ReadbackRequest request)
+		{
+			//readbacks complete in order so we can stop at the first one that isn't done
+			while (InFlightReadbacks.size() > 0 && CompleteReadbackUnsafe(InFlightReadbacks.front(), false))
+				InFlightReadbacks.pop_front();
+
+			//every staging texture is in use, wait for the oldest one
+			if (InFlightReadbacks.size() == c_ReadbackRingSize)
+			{
+				CompleteReadbackUnsafe(InFlightReadbacks.front(), true);
+				InFlightReadbacks.pop_front();
+			}
+
+			//FrameBuffer::ReadPixelsAsync already makes sure the rectangle is inside the framebuffer
+			if (request.X < 0 || request.Y < 0 || request.X + request.Width > (int32_t)Size.x || request.Y + request.Height > (int32_t)Size.y)
+			{
+				request.OnComplete(false);
+				return;
+			}
+
+			//the next texture in the ring is always the free one because they are used and completed in the same order
+			uint32_t index = NextReadbackStagingTexture;
+			NextReadbackStagingTexture = (NextReadbackStagingTexture + 1) % c_ReadbackRingSize;
+
+			ID3D11Texture2D*& stagingTexture = ReadbackStagingTextures[index];
+			if (stagingTexture)
+			{
+				D3D11_TEXTURE2D_DESC currentDesc{};
+				stagingTexture->GetDesc(&currentDesc);
+				if (currentDesc.Width != (UINT)request.Width || currentDesc.Height != (UINT)request.Height)
+				{
+					stagingTexture->Release();
+					stagingTexture = nullptr;
+				}
+			}
+
+			if (!stagingTexture)
+			{
+				D3D11_TEXTURE2D_DESC desc{};
+				desc.Width = request.Width;
+				desc.Height = request.Height;
+				desc.SampleDesc.Count = 1;
+				desc.Usage = D3D11_USAGE_STAGING;
+				desc.BindFlags = 0;
+				desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+				desc.ArraySize = 1;
+				desc.MipLevels = 1;
+				desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+
+				ASSERT_D3D_CALL(Context->Device->CreateTexture2D(&desc, nullptr, &stagingTexture));
+			}
+
+			if (request.X == 0 && request.Y == 0 && request.Width == (int32_t)Size.x && request.Height == (int32_t)Size.y)
+				Context->DeviceContext->CopyResource(stagingTexture, RenderTargetTexture);
+			else
+			{
+				//d3d11 rows go top to bottom, the origin is the bottom left pixel
+				D3D11_BOX box{};
+				box.left = request.X;
+				box.right = request.X + request.Width;
+				box.top = (UINT)Size.y - (request.Y + request.Height);
+				box.bottom = (UINT)Size.y - request.Y;
+				box.front = 0;
+				box.back = 1;
+				Context->DeviceContext->CopySubresourceRegion(stagingTexture, 0, 0, 0, 0, RenderTargetTexture, 0, &box);
+			}
+
+			PendingReadback readback;
+			readback.StagingTexture = stagingTexture;
+			readback.Request = std::move(request);
+			InFlightReadbacks.push_back(std::move(readback));
+		}
+
+		void D3D11FrameBuffer::FlushReadbacksUnsafe()
+		{
+			while (InFlightReadbacks.size() > 0)
+			{
+				CompleteReadbackUnsafe(InFlightReadbacks.front(), true);
+				InFlightReadbacks.pop_front();
+			}
+		}
+
+		bool D3D11FrameBuffer::CompleteReadbackUnsafe(PendingReadback& readback, bool wait)
+		{
+			D3D11_MAPPED_SUBRESOURCE resource{};
+			HRESULT result = Context->DeviceContext->Map(readback.StagingTexture, 0, D3D11_MAP_READ, wait ? 0 : D3D11_MAP_FLAG_DO_NOT_WAIT, &resource);
+			if (result == DXGI_ERROR_WAS_STILL_DRAWING)
+				return false;
+
+			auto& request = readback.Request;
+			if (result == S_OK)
+			{
+				const uint8_t* srcPtr = (const uint8_t*)resource.pData;
+				const uint32_t unpaddedRowSize = request.Width * 4;
+				for (int32_t row = 0; row < request.Height; row++)
+					memcpy(request.Target + (size_t)row * unpaddedRowSize, srcPtr + (size_t)row * resource.RowPitch, unpaddedRowSize);
+
+				Context->DeviceContext->Unmap(readback.StagingTexture, 0);
+			}
+			else
+				AINAN_LOG_ERROR("Could not map framebuffer readback texture");
+
+			request.OnComplete(result == S_OK);
+			return true;
+		}
+
 		void D3D11FrameBuffer::Bind() const
 		{
 			auto func = [this]()
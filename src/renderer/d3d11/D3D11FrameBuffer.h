@@ -4,6 +4,7 @@
 #include "renderer/FrameBuffer.h"
 
 #include <d3d11.h>
+#include <deque>
 
 namespace Ainan {
 	namespace D3D11 {
@@ -20,6 +21,8 @@ namespace Ainan {
 			virtual void BindUnsafe() const override;
 			virtual void Resize(const glm::vec2& newSize) override;
 			virtual void ResizeUnsafe(const glm::vec2& newSize) override;
+			virtual void ReadPixelsAsyncUnsafe(ReadbackRequest request) override;
+			virtual void FlushReadbacksUnsafe() override;
 
 			virtual glm::vec2 GetSize() const override { return Size; };
 			virtual void* GetTextureID() override { return RenderTargetTextureView; };
@@ -31,6 +34,21 @@ namespace Ainan {
 			ID3D11SamplerState* RenderTargetTextureSampler;
 			ID3D11RenderTargetView* RenderTargetView;
 			glm::vec2 Size;
+
+		private:
+			struct PendingReadback
+			{
+				ID3D11Texture2D* StagingTexture = nullptr;
+				ReadbackRequest Request;
+			};
+
+			//returns false if wait is false and the gpu isn't done with the copy yet
+			bool CompleteReadbackUnsafe(PendingReadback& readback, bool wait);
+
+			//CopyResource to a staging texture returns right away, the copy to memory happens once it can be mapped
+			std::array<ID3D11Texture2D*, c_ReadbackRingSize> ReadbackStagingTextures = {};
+			uint32_t NextReadbackStagingTexture = 0;
+			std::deque<PendingReadback> InFlightReadbacks;
 		};
 	}
 }
\ No newline at end of file
@@ -229,6 +229,16 @@ namespace Ainan {
 			if (g_pFactory) { g_pFactory->Release(); g_pFactory = NULL; }
 			if (g_pd3dDevice) { g_pd3dDevice->Release(); g_pd3dDevice = NULL; }
 			if (g_pd3dDeviceContext) { g_pd3dDeviceContext->Release(); g_pd3dDeviceContext = NULL; }
+			for (auto& frame : TimerFrames)
+			{
+				if (frame.Disjoint)
+					frame.Disjoint->Release();
+				for (auto& queries : frame.Queries)
+				{
+					queries.first->Release();
+					queries.second->Release();
+				}
+			}
 			AdditiveBlendMode->Release();
 			ScreenBlendMode->Release();
 			OverlayBlendMode->Release();
@@ -531,7 +541,9 @@ namespace Ainan {
 
 			auto func2 = [this]()
 			{
+				Renderer::BeginPassUnsafe(RenderPass::ImGui);
 				DrawImGui(ImGui::GetDrawData());
+				Renderer::EndPassUnsafe();
 			};
 
 			Renderer::PushCommand(func2);
@@ -1044,10 +1056,97 @@ namespace Ainan {
 
 		void D3D11RendererAPI::Present()
 		{
-			Context.Swapchain->Present(1, 0);
+			Context.Swapchain->Present(SyncInterval, 0);
 			Context.DeviceContext->OMSetRenderTargets(1, &Context.BackbufferView, nullptr);
 		}
 
+		void D3D11RendererAPI::BeginGPUTimer(RenderPass pass)
+		{
+			TimerFrame& frame = TimerFrames[CurrentTimerFrame];
+
+			if (!frame.Disjoint)
+			{
+				D3D11_QUERY_DESC desc = {};
+				desc.Query = D3D11_QUERY_TIMESTAMP_DISJOINT;
+				ASSERT_D3D_CALL(Context.Device->CreateQuery(&desc, &frame.Disjoint));
+			}
+
+			if (!frame.DisjointActive)
+			{
+				Context.DeviceContext->Begin(frame.Disjoint);
+				frame.DisjointActive = true;
+			}
+
+			if (frame.UsedCount == frame.Queries.size())
+			{
+				D3D11_QUERY_DESC desc = {};
+				desc.Query = D3D11_QUERY_TIMESTAMP;
+				std::pair<ID3D11Query*, ID3D11Query*> queries;
+				ASSERT_D3D_CALL(Context.Device->CreateQuery(&desc, &queries.first));
+				ASSERT_D3D_CALL(Context.Device->CreateQuery(&desc, &queries.second));
+				frame.Queries.push_back(queries);
+				frame.Passes.push_back(pass);
+			}
+
+			frame.Passes[frame.UsedCount] = pass;
+			//timestamp queries only use End
+			Context.DeviceContext->End(frame.Queries[frame.UsedCount].first);
+		}
+
+		void D3D11RendererAPI::EndGPUTimer()
+		{
+			TimerFrame& frame = TimerFrames[CurrentTimerFrame];
+			Context.DeviceContext->End(frame.Queries[frame.UsedCount].second);
+			frame.UsedCount++;
+		}
+
+		bool D3D11RendererAPI::ResolveGPUTimers(RenderPassTimes& passTimesMs)
+		{
+			TimerFrame& currentFrame = TimerFrames[CurrentTimerFrame];
+			if (currentFrame.DisjointActive)
+			{
+				Context.DeviceContext->End(currentFrame.Disjoint);
+				currentFrame.DisjointActive = false;
+			}
+
+			//the other set has the previous frame, which has had a whole frame to finish
+			CurrentTimerFrame = (CurrentTimerFrame + 1) % TimerFrames.size();
+			TimerFrame& frame = TimerFrames[CurrentTimerFrame];
+
+			if (frame.UsedCount == 0)
+				return false;
+
+			uint32_t usedCount = frame.UsedCount;
+			frame.UsedCount = 0;
+
+			//never wait for the results, if they aren't ready this frame's timings are dropped
+			D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjointData;
+			if (Context.DeviceContext->GetData(frame.Disjoint, &disjointData, sizeof(disjointData), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+				return false;
+			if (disjointData.Disjoint)
+				return false;
+
+			RenderPassTimes times = {};
+			for (uint32_t i = 0; i < usedCount; i++)
+			{
+				uint64_t start = 0;
+				uint64_t end = 0;
+				if (Context.DeviceContext->GetData(frame.Queries[i].first, &start, sizeof(start), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK ||
+					Context.DeviceContext->GetData(frame.Queries[i].second, &end, sizeof(end), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+					return false;
+
+				times[(size_t)frame.Passes[i]] += (end - start) * 1000.0 / disjointData.Frequency;
+			}
+
+			passTimesMs = times;
+			return true;
+		}
+
+		void D3D11RendererAPI::SetVSync(bool enabled)
+		{
+			SyncInterval = enabled ? 1 : 0;
+		}
+
 		void D3D11RendererAPI::RecreateSwapchain(const glm::vec2& newSwapchainSize)
 		{
 			Context.DeviceContext->OMSetRenderTargets(0, nullptr, nullptr);
@@ -24,6 +24,7 @@ namespace Ainan {
 			virtual void DrawImGui(ImDrawData* drawData) override;
 			virtual void ClearScreen() override;
 			virtual void Present() override;
+			virtual void SetVSync(bool enabled) override;
 			virtual void RecreateSwapchain(const glm::vec2& newSwapchainSize) override;
 			virtual void SetViewport(const Rectangle& viewport) override;
 			virtual RendererContext* GetContext() override { return &Context; };
@@ -31,12 +32,30 @@ namespace Ainan {
 			virtual void SetRenderTargetApplicationWindow() override;
 			virtual void ImGuiNewFrame() override;
 			virtual void ImGuiEndFrame() override;
+			virtual void BeginGPUTimer(RenderPass pass) override;
+			virtual void EndGPUTimer() override;
+			virtual bool ResolveGPUTimers(RenderPassTimes& passTimesMs) override;
+
+		private:
+			//timestamp queries for each pass, double buffered by frame so results are read a frame later without stalling,
+			//the disjoint query tells us the timestamp frequency and whether the timestamps of the frame can be trusted
+			struct TimerFrame
+			{
+				ID3D11Query* Disjoint = nullptr;
+				bool DisjointActive = false;
+				std::vector<std::pair<ID3D11Query*, ID3D11Query*>> Queries;
+				std::vector<RenderPass> Passes;
+				uint32_t UsedCount = 0;
+			};
+			std::array<TimerFrame, 2> TimerFrames;
+			uint32_t CurrentTimerFrame = 0;
 
 		public:
 			D3D11RendererContext Context;
 			ID3D11BlendState* AdditiveBlendMode;
 			ID3D11BlendState* ScreenBlendMode;
 			ID3D11BlendState* OverlayBlendMode;
+			UINT SyncInterval = 1;
 		};
 
 	}
@@ -7,6 +7,7 @@
 #define ASSERT_D3D_CALL(func) { auto result = func; if (result != S_OK) assert(false); }
 
 #include "renderer/Renderer.h"
+#include "file/AssetManager.h"
 
 namespace Ainan {
 	namespace D3D11 {
@@ -15,49 +16,33 @@ namespace Ainan {
 			assert(context->GetType() == RendererType::D3D11);
 			Context = (D3D11RendererContext*)context;
 
-			//load batch renderer shader
-			uint8_t* fragmentByteCode = nullptr;
-			uint32_t fragmentByteCodeSize = 0;
+			//load batch renderer shader, the vertex byte code stays mapped because input layouts are created from it
+			m_VertexByteCodeFile = AssetManager::MapFile(vertPath + "_vs.cso");
+			MappedFile fragmentByteCodeFile = AssetManager::MapFile(fragPath + "_fs.cso");
+			if (!m_VertexByteCodeFile.IsValid() || !fragmentByteCodeFile.IsValid())
 			{
-				FILE* file = nullptr;
-				auto err = fopen_s(&file, (vertPath + "_vs.cso").c_str(), "rb");
-				if (err != 0 || !file)
-					assert(false);
-
-				fseek(file, 0, SEEK_END);
-				VertexByteCodeSize = ftell(file);
-				fseek(file, 0, SEEK_SET);
-
-				VertexByteCode = new uint8_t[VertexByteCodeSize];
-				fread(VertexByteCode, VertexByteCodeSize, 1, file);
-				fclose(file);
-			}
-			{
-				FILE* file = nullptr;
-				auto err = fopen_s(&file, (fragPath + "_fs.cso").c_str(), "rb");
-				if (err != 0)
-					assert(false);
-
-				fseek(file, 0, SEEK_END);
-				fragmentByteCodeSize = ftell(file);
-				fseek(file, 0, SEEK_SET);
-
-				fragmentByteCode = new uint8_t[fragmentByteCodeSize];
-				fread(fragmentByteCode, fragmentByteCodeSize, 1, file);
-				fclose(file);
+				AINAN_LOG_ERROR("Cannot read compiled shader: " + vertPath + "_vs.cso or " + fragPath + "_fs.cso");
+				return;
 			}
 
-			ASSERT_D3D_CALL(Context->Device->CreateVertexShader(VertexByteCode, VertexByteCodeSize, 0, &VertexShader));
-			ASSERT_D3D_CALL(Context->Device->CreatePixelShader(fragmentByteCode, fragmentByteCodeSize, 0, &FragmentShader));
+			VertexByteCode = m_VertexByteCodeFile.GetData();
+			VertexByteCodeSize = (uint32_t)m_VertexByteCodeFile.GetSize();
 
-			delete[] fragmentByteCode;
+			//invalid byte code leaves the shader invalid instead of asserting, it can come from a shader that is being rebuilt
+			if (Context->Device->CreateVertexShader(VertexByteCode, VertexByteCodeSize, 0, &VertexShader) != S_OK)
+				VertexShader = nullptr;
+			if (Context->Device->CreatePixelShader(fragmentByteCodeFile.GetData(), fragmentByteCodeFile.GetSize(), 0, &FragmentShader) != S_OK)
+				FragmentShader = nullptr;
+			if (!IsValid())
+				AINAN_LOG_ERROR("Invalid shader byte code: " + vertPath + "_vs.cso or " + fragPath + "_fs.cso");
 		}
 
 		D3D11ShaderProgram::~D3D11ShaderProgram()
 		{
-			delete[] VertexByteCode;
-			VertexShader->Release();
-			FragmentShader->Release();
+			if (VertexShader)
+				VertexShader->Release();
+			if (FragmentShader)
+				FragmentShader->Release();
 		}
 
 		void D3D11ShaderProgram::BindUniformBuffer(std::shared_ptr<UniformBuffer>& buffer, uint32_t slot, RenderingStage stage)
@@ -2,6 +2,7 @@
 
 #include "renderer/ShaderProgram.h"
 #include "renderer/RendererAPI.h"
+#include "file/MappedFile.h"
 
 #include <d3d11.h>
 
@@ -15,6 +16,8 @@ namespace Ainan {
 			D3D11ShaderProgram(const std::string& vertPath, const std::string& fragPath, RendererContext* context);
 			virtual ~D3D11ShaderProgram();
 
+			virtual bool IsValid() const override { return VertexShader != nullptr && FragmentShader != nullptr; }
+
 			virtual void BindUniformBuffer(std::shared_ptr<UniformBuffer>& buffer, uint32_t slot, RenderingStage stage) override;
 			virtual void BindUniformBufferUnsafe(std::shared_ptr<UniformBuffer>& buffer, uint32_t slot, RenderingStage stage) override;
 
@@ -26,12 +29,15 @@ namespace Ainan {
 
 		public:
 			D3D11RendererContext* Context;
-			ID3D11VertexShader* VertexShader;
-			ID3D11PixelShader* FragmentShader;
+			ID3D11VertexShader* VertexShader = nullptr;
+			ID3D11PixelShader* FragmentShader = nullptr;
 
-			//this is needed for creating vertex buffers
-			uint8_t* VertexByteCode = nullptr;
+			//this is needed for creating vertex buffers, it points into m_VertexByteCodeFile
+			const uint8_t* VertexByteCode = nullptr;
 			uint32_t VertexByteCodeSize = 0;
+
+		private:
+			MappedFile m_VertexByteCodeFile;
 		};
 	}
 }
\ No newline at end of file
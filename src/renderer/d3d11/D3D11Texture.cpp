@@ -5,6 +5,7 @@
 
 #include "renderer/Image.h"
 #include "renderer/Renderer.h"
+#include "renderer/TextureDiskCache.h"
 
 namespace Ainan {
 	namespace D3D11 {
@@ -134,5 +135,41 @@ namespace Ainan {
 
 			ASSERT_D3D_CALL(Context->Device->CreateShaderResourceView(D3DTexture, &viewDesc, &D3DResourceView));
 		}
+
+		void D3D11Texture::SetMipChainUnsafe(std::shared_ptr<TextureMipChain> chain)
+		{
+			D3DTexture->Release();
+			D3DResourceView->Release();
+
+			uint32_t bytesPerPixel = GetBytesPerPixel(chain->Format);
+
+			//mips can't be dynamic, these textures are only ever replaced as a whole so they don't need to be
+			D3D11_TEXTURE2D_DESC desc{};
+			desc.Width = chain->Levels[0].Width;
+			desc.Height = chain->Levels[0].Height;
+			desc.Format = D3DFormat(chain->Format);
+			desc.SampleDesc.Count = 1;
+			desc.Usage = D3D11_USAGE_DEFAULT;
+			desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+			desc.ArraySize = 1;
+			desc.MipLevels = (UINT)chain->Levels.size();
+
+			std::vector<D3D11_SUBRESOURCE_DATA> subresources(chain->Levels.size());
+			for (size_t i = 0; i < chain->Levels.size(); i++)
+			{
+				subresources[i].pSysMem = chain->Levels[i].Data;
+				subresources[i].SysMemPitch = chain->Levels[i].Width * bytesPerPixel;
+			}
+			ASSERT_D3D_CALL(Context->Device->CreateTexture2D(&desc, subresources.data(), &D3DTexture));
+
+			m_AllocatedGPUMem = (uint32_t)chain->GetSize();
+
+			D3D11_SHADER_RESOURCE_VIEW_DESC viewDesc{};
+			viewDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+			viewDesc.Texture2D.MipLevels = desc.MipLevels;
+			viewDesc.Format = desc.Format;
+
+			ASSERT_D3D_CALL(Context->Device->CreateShaderResourceView(D3DTexture, &viewDesc, &D3DResourceView));
+		}
 	}
 }
\ No newline at end of file
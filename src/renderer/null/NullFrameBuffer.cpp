@@ -0,0 +1,77 @@
+#include "NullFrameBuffer.h"
+#include "NullRendererAPI.h"
+
+#include "renderer/Renderer.h"
+
+namespace Ainan {
+	namespace Null {
+
+		NullFrameBuffer::NullFrameBuffer(const glm::vec2& size) :
+			m_Size(size)
+		{
+			NullRendererAPI::Singleton().Stats.ResourcesCreated++;
+		}
+
+		void NullFrameBuffer::Bind() const
+		{
+			auto func = [this]()
+			{
+				BindUnsafe();
+			};
+			Renderer::PushCommand(func);
+		}
+
+		void NullFrameBuffer::BindUnsafe() const
+		{
+			NullRendererAPI::Singleton().Stats.RenderTargetChanges++;
+		}
+
+		void NullFrameBuffer::Resize(const glm::vec2& newSize)
+		{
+			auto func = [this, newSize]()
+			{
+				ResizeUnsafe(newSize);
+			};
+			Renderer::PushCommand(func);
+		}
+
+		void NullFrameBuffer::ResizeUnsafe(const glm::vec2& newSize)
+		{
+			m_Size = newSize;
+		}
+
+		Image NullFrameBuffer::ReadPixels(glm::vec2 bottomLeftPixel, glm::vec2 topRightPixel)
+		{
+			Image image;
+			auto func = [this, &image]
+			{
+				//callers expect an image of the right size, its contents are just black
+				image.m_Width = (uint32_t)m_Size.x;
+				image.m_Height = (uint32_t)m_Size.y;
+				image.m_Data = new uint8_t[image.m_Width * image.m_Height * 4]();
+				image.Format = TextureFormat::RGBA;
+
+				NullRendererAPI::Singleton().Stats.BytesReadBack += image.m_Width * image.m_Height * 4;
+			};
+
+			Renderer::PushCommand(func);
+			Renderer::WaitUntilRendererIdle();
+			return image;
+		}
+
+		void NullFrameBuffer::ReadPixelsAsyncUnsafe(ReadbackRequest request)
+		{
+			size_t size = (size_t)request.Width * request.Height * 4;
+			memset(request.Target, 0, size);
+			NullRendererAPI::Singleton().Stats.BytesReadBack += size;
+
+			request.OnComplete(true);
+		}
+
+		void NullFrameBuffer::FlushReadbacksUnsafe()
+		{}
+
+		void NullFrameBuffer::Blit(FrameBuffer* otherBuffer, const glm::vec2& sourceSize, const glm::vec2& targetSize)
+		{}
+	}
+}
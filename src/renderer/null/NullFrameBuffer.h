@@ -0,0 +1,33 @@
+#pragma once
+
+#include "renderer/Texture.h"
+#include "renderer/FrameBuffer.h"
+
+namespace Ainan {
+	namespace Null {
+
+		class NullFrameBuffer : public FrameBuffer
+		{
+		public:
+			NullFrameBuffer(const glm::vec2& size);
+
+			virtual void Blit(FrameBuffer* otherBuffer, const glm::vec2& sourceSize, const glm::vec2& targetSize) override;
+			virtual Image ReadPixels(glm::vec2 bottomLeftPixel = { 0,0 }, glm::vec2 topRightPixel = { 0,0 }) override;
+
+			virtual glm::vec2 GetSize() const override { return m_Size; }
+			virtual void Resize(const glm::vec2& newSize) override;
+			virtual void ResizeUnsafe(const glm::vec2& newSize) override;
+			//only used to tell framebuffers apart
+			virtual void* GetTextureID() override { return this; };
+
+			virtual void Bind() const override;
+			virtual void BindUnsafe() const override;
+
+			virtual void ReadPixelsAsyncUnsafe(ReadbackRequest request) override;
+			virtual void FlushReadbacksUnsafe() override;
+
+		public:
+			glm::vec2 m_Size = { 0.0f, 0.0f };
+		};
+	}
+}
@@ -0,0 +1,16 @@
+#include "NullIndexBuffer.h"
+#include "NullRendererAPI.h"
+
+namespace Ainan {
+	namespace Null {
+
+		NullIndexBuffer::NullIndexBuffer(uint32_t* data, uint32_t count) :
+			m_Count(count)
+		{
+			auto& stats = NullRendererAPI::Singleton().Stats;
+			stats.ResourcesCreated++;
+			if (data)
+				stats.IndexBytesUploaded += count * sizeof(uint32_t);
+		}
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "renderer/IndexBuffer.h"
+
+namespace Ainan {
+	namespace Null {
+
+		class NullIndexBuffer : public IndexBuffer
+		{
+		public:
+			NullIndexBuffer(uint32_t* data, uint32_t count);
+
+			// Inherited via IndexBuffer
+			virtual uint32_t GetCount() const override { return m_Count; };
+			virtual uint32_t GetUsedMemory() const override { return m_Count * sizeof(uint32_t); };
+			virtual void Bind() const override {};
+			virtual void Unbind() const override {};
+
+		private:
+			uint32_t m_Count;
+		};
+	}
+}
@@ -0,0 +1,94 @@
+#include "NullRendererAPI.h"
+
+namespace Ainan {
+	namespace Null {
+
+		NullRendererAPI* NullRendererAPI::SingletonInstance = nullptr;
+
+		NullRendererAPI::NullRendererAPI()
+		{
+			SingletonInstance = this;
+		}
+
+		NullRendererAPI::~NullRendererAPI()
+		{
+			SingletonInstance = nullptr;
+		}
+
+		void NullRendererAPI::Draw(ShaderProgram& shader, Primitive primitive, uint32_t vertexCount)
+		{
+			Stats.DrawCalls++;
+			Stats.VerticesDrawn += vertexCount;
+		}
+
+		void NullRendererAPI::Draw(ShaderProgram& shader, Primitive primitive, const IndexBuffer& indexBuffer)
+		{
+			Stats.DrawCalls++;
+			Stats.IndexedDrawCalls++;
+			Stats.VerticesDrawn += indexBuffer.GetCount();
+		}
+
+		void NullRendererAPI::Draw(ShaderProgram& shader, Primitive primitive, const IndexBuffer& indexBuffer, uint32_t vertexCount)
+		{
+			Stats.DrawCalls++;
+			Stats.IndexedDrawCalls++;
+			Stats.VerticesDrawn += vertexCount;
+		}
+
+		//there is no ImGui without a window
+		void NullRendererAPI::InitImGui()
+		{}
+
+		void NullRendererAPI::ImGuiNewFrame()
+		{}
+
+		void NullRendererAPI::ImGuiEndFrame()
+		{}
+
+		void NullRendererAPI::DrawImGui(ImDrawData* drawData)
+		{}
+
+		void NullRendererAPI::ClearScreen()
+		{
+			Stats.Clears++;
+		}
+
+		void NullRendererAPI::Present()
+		{
+			Stats.Presents++;
+		}
+
+		void NullRendererAPI::SetVSync(bool enabled)
+		{}
+
+		void NullRendererAPI::RecreateSwapchain(const glm::vec2& newSwapchainSize)
+		{}
+
+		void NullRendererAPI::SetRenderTargetApplicationWindow()
+		{
+			Stats.RenderTargetChanges++;
+		}
+
+		void NullRendererAPI::SetViewport(const Rectangle& viewport)
+		{
+			Stats.ViewportChanges++;
+		}
+
+		void NullRendererAPI::SetBlendMode(RenderingBlendMode blendMode)
+		{
+			Stats.BlendModeChanges++;
+		}
+
+		//nothing runs on a gpu so there is nothing to time
+		void NullRendererAPI::BeginGPUTimer(RenderPass pass)
+		{}
+
+		void NullRendererAPI::EndGPUTimer()
+		{}
+
+		bool NullRendererAPI::ResolveGPUTimers(RenderPassTimes& passTimesMs)
+		{
+			return false;
+		}
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "renderer/RendererAPI.h"
+#include "renderer/ShaderProgram.h"
+#include "renderer/IndexBuffer.h"
+#include "renderer/VertexBuffer.h"
+#include "renderer/Rectangle.h"
+
+#include "NullRendererContext.h"
+
+namespace Ainan {
+	namespace Null {
+
+		//everything the null renderer was asked to do,
+		//only written by the renderer thread so call Renderer::WaitUntilRendererIdle before reading it
+		struct NullRendererStats
+		{
+			//api calls
+			uint64_t DrawCalls = 0;
+			uint64_t IndexedDrawCalls = 0;
+			uint64_t VerticesDrawn = 0; //vertex count for non indexed draws and index count for indexed ones
+			uint64_t Clears = 0;
+			uint64_t Presents = 0;
+			uint64_t BlendModeChanges = 0;
+			uint64_t ViewportChanges = 0;
+			uint64_t RenderTargetChanges = 0;
+
+			//resource bindings
+			uint64_t VertexBufferBinds = 0;
+			uint64_t TextureBinds = 0;
+			uint64_t UniformBufferBinds = 0;
+
+			//data volume in bytes
+			uint64_t VertexBytesUploaded = 0;
+			uint64_t IndexBytesUploaded = 0;
+			uint64_t UniformBytesUploaded = 0;
+			uint64_t TextureBytesUploaded = 0;
+			uint64_t BytesReadBack = 0;
+
+			uint64_t ResourcesCreated = 0;
+		};
+
+		//accepts every call and records it without doing any work,
+		//used to measure the cpu cost of the Renderer itself (command queue, batching, uniform packing)
+		class NullRendererAPI : public RendererAPI
+		{
+		public:
+			NullRendererAPI();
+			virtual ~NullRendererAPI();
+
+			// Inherited via RendererAPI
+			virtual void Draw(ShaderProgram& shader, Primitive primitive, uint32_t vertexCount) override;
+			virtual void Draw(ShaderProgram& shader, Primitive primitive, const IndexBuffer& indexBuffer) override;
+			virtual void Draw(ShaderProgram& shader, Primitive primitive, const IndexBuffer& indexBuffer, uint32_t vertexCount) override;
+			virtual void InitImGui() override;
+			virtual void ImGuiNewFrame() override;
+			virtual void ImGuiEndFrame() override;
+			virtual void DrawImGui(ImDrawData* drawData) override;
+			virtual void ClearScreen() override;
+			virtual void Present() override;
+			virtual void SetVSync(bool enabled) override;
+			virtual void RecreateSwapchain(const glm::vec2& newSwapchainSize) override;
+			virtual void SetRenderTargetApplicationWindow() override;
+
+			virtual void SetViewport(const Rectangle& viewport) override;
+
+			virtual RendererContext* GetContext() override { return &Context; };
+
+			virtual void SetBlendMode(RenderingBlendMode blendMode) override;
+
+			virtual void BeginGPUTimer(RenderPass pass) override;
+			virtual void EndGPUTimer() override;
+			virtual bool ResolveGPUTimers(RenderPassTimes& passTimesMs) override;
+
+			NullRendererContext Context;
+			NullRendererStats Stats;
+
+			static NullRendererAPI& Singleton() { assert(SingletonInstance); return *SingletonInstance; };
+
+		private:
+			static NullRendererAPI* SingletonInstance;
+		};
+	}
+}
@@ -0,0 +1,20 @@
+#include "NullRendererContext.h"
+
+namespace Ainan {
+	namespace Null {
+		RendererType NullRendererContext::GetType() const
+		{
+			return RendererType::Null;
+		}
+
+		std::string NullRendererContext::GetVersionString()
+		{
+			return "1.0";
+		}
+
+		std::string NullRendererContext::GetPhysicalDeviceName()
+		{
+			return "None";
+		}
+	}
+}
\ No newline at end of file
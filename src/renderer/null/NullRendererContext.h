@@ -0,0 +1,14 @@
+#pragma once
+
+#include "renderer/RendererContext.h"
+
+namespace Ainan {
+	namespace Null {
+		class NullRendererContext : public RendererContext
+		{
+			virtual RendererType GetType() const override;
+			virtual std::string GetVersionString() override;
+			virtual std::string GetPhysicalDeviceName() override;
+		};
+	}
+}
\ No newline at end of file
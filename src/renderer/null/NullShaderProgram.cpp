@@ -0,0 +1,51 @@
+#include "NullShaderProgram.h"
+#include "NullRendererAPI.h"
+
+#include "renderer/Renderer.h"
+
+namespace Ainan {
+	namespace Null {
+
+		void NullShaderProgram::BindUniformBuffer(std::shared_ptr<UniformBuffer>& buffer, uint32_t slot, RenderingStage stage)
+		{
+			auto func = [this, &buffer, slot, stage]()
+			{
+				BindUniformBufferUnsafe(buffer, slot, stage);
+			};
+			Renderer::PushCommand(func);
+		}
+
+		void NullShaderProgram::BindUniformBufferUnsafe(std::shared_ptr<UniformBuffer>& buffer, uint32_t slot, RenderingStage stage)
+		{
+			NullRendererAPI::Singleton().Stats.UniformBufferBinds++;
+		}
+
+		void NullShaderProgram::BindTexture(std::shared_ptr<Texture>& texture, uint32_t slot, RenderingStage stage)
+		{
+			auto func = [this, slot, stage, &texture]()
+			{
+				BindTextureUnsafe(texture, slot, stage);
+			};
+			Renderer::PushCommand(func);
+		}
+
+		void NullShaderProgram::BindTextureUnsafe(std::shared_ptr<Texture>& texture, uint32_t slot, RenderingStage stage)
+		{
+			NullRendererAPI::Singleton().Stats.TextureBinds++;
+		}
+
+		void NullShaderProgram::BindTexture(std::shared_ptr<FrameBuffer>& framebuffer, uint32_t slot, RenderingStage stage)
+		{
+			auto func = [this, slot, stage, &framebuffer]()
+			{
+				BindTextureUnsafe(framebuffer, slot, stage);
+			};
+			Renderer::PushCommand(func);
+		}
+
+		void NullShaderProgram::BindTextureUnsafe(std::shared_ptr<FrameBuffer>& framebuffer, uint32_t slot, RenderingStage stage)
+		{
+			NullRendererAPI::Singleton().Stats.TextureBinds++;
+		}
+	}
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "renderer/ShaderProgram.h"
+#include "renderer/UniformBuffer.h"
+
+namespace Ainan {
+	namespace Null {
+
+		class NullShaderProgram : public ShaderProgram
+		{
+		public:
+			virtual bool IsValid() const override { return true; }
+
+			virtual void BindUniformBuffer(std::shared_ptr<UniformBuffer>& buffer, uint32_t slot, RenderingStage stage) override;
+			virtual void BindUniformBufferUnsafe(std::shared_ptr<UniformBuffer>& buffer, uint32_t slot, RenderingStage stage) override;
+
+			virtual void BindTexture(std::shared_ptr<Texture>& texture, uint32_t slot, RenderingStage stage) override;
+			virtual void BindTextureUnsafe(std::shared_ptr<Texture>& texture, uint32_t slot, RenderingStage stage) override;
+
+			virtual void BindTexture(std::shared_ptr<FrameBuffer>& framebuffer, uint32_t slot, RenderingStage stage) override;
+			virtual void BindTextureUnsafe(std::shared_ptr<FrameBuffer>& framebuffer, uint32_t slot, RenderingStage stage) override;
+		};
+	}
+}
@@ -0,0 +1,39 @@
+#include "NullTexture.h"
+#include "NullRendererAPI.h"
+#include "renderer/Renderer.h"
+#include "renderer/TextureDiskCache.h"
+
+namespace Ainan {
+	namespace Null {
+
+		NullTexture::NullTexture(const glm::vec2& size, TextureFormat format, uint8_t* data) :
+			m_Memory((uint32_t)(size.x * size.y) * GetBytesPerPixel(format))
+		{
+			auto& stats = NullRendererAPI::Singleton().Stats;
+			stats.ResourcesCreated++;
+			if (data)
+				stats.TextureBytesUploaded += m_Memory;
+		}
+
+		void NullTexture::SetImage(std::shared_ptr<Image> image)
+		{
+			auto func = [this, image]()
+			{
+				SetImageUnsafe(image);
+			};
+			Renderer::PushCommand(func);
+		}
+
+		void NullTexture::SetImageUnsafe(std::shared_ptr<Image> image)
+		{
+			m_Memory = image->m_Width * image->m_Height * GetBytesPerPixel(image->Format);
+			NullRendererAPI::Singleton().Stats.TextureBytesUploaded += m_Memory;
+		}
+
+		void NullTexture::SetMipChainUnsafe(std::shared_ptr<TextureMipChain> chain)
+		{
+			m_Memory = (uint32_t)chain->GetSize();
+			NullRendererAPI::Singleton().Stats.TextureBytesUploaded += m_Memory;
+		}
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "renderer/Texture.h"
+#include "renderer/Image.h"
+
+namespace Ainan {
+	namespace Null {
+
+		class NullTexture : public Texture
+		{
+		public:
+			NullTexture(const glm::vec2& size, TextureFormat format, uint8_t* data = nullptr);
+
+			virtual void SetImage(std::shared_ptr<Image> image) override;
+			virtual void SetImageUnsafe(std::shared_ptr<Image> image) override;
+			virtual void SetMipChainUnsafe(std::shared_ptr<TextureMipChain> chain) override;
+
+			virtual uint32_t GetMemorySize() const override { return m_Memory; };
+			//only used to tell textures apart
+			virtual void* GetTextureID() override           { return this; };
+
+		private:
+			uint32_t m_Memory = 0;
+		};
+	}
+}
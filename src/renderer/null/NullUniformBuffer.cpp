@@ -0,0 +1,43 @@
+#include "NullUniformBuffer.h"
+#include "NullRendererAPI.h"
+
+#include <numeric>
+
+namespace Ainan {
+	namespace Null {
+
+		NullUniformBuffer::NullUniformBuffer(const std::string& name, const VertexLayout& layout, void* data) :
+			m_Name(name)
+		{
+			m_PackedSize = std::accumulate(layout.begin(), layout.end(), 0,
+				[](const uint32_t& a, const VertexLayoutElement& b)
+				{
+					return a + b.GetSize();
+				});
+
+			auto& stats = NullRendererAPI::Singleton().Stats;
+			stats.ResourcesCreated++;
+			if (data)
+				stats.UniformBytesUploaded += m_PackedSize;
+		}
+
+		void NullUniformBuffer::UpdateData(void* data)
+		{
+			//copied like the real backends do so the queueing cost is the same
+			void* dataCpy = new uint8_t[m_PackedSize];
+			memcpy(dataCpy, data, m_PackedSize);
+
+			auto func = [this, dataCpy]()
+			{
+				UpdateDataUnsafe(dataCpy);
+				delete[](uint8_t*)dataCpy;
+			};
+			Renderer::PushCommand(func);
+		}
+
+		void NullUniformBuffer::UpdateDataUnsafe(void* data)
+		{
+			NullRendererAPI::Singleton().Stats.UniformBytesUploaded += m_PackedSize;
+		}
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "renderer/UniformBuffer.h"
+#include "renderer/VertexBuffer.h"//for VertexLayout
+#include "renderer/Renderer.h"
+
+namespace Ainan {
+	namespace Null {
+
+		class NullUniformBuffer : public UniformBuffer
+		{
+		public:
+			NullUniformBuffer(const std::string& name, const VertexLayout& layout, void* data);
+
+			virtual void UpdateData(void* data) override;
+			virtual void UpdateDataUnsafe(void* data) override;
+
+			virtual std::string GetName() const override { return m_Name; };
+			virtual uint32_t GetPackedSize() const override { return m_PackedSize; };
+			virtual uint32_t GetAlignedSize() const override { return m_PackedSize; };
+
+		public:
+			uint32_t m_PackedSize = 0;
+			std::string m_Name = "";
+		};
+	}
+}
@@ -0,0 +1,40 @@
+#include "NullVertexBuffer.h"
+#include "NullRendererAPI.h"
+
+namespace Ainan {
+	namespace Null {
+
+		NullVertexBuffer::NullVertexBuffer(void* data, uint32_t size) :
+			Memory(size)
+		{
+			auto& stats = NullRendererAPI::Singleton().Stats;
+			stats.ResourcesCreated++;
+			if (data)
+				stats.VertexBytesUploaded += size;
+		}
+
+		void NullVertexBuffer::Bind() const
+		{
+			NullRendererAPI::Singleton().Stats.VertexBufferBinds++;
+		}
+
+		void NullVertexBuffer::Unbind() const
+		{}
+
+		void NullVertexBuffer::UpdateData(int32_t offset, int32_t size, void* data)
+		{
+			auto func = [this, offset, size, data]()
+			{
+				UpdateDataUnsafe(offset, size, data);
+			};
+
+			Renderer::PushCommand(func);
+			Renderer::WaitUntilRendererIdle();
+		}
+
+		void NullVertexBuffer::UpdateDataUnsafe(int32_t offset, int32_t size, void* data)
+		{
+			NullRendererAPI::Singleton().Stats.VertexBytesUploaded += size;
+		}
+	}
+}
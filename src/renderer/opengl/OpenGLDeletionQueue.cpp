@@ -0,0 +1,118 @@
+#include "OpenGLDeletionQueue.h"
+
+namespace Ainan {
+	namespace OpenGL {
+
+		std::mutex OpenGLDeletionQueue::s_Mutex;
+		OpenGLDeletionQueue::FrameBatch OpenGLDeletionQueue::s_CurrentFrame;
+		std::deque<OpenGLDeletionQueue::FrameBatch> OpenGLDeletionQueue::s_InFlightFrames;
+		uint64_t OpenGLDeletionQueue::s_FrameIndex = 0;
+
+		void OpenGLDeletionQueue::Push(OpenGLResourceType type, uint32_t rendererID)
+		{
+			if (rendererID == 0)
+				return;
+
+			std::lock_guard lock(s_Mutex);
+			s_CurrentFrame.IDs[(size_t)type].push_back(rendererID);
+		}
+
+		void OpenGLDeletionQueue::EndFrame()
+		{
+			std::lock_guard lock(s_Mutex);
+
+			//fence the resources released during this frame
+			bool hasResources = false;
+			for (auto& ids : s_CurrentFrame.IDs)
+				if (ids.size() > 0)
+					hasResources = true;
+
+			if (hasResources)
+			{
+				s_CurrentFrame.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+				s_CurrentFrame.FrameIndex = s_FrameIndex;
+				s_InFlightFrames.push_back(std::move(s_CurrentFrame));
+				s_CurrentFrame = FrameBatch();
+			}
+			s_FrameIndex++;
+
+			//frames complete in order so we can stop at the first one that isn't done
+			while (s_InFlightFrames.size() > 0)
+			{
+				FrameBatch& batch = s_InFlightFrames.front();
+				GLenum result = glClientWaitSync(batch.Fence, 0, 0);
+				if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+					break;
+
+				DeleteBatch(batch);
+				s_InFlightFrames.pop_front();
+			}
+		}
+
+		void OpenGLDeletionQueue::Flush()
+		{
+			std::lock_guard lock(s_Mutex);
+
+			bool hasResources = s_InFlightFrames.size() > 0;
+			for (auto& ids : s_CurrentFrame.IDs)
+				if (ids.size() > 0)
+					hasResources = true;
+
+			if (!hasResources)
+				return;
+
+			glFinish();
+			while (s_InFlightFrames.size() > 0)
+			{
+				DeleteBatch(s_InFlightFrames.front());
+				s_InFlightFrames.pop_front();
+			}
+			DeleteBatch(s_CurrentFrame);
+		}
+
+		uint32_t OpenGLDeletionQueue::GetPendingCount()
+		{
+			std::lock_guard lock(s_Mutex);
+
+			uint32_t count = 0;
+			for (auto& ids : s_CurrentFrame.IDs)
+				count += (uint32_t)ids.size();
+			for (auto& batch : s_InFlightFrames)
+				for (auto& ids : batch.IDs)
+					count += (uint32_t)ids.size();
+
+			return count;
+		}
+
+		void OpenGLDeletionQueue::DeleteBatch(FrameBatch& batch)
+		{
+			//one delete call per resource type instead of one per object
+			auto& buffers = batch.IDs[(size_t)OpenGLResourceType::Buffer];
+			if (buffers.size() > 0)
+				glDeleteBuffers((GLsizei)buffers.size(), buffers.data());
+
+			auto& vertexArrays = batch.IDs[(size_t)OpenGLResourceType::VertexArray];
+			if (vertexArrays.size() > 0)
+				glDeleteVertexArrays((GLsizei)vertexArrays.size(), vertexArrays.data());
+
+			auto& textures = batch.IDs[(size_t)OpenGLResourceType::Texture];
+			if (textures.size() > 0)
+				glDeleteTextures((GLsizei)textures.size(), textures.data());
+
+			auto& frameBuffers = batch.IDs[(size_t)OpenGLResourceType::FrameBuffer];
+			if (frameBuffers.size() > 0)
+				glDeleteFramebuffers((GLsizei)frameBuffers.size(), frameBuffers.data());
+
+			//programs don't have a batched delete function
+			for (auto& program : batch.IDs[(size_t)OpenGLResourceType::Program])
+				glDeleteProgram(program);
+
+			if (batch.Fence)
+				glDeleteSync(batch.Fence);
+
+			for (auto& ids : batch.IDs)
+				ids.clear();
+			batch.Fence = nullptr;
+		}
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <deque>
+
+namespace Ainan {
+	namespace OpenGL {
+
+		enum class OpenGLResourceType
+		{
+			Buffer,
+			VertexArray,
+			Texture,
+			FrameBuffer,
+			Program,
+			Count
+		};
+
+		//GPU objects are not deleted right away because commands that were already submitted might still be using them,
+		//instead they are batched per frame and deleted together once the fence of that frame is signaled
+		class OpenGLDeletionQueue
+		{
+		public:
+			//can be called from any thread
+			static void Push(OpenGLResourceType type, uint32_t rendererID);
+
+			//called by the renderer thread after the frame is presented, fences the resources released this frame
+			//and deletes the resources of previous frames that the GPU is done with
+			static void EndFrame();
+
+			//called by the renderer thread on termination, waits for the GPU to finish everything (glFinish) and deletes it all
+			static void Flush();
+
+			static uint32_t GetPendingCount();
+
+		private:
+			struct FrameBatch
+			{
+				std::array<std::vector<uint32_t>, (size_t)OpenGLResourceType::Count> IDs;
+				GLsync Fence = nullptr;
+				uint64_t FrameIndex = 0;
+			};
+
+			static void DeleteBatch(FrameBatch& batch);
+
+		private:
+			static std::mutex s_Mutex;
+			static FrameBatch s_CurrentFrame;
+			static std::deque<FrameBatch> s_InFlightFrames;
+			static uint64_t s_FrameIndex;
+		};
+	}
+}
@@ -1,6 +1,7 @@
 #include <glad/glad.h>
 
 #include "OpenGLFrameBuffer.h"
+#include "OpenGLDeletionQueue.h"
 
 #include "renderer/Renderer.h"
 
@@ -28,8 +29,28 @@ namespace Ainan {
 
 		OpenGLFrameBuffer::~OpenGLFrameBuffer()
 		{
-			glDeleteFramebuffers(1, &m_RendererID);
-			glDeleteTextures(1, &m_TextureID);
+			OpenGLDeletionQueue::Push(OpenGLResourceType::FrameBuffer, m_RendererID);
+			OpenGLDeletionQueue::Push(OpenGLResourceType::Texture, m_TextureID);
+			for (uint32_t pixelBuffer : m_PixelBuffers)
+				OpenGLDeletionQueue::Push(OpenGLResourceType::Buffer, pixelBuffer);
+
+			//readbacks still in flight are dropped and reported as failed
+			if (m_InFlightReadbacks.size() > 0)
+			{
+				std::vector<GLsync> fences;
+				for (auto& readback : m_InFlightReadbacks)
+				{
+					fences.push_back((GLsync)readback.Fence);
+					readback.Request.OnComplete(false);
+				}
+
+				auto func = [fences]()
+				{
+					for (GLsync fence : fences)
+						glDeleteSync(fence);
+				};
+				Renderer::PushCommand(func, true);
+			}
 		}
 
 		void OpenGLFrameBuffer::Bind() const
@@ -88,6 +109,84 @@ namespace Ainan {
 			return image;
 		}
 
+		void OpenGLFrameBuffer::ReadPixelsAsyncUnsafe(ReadbackRequest request)
+		{
+			//readbacks complete in order so we can stop at the first one that isn't done
+			while (m_InFlightReadbacks.size() > 0 && CompleteReadbackUnsafe(m_InFlightReadbacks.front(), false))
+				m_InFlightReadbacks.pop_front();
+
+			//every buffer is in use, wait for the oldest one
+			if (m_InFlightReadbacks.size() == c_ReadbackRingSize)
+			{
+				CompleteReadbackUnsafe(m_InFlightReadbacks.front(), true);
+				m_InFlightReadbacks.pop_front();
+			}
+
+			//the next buffer in the ring is always the free one because they are used and completed in the same order
+			uint32_t index = m_NextPixelBuffer;
+			m_NextPixelBuffer = (m_NextPixelBuffer + 1) % c_ReadbackRingSize;
+
+			uint32_t size = (uint32_t)request.Width * request.Height * 4;
+			if (m_PixelBuffers[index] == 0)
+				glGenBuffers(1, &m_PixelBuffers[index]);
+
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, m_PixelBuffers[index]);
+			if (m_PixelBufferSizes[index] != size)
+			{
+				glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+				m_PixelBufferSizes[index] = size;
+			}
+
+			BindUnsafe();
+			//with a pixel pack buffer bound the last parameter is an offset into it instead of a pointer
+			glReadPixels(request.X, request.Y, request.Width, request.Height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+			PendingReadback readback;
+			readback.PixelBuffer = m_PixelBuffers[index];
+			readback.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			readback.Request = std::move(request);
+			m_InFlightReadbacks.push_back(std::move(readback));
+		}
+
+		void OpenGLFrameBuffer::FlushReadbacksUnsafe()
+		{
+			while (m_InFlightReadbacks.size() > 0)
+			{
+				CompleteReadbackUnsafe(m_InFlightReadbacks.front(), true);
+				m_InFlightReadbacks.pop_front();
+			}
+		}
+
+		bool OpenGLFrameBuffer::CompleteReadbackUnsafe(PendingReadback& readback, bool wait)
+		{
+			//1 second, only reached if the gpu hangs
+			const uint64_t c_ReadbackTimeout = 1000000000;
+
+			GLsync fence = (GLsync)readback.Fence;
+			GLenum result = glClientWaitSync(fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? c_ReadbackTimeout : 0);
+			if (!wait && result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+				return false;
+
+			glDeleteSync(fence);
+			readback.Fence = nullptr;
+
+			size_t size = (size_t)readback.Request.Width * readback.Request.Height * 4;
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.PixelBuffer);
+			void* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+			if (pixels)
+			{
+				memcpy(readback.Request.Target, pixels, size);
+				glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+			}
+			else
+				AINAN_LOG_ERROR("Could not map framebuffer readback buffer");
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+			readback.Request.OnComplete(pixels != nullptr);
+			return true;
+		}
+
 		void OpenGLFrameBuffer::Blit(FrameBuffer* otherBuffer, const glm::vec2& sourceSize, const glm::vec2& targetSize)
 		{
 			OpenGLFrameBuffer* targetBuffer = (OpenGLFrameBuffer*)otherBuffer;
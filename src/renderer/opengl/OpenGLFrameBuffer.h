@@ -3,6 +3,8 @@
 #include "renderer/Texture.h"
 #include "renderer/FrameBuffer.h"
 
+#include <deque>
+
 namespace Ainan {
 	namespace OpenGL {
 
@@ -22,10 +24,32 @@ namespace Ainan {
 
 			virtual void Bind() const override;
 			virtual void BindUnsafe() const override;
+
+			virtual void ReadPixelsAsyncUnsafe(ReadbackRequest request) override;
+			virtual void FlushReadbacksUnsafe() override;
+
+		private:
+			struct PendingReadback
+			{
+				uint32_t PixelBuffer = 0;
+				void* Fence = nullptr; //GLsync, glad isn't included here because it has to come before any other gl header
+				ReadbackRequest Request;
+			};
+
+			//returns false if wait is false and the gpu isn't done with the readback yet
+			bool CompleteReadbackUnsafe(PendingReadback& readback, bool wait);
+
 		public:
 			uint32_t m_RendererID = 0;
 			uint32_t m_TextureID = 0;
 			glm::vec2 m_Size = { 0.0f, 0.0f };
+
+		private:
+			//glReadPixels into a pixel buffer object returns right away, the copy to memory happens once the fence is signaled
+			std::array<uint32_t, c_ReadbackRingSize> m_PixelBuffers = {};
+			std::array<uint32_t, c_ReadbackRingSize> m_PixelBufferSizes = {};
+			uint32_t m_NextPixelBuffer = 0;
+			std::deque<PendingReadback> m_InFlightReadbacks;
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,167 @@
+#include <glad/glad.h>
+
+#include "OpenGLHeadlessRendererAPI.h"
+#include "OpenGLDeletionQueue.h"
+
+#define EGL_NO_X11
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+namespace Ainan {
+	namespace OpenGL {
+
+		static bool HasExtension(const char* extensions, const char* name)
+		{
+			if (!extensions)
+				return false;
+
+			size_t nameLength = strlen(name);
+			const char* location = extensions;
+			while ((location = strstr(location, name)) != nullptr)
+			{
+				//make sure we didn't match the prefix of a longer extension name
+				if (location[nameLength] == ' ' || location[nameLength] == '\0')
+					return true;
+				location += nameLength;
+			}
+			return false;
+		}
+
+		OpenGLHeadlessRendererAPI::OpenGLHeadlessRendererAPI() :
+			OpenGLRendererAPI(NoWindowContext())
+		{
+			EGLDisplay display = EGL_NO_DISPLAY;
+
+			//the surfaceless platform doesn't need a display server or a gpu
+			const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+			auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+			if (getPlatformDisplay && HasExtension(clientExtensions, "EGL_MESA_platform_surfaceless"))
+				display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+
+			if (display == EGL_NO_DISPLAY)
+				display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+			EGLint major = 0, minor = 0;
+			if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor))
+			{
+				AINAN_LOG_FATAL("Failed to initialize an EGL display for headless rendering");
+				return;
+			}
+			m_Display = display;
+
+			if (!eglBindAPI(EGL_OPENGL_API))
+			{
+				AINAN_LOG_FATAL("EGL display does not support desktop OpenGL");
+				return;
+			}
+
+			bool surfaceless = HasExtension(eglQueryString(display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+
+			const EGLint configAttributes[] =
+			{
+				EGL_SURFACE_TYPE, surfaceless ? 0 : EGL_PBUFFER_BIT,
+				EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+				EGL_RED_SIZE, 8,
+				EGL_GREEN_SIZE, 8,
+				EGL_BLUE_SIZE, 8,
+				EGL_ALPHA_SIZE, 8,
+				EGL_NONE
+			};
+
+			EGLConfig config = nullptr;
+			EGLint configCount = 0;
+			if (!eglChooseConfig(display, configAttributes, &config, 1, &configCount) || configCount == 0)
+			{
+				AINAN_LOG_FATAL("No suitable EGL config found for headless rendering");
+				return;
+			}
+
+			//same version and profile as the window context
+			const EGLint contextAttributes[] =
+			{
+				EGL_CONTEXT_MAJOR_VERSION, 3,
+				EGL_CONTEXT_MINOR_VERSION, 3,
+				EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+#ifndef NDEBUG
+				EGL_CONTEXT_OPENGL_DEBUG, EGL_TRUE,
+#endif // !NDEBUG
+				EGL_NONE
+			};
+
+			EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+			if (context == EGL_NO_CONTEXT)
+			{
+				AINAN_LOG_FATAL("Failed to create a headless OpenGL context");
+				return;
+			}
+			m_Context = context;
+
+			EGLSurface surface = EGL_NO_SURFACE;
+			if (!surfaceless)
+			{
+				//we never draw to it, it only exists so the context can be made current
+				const EGLint surfaceAttributes[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+				surface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+				m_Surface = surface;
+			}
+
+			if (!eglMakeCurrent(display, surface, surface, context))
+			{
+				AINAN_LOG_FATAL("Failed to make the headless OpenGL context current");
+				return;
+			}
+
+			LoadOpenGL((GLADloadproc)eglGetProcAddress);
+			Context.Headless = true;
+		}
+
+		OpenGLHeadlessRendererAPI::~OpenGLHeadlessRendererAPI()
+		{
+			//resources have to be released while our context is still alive
+			ReleaseResources();
+
+			if (m_Display)
+			{
+				eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+				if (m_Surface)
+					eglDestroySurface(m_Display, m_Surface);
+				if (m_Context)
+					eglDestroyContext(m_Display, m_Context);
+				eglTerminate(m_Display);
+			}
+		}
+
+		//there is no ImGui in headless mode
+		void OpenGLHeadlessRendererAPI::InitImGui()
+		{}
+
+		void OpenGLHeadlessRendererAPI::ImGuiNewFrame()
+		{}
+
+		void OpenGLHeadlessRendererAPI::ImGuiEndFrame()
+		{}
+
+		void OpenGLHeadlessRendererAPI::DrawImGui(ImDrawData* drawData)
+		{}
+
+		void OpenGLHeadlessRendererAPI::Present()
+		{
+			//nothing to swap, just make sure the frame gets submitted
+			glFlush();
+			OpenGLDeletionQueue::EndFrame();
+		}
+
+		//there is no swapchain to sync
+		void OpenGLHeadlessRendererAPI::SetVSync(bool enabled)
+		{}
+
+		void OpenGLHeadlessRendererAPI::RecreateSwapchain(const glm::vec2& newSwapchainSize)
+		{}
+
+		void OpenGLHeadlessRendererAPI::SetRenderTargetApplicationWindow()
+		{
+			//there is no default framebuffer in a surfaceless context
+			AINAN_LOG_WARNING("Headless renderer has no application window, draw to a FrameBuffer instead");
+		}
+	}
+}
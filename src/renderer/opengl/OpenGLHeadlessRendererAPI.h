@@ -0,0 +1,34 @@
+#pragma once
+
+#include "OpenGLRendererAPI.h"
+
+namespace Ainan {
+	namespace OpenGL {
+
+		//renders without a window through an offscreen EGL context (surfaceless if available, otherwise a pbuffer),
+		//everything has to be drawn to FrameBuffer objects and ImGui is not available,
+		//works with software drivers like mesa's llvmpipe so it can run on machines without a gpu
+		class OpenGLHeadlessRendererAPI : public OpenGLRendererAPI
+		{
+		public:
+			OpenGLHeadlessRendererAPI();
+			virtual ~OpenGLHeadlessRendererAPI();
+
+			virtual void InitImGui() override;
+			virtual void ImGuiNewFrame() override;
+			virtual void ImGuiEndFrame() override;
+			virtual void DrawImGui(ImDrawData* drawData) override;
+			virtual void Present() override;
+			virtual void SetVSync(bool enabled) override;
+			virtual void RecreateSwapchain(const glm::vec2& newSwapchainSize) override;
+			virtual void SetRenderTargetApplicationWindow() override;
+
+		private:
+			//EGL handles are stored as void* so this header doesn't pull in the EGL headers
+			void* m_Display = nullptr;
+			void* m_Context = nullptr;
+			//only used when the driver doesn't support surfaceless contexts
+			void* m_Surface = nullptr;
+		};
+	}
+}
@@ -1,6 +1,7 @@
 #include <glad/glad.h>
 
 #include "OpenGLIndexBuffer.h"
+#include "OpenGLDeletionQueue.h"
 
 namespace Ainan {
 	namespace OpenGL {
@@ -16,7 +17,7 @@ namespace Ainan {
 
 		OpenGLIndexBuffer::~OpenGLIndexBuffer()
 		{
-			glDeleteBuffers(1, &m_RendererID);
+			OpenGLDeletionQueue::Push(OpenGLResourceType::Buffer, m_RendererID);
 		}
 
 		void OpenGLIndexBuffer::Bind() const
@@ -6,6 +6,7 @@
 #include "OpenGLShaderProgram.h"
 #include "OpenGLVertexBuffer.h"
 #include "OpenGLIndexBuffer.h"
+#include "OpenGLDeletionQueue.h"
 
 namespace Ainan {
 	namespace OpenGL {
@@ -33,7 +34,16 @@ namespace Ainan {
 		OpenGLRendererAPI::OpenGLRendererAPI()
 		{
 			glfwMakeContextCurrent(Window::Ptr);
-			gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
+			LoadOpenGL((GLADloadproc)glfwGetProcAddress);
+		}
+
+		OpenGLRendererAPI::OpenGLRendererAPI(NoWindowContext)
+		{
+		}
+
+		void OpenGLRendererAPI::LoadOpenGL(GLADloadproc loader)
+		{
+			gladLoadGLLoader(loader);
 #ifndef NDEBUG
 			glDebugMessageCallback(&opengl_debug_message_callback, nullptr);
 #endif // DEBUG
@@ -46,17 +56,31 @@ namespace Ainan {
 		OpenGLRendererAPI::~OpenGLRendererAPI()
 		{
 			SingletonInstance = nullptr;
+			ReleaseResources();
+		}
 
+		void OpenGLRendererAPI::ReleaseResources()
+		{
 			//terminate ImGui
-			ImGui::DestroyPlatformWindows();
-			if (FontTexture)
+			if (ImGui::GetCurrentContext())
 			{
-				ImGuiIO& io = ImGui::GetIO();
-				glDeleteTextures(1, &FontTexture);
-				io.Fonts->TexID = 0;
-				FontTexture = 0;
+				ImGui::DestroyPlatformWindows();
+				if (FontTexture)
+				{
+					ImGuiIO& io = ImGui::GetIO();
+					glDeleteTextures(1, &FontTexture);
+					io.Fonts->TexID = 0;
+					FontTexture = 0;
+				}
+				ImGui::DestroyContext();
 			}
-			ImGui::DestroyContext();
+
+			//release the imgui objects before flushing so they get deleted with everything else
+			ImGuiShader.reset();
+			ImGuiIndexBuffer.reset();
+			ImGuiVertexBuffer.reset();
+			TimerQueries.Release();
+			OpenGLDeletionQueue::Flush();
 		}
 
 		void OpenGLRendererAPI::Draw(ShaderProgram& shader, Primitive primitive, const IndexBuffer& indexBuffer)
@@ -209,7 +233,9 @@ namespace Ainan {
 			auto func2 = [this]()
 			{
 				glfwMakeContextCurrent(Window::Ptr);
+				Renderer::BeginPassUnsafe(RenderPass::ImGui);
 				DrawImGui(ImGui::GetDrawData());
+				Renderer::EndPassUnsafe();
 			};
 			Renderer::PushCommand(func2);
 			Renderer::WaitUntilRendererIdle();
@@ -396,6 +422,28 @@ namespace Ainan {
 		{
 			glfwSwapBuffers(Window::Ptr);
 			Window::WindowSizeChangedSinceLastFrame = false;
+
+			OpenGLDeletionQueue::EndFrame();
+		}
+
+		void OpenGLRendererAPI::SetVSync(bool enabled)
+		{
+			glfwSwapInterval(enabled ? 1 : 0);
+		}
+
+		void OpenGLRendererAPI::BeginGPUTimer(RenderPass pass)
+		{
+			TimerQueries.Begin(pass);
+		}
+
+		void OpenGLRendererAPI::EndGPUTimer()
+		{
+			TimerQueries.End();
+		}
+
+		bool OpenGLRendererAPI::ResolveGPUTimers(RenderPassTimes& passTimesMs)
+		{
+			return TimerQueries.Resolve(passTimesMs);
 		}
 
 		void OpenGLRendererAPI::Draw(ShaderProgram& shader, Primitive primitive, uint32_t vertexCount)
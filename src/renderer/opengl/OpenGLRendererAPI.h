@@ -8,6 +8,7 @@
 
 #include "OpenGLRendererContext.h"
 #include "OpenGLShaderProgram.h"
+#include "OpenGLTimerQueries.h"
 
 #include <glad/glad.h>
 
@@ -49,6 +50,7 @@ namespace Ainan {
 			virtual void DrawImGui(ImDrawData* drawData) override;
 			virtual void ClearScreen() override;
 			virtual void Present() override;
+			virtual void SetVSync(bool enabled) override;
 			virtual void RecreateSwapchain(const glm::vec2& newSwapchainSize) override;
 			virtual void SetRenderTargetApplicationWindow() override;
 
@@ -58,10 +60,24 @@ namespace Ainan {
 
 			virtual void SetBlendMode(RenderingBlendMode blendMode) override;
 
+			virtual void BeginGPUTimer(RenderPass pass) override;
+			virtual void EndGPUTimer() override;
+			virtual bool ResolveGPUTimers(RenderPassTimes& passTimesMs) override;
+
 			OpenGLRendererContext Context;
 
 			static OpenGLRendererAPI& Snigleton() { assert(SingletonInstance); return *SingletonInstance; };
 
+		protected:
+			//used by api's that create their own context instead of using the window's context,
+			//they have to make it current and call LoadOpenGL themselves
+			struct NoWindowContext {};
+			OpenGLRendererAPI(NoWindowContext);
+
+			void LoadOpenGL(GLADloadproc loader);
+			//deletes every gpu resource owned by the api, must be called while the context is still current
+			void ReleaseResources();
+
 		private:
 			static OpenGLRendererAPI* SingletonInstance;
 			//imgui data
@@ -72,6 +88,8 @@ namespace Ainan {
 			std::shared_ptr<IndexBuffer> ImGuiIndexBuffer;
 			std::shared_ptr<VertexBuffer> ImGuiVertexBuffer;
 			uint32_t FontTexture = 0;
+
+			OpenGLTimerQueries TimerQueries;
 		};
 	}
 }
@@ -10,6 +10,11 @@ namespace Ainan {
 			virtual std::string GetVersionString() override;
 			virtual std::string GetPhysicalDeviceName() override;
 
+		public:
+			//true when rendering through an offscreen context without a window
+			bool Headless = false;
+
+		private:
 			std::string OpenGLVersion;
 			std::string PhysicalDeviceName;
 
@@ -0,0 +1,151 @@
+#include <glad/glad.h>
+
+#include "OpenGLShaderCache.h"
+
+namespace Ainan {
+	namespace OpenGL {
+
+		const std::filesystem::path OpenGLShaderCache::s_CacheDirectory = "shader_cache";
+
+		//"ASHC"
+		const uint32_t c_ShaderCacheMagic = 0x43485341;
+
+		struct ShaderCacheHeader
+		{
+			uint32_t Magic = c_ShaderCacheMagic;
+			uint32_t BinaryFormat = 0;
+			uint32_t BinaryLength = 0;
+			uint64_t Hash = 0;
+		};
+
+		//FNV-1a
+		static uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+		{
+			const uint8_t* bytes = (const uint8_t*)data;
+			for (size_t i = 0; i < size; i++)
+			{
+				hash ^= bytes[i];
+				hash *= 0x100000001b3;
+			}
+			return hash;
+		}
+
+		bool OpenGLShaderCache::IsSupported()
+		{
+			if (!GLAD_GL_ARB_get_program_binary)
+				return false;
+
+			//some drivers expose the extension without supporting any binary formats
+			int32_t formatCount = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+			return formatCount > 0;
+		}
+
+		uint64_t OpenGLShaderCache::GetHash(const std::string& vertSrc, const std::string& fragSrc)
+		{
+			const char separator = '\0';
+			uint64_t hash = 0xcbf29ce484222325;
+			hash = HashBytes(hash, vertSrc.data(), vertSrc.size());
+			hash = HashBytes(hash, &separator, 1);
+			hash = HashBytes(hash, fragSrc.data(), fragSrc.size());
+			hash = HashBytes(hash, &separator, 1);
+			hash = HashBytes(hash, GetDriverString().data(), GetDriverString().size());
+			return hash;
+		}
+
+		bool OpenGLShaderCache::Load(uint32_t program, uint64_t hash)
+		{
+			if (!IsSupported())
+				return false;
+
+			FILE* file = fopen(GetEntryPath(hash).string().c_str(), "rb");
+			if (!file)
+				return false;
+
+			ShaderCacheHeader header;
+			bool valid = fread(&header, sizeof(ShaderCacheHeader), 1, file) == 1 &&
+				header.Magic == c_ShaderCacheMagic &&
+				header.Hash == hash &&
+				header.BinaryLength > 0;
+
+			std::vector<uint8_t> binary;
+			if (valid)
+			{
+				binary.resize(header.BinaryLength);
+				valid = fread(binary.data(), 1, binary.size(), file) == binary.size();
+			}
+			fclose(file);
+
+			if (!valid)
+				return false;
+
+			glProgramBinary(program, header.BinaryFormat, binary.data(), header.BinaryLength);
+
+			//the driver is allowed to reject binaries at any time, in that case we compile from source
+			int32_t linked = 0;
+			glGetProgramiv(program, GL_LINK_STATUS, &linked);
+			return linked == GL_TRUE;
+		}
+
+		void OpenGLShaderCache::Save(uint32_t program, uint64_t hash)
+		{
+			if (!IsSupported())
+				return;
+
+			int32_t length = 0;
+			glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+			if (length <= 0)
+				return;
+
+			ShaderCacheHeader header;
+			header.Hash = hash;
+			std::vector<uint8_t> binary(length);
+			GLsizei writtenLength = 0;
+			GLenum format = 0;
+			glGetProgramBinary(program, length, &writtenLength, &format, binary.data());
+			header.BinaryFormat = format;
+			header.BinaryLength = writtenLength;
+
+			std::error_code err;
+			std::filesystem::create_directories(s_CacheDirectory, err);
+
+			//write to a temporary file first so a crash can't leave a half written entry behind
+			std::filesystem::path path = GetEntryPath(hash);
+			std::filesystem::path tempPath = path.string() + ".tmp";
+			FILE* file = fopen(tempPath.string().c_str(), "wb");
+			if (!file)
+			{
+				AINAN_LOG_WARNING("Could not write shader cache entry: " + path.string());
+				return;
+			}
+
+			bool written = fwrite(&header, sizeof(ShaderCacheHeader), 1, file) == 1 &&
+				fwrite(binary.data(), 1, writtenLength, file) == writtenLength;
+			fclose(file);
+
+			if (written)
+				std::filesystem::rename(tempPath, path, err);
+			else
+				std::filesystem::remove(tempPath, err);
+		}
+
+		std::filesystem::path OpenGLShaderCache::GetEntryPath(uint64_t hash)
+		{
+			std::stringstream name;
+			name << std::hex << hash << ".bin";
+			return s_CacheDirectory / name.str();
+		}
+
+		const std::string& OpenGLShaderCache::GetDriverString()
+		{
+			static std::string driver;
+			if (driver.empty())
+			{
+				driver = std::string((const char*)glGetString(GL_VENDOR)) + " " +
+					(const char*)glGetString(GL_RENDERER) + " " +
+					(const char*)glGetString(GL_VERSION);
+			}
+			return driver;
+		}
+	}
+}
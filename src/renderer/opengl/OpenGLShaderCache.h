@@ -0,0 +1,27 @@
+#pragma once
+
+namespace Ainan {
+	namespace OpenGL {
+
+		//stores linked program binaries on disk so shaders don't need to be recompiled on every launch,
+		//entries are keyed by a hash of the preprocessed source and the driver so a driver update invalidates them
+		class OpenGLShaderCache
+		{
+		public:
+			static bool IsSupported();
+
+			static uint64_t GetHash(const std::string& vertSrc, const std::string& fragSrc);
+
+			//returns true if the program was linked from the cache
+			static bool Load(uint32_t program, uint64_t hash);
+			static void Save(uint32_t program, uint64_t hash);
+
+		private:
+			static std::filesystem::path GetEntryPath(uint64_t hash);
+			static const std::string& GetDriverString();
+
+		public:
+			static const std::filesystem::path s_CacheDirectory;
+		};
+	}
+}
@@ -5,13 +5,19 @@
 #include "OpenGLUniformBuffer.h"
 #include "OpenGLTexture.h"
 #include "OpenGLFrameBuffer.h"
+#include "OpenGLDeletionQueue.h"
+#include "OpenGLShaderCache.h"
 
 namespace Ainan {
 	namespace OpenGL {
 
 		std::string LoadAndParseShader(std::string path)
 		{
-			std::string shader = AssetManager::ReadEntireTextFile(path);
+			//an empty source fails to compile and the error is reported then
+			MappedFile file = AssetManager::MapFile(path);
+			if (!file.IsValid())
+				AINAN_LOG_ERROR("Cannot read shader file: " + path);
+			std::string shader(file.GetText());
 
 			//parse include statements
 			size_t includeLocation = 0;
@@ -29,13 +35,16 @@ namespace Ainan {
 				std::filesystem::path fullPath = shaderFolder.string() + "/" + includePath;
 				if (std::filesystem::exists(fullPath))
 				{
-					std::string includeFileContents = AssetManager::ReadEntireTextFile(fullPath.string());
+					MappedFile includeFile = AssetManager::MapFile(fullPath);
 
-					shader.erase(includeLocation, includeStatement.size());
-					shader.insert(includeLocation, includeFileContents.c_str());
+					//copied straight from the mapping into the shader source
+					shader.replace(includeLocation, includeStatement.size(), includeFile.GetText());
 				}
 				else
-					assert(false);
+				{
+					AINAN_LOG_ERROR("Cannot find shader include file: " + fullPath.string());
+					shader.erase(includeLocation, includeStatement.size());
+				}
 				includeLocation = shader.find("#include ");
 			}
 
@@ -44,65 +53,107 @@ namespace Ainan {
 
 		OpenGLShaderProgram::OpenGLShaderProgram(const std::string& vertPath, const std::string& fragPath)
 		{
-			uint32_t vertex, fragment;
+			BeginCompile(LoadAndParseShader(vertPath + ".vert"), LoadAndParseShader(fragPath + ".frag"));
+			EndCompile();
+		}
 
-			vertex = glCreateShader(GL_VERTEX_SHADER);
-			std::string vShaderCode = LoadAndParseShader(vertPath + ".vert");
-			const char* c_vShaderCode = vShaderCode.c_str();
-			glShaderSource(vertex, 1, &c_vShaderCode, NULL);
-			glCompileShader(vertex);
+		std::shared_ptr<OpenGLShaderProgram> OpenGLShaderProgram::CreateRaw(const std::string& vertSrc, const std::string& fragSrc)
+		{
+			auto shader = std::make_shared<OpenGLShaderProgram>();
 
-			fragment = glCreateShader(GL_FRAGMENT_SHADER);
-			std::string fShaderCode = LoadAndParseShader(fragPath + ".frag");
-			const char* c_fShaderCode = fShaderCode.c_str();
-			glShaderSource(fragment, 1, &c_fShaderCode, NULL);
-			glCompileShader(fragment);
+			shader->BeginCompile(vertSrc, fragSrc);
+			shader->EndCompile();
 
-			// shader Program
-			m_RendererID = glCreateProgram();
-			glAttachShader(m_RendererID, vertex);
-			glAttachShader(m_RendererID, fragment);
+			return shader;
+		}
 
-			glLinkProgram(m_RendererID);
-			// delete the shaders as they're linked into our program now and no longer necessery
-			glDeleteShader(vertex);
-			glDeleteShader(fragment);
+		std::vector<std::shared_ptr<OpenGLShaderProgram>> OpenGLShaderProgram::CreateMultiple(const std::vector<std::pair<std::string, std::string>>& paths)
+		{
+			//let the driver use as many threads as it wants
+			if (GLAD_GL_KHR_parallel_shader_compile)
+				glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+
+			std::vector<std::shared_ptr<OpenGLShaderProgram>> shaders;
+			shaders.reserve(paths.size());
+
+			for (auto& shaderPaths : paths)
+			{
+				auto shader = std::make_shared<OpenGLShaderProgram>();
+				shader->BeginCompile(LoadAndParseShader(shaderPaths.first + ".vert"), LoadAndParseShader(shaderPaths.second + ".frag"));
+				shaders.push_back(shader);
+			}
+
+			//only now do we query the link status, which is what blocks
+			for (auto& shader : shaders)
+				shader->EndCompile();
+
+			return shaders;
 		}
 
-		std::shared_ptr<OpenGLShaderProgram> OpenGLShaderProgram::CreateRaw(const std::string& vertSrc, const std::string& fragSrc)
+		void OpenGLShaderProgram::BeginCompile(const std::string& vertSrc, const std::string& fragSrc)
 		{
-			auto shader = std::make_shared<OpenGLShaderProgram>();
+			m_RendererID = glCreateProgram();
+			m_SourceHash = OpenGLShaderCache::GetHash(vertSrc, fragSrc);
 
-			uint32_t vertex, fragment;
+			if (OpenGLShaderCache::Load(m_RendererID, m_SourceHash))
+			{
+				m_Linked = true;
+				return;
+			}
 
-			vertex = glCreateShader(GL_VERTEX_SHADER);
+			m_PendingVertexShader = glCreateShader(GL_VERTEX_SHADER);
 			const char* c_vShaderCode = vertSrc.c_str();
-			glShaderSource(vertex, 1, &c_vShaderCode, NULL);
-			glCompileShader(vertex);
-
+			glShaderSource(m_PendingVertexShader, 1, &c_vShaderCode, NULL);
+			glCompileShader(m_PendingVertexShader);
 
-			fragment = glCreateShader(GL_FRAGMENT_SHADER);
+			m_PendingFragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
 			const char* c_fShaderCode = fragSrc.c_str();
-			glShaderSource(fragment, 1, &c_fShaderCode, NULL);
-			glCompileShader(fragment);
-
+			glShaderSource(m_PendingFragmentShader, 1, &c_fShaderCode, NULL);
+			glCompileShader(m_PendingFragmentShader);
 
 			// shader Program
-			shader->m_RendererID = glCreateProgram();
-			glAttachShader(shader->m_RendererID, vertex);
-			glAttachShader(shader->m_RendererID, fragment);
+			glAttachShader(m_RendererID, m_PendingVertexShader);
+			glAttachShader(m_RendererID, m_PendingFragmentShader);
 
-			glLinkProgram(shader->m_RendererID);
-			// delete the shaders as they're linked into our program now and no longer necessery
-			glDeleteShader(vertex);
-			glDeleteShader(fragment);
+			if (OpenGLShaderCache::IsSupported())
+				glProgramParameteri(m_RendererID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
-			return shader;
+			glLinkProgram(m_RendererID);
+		}
+
+		void OpenGLShaderProgram::EndCompile()
+		{
+			//already linked from the cache
+			if (m_PendingVertexShader == 0)
+				return;
+
+			int32_t linked = 0;
+			glGetProgramiv(m_RendererID, GL_LINK_STATUS, &linked);
+
+			m_Linked = linked == GL_TRUE;
+			if (m_Linked)
+				OpenGLShaderCache::Save(m_RendererID, m_SourceHash);
+			else
+			{
+				char infoLog[1024];
+				glGetShaderInfoLog(m_PendingVertexShader, sizeof(infoLog), nullptr, infoLog);
+				AINAN_LOG_ERROR(std::string("Vertex shader compilation failed: ") + infoLog);
+				glGetShaderInfoLog(m_PendingFragmentShader, sizeof(infoLog), nullptr, infoLog);
+				AINAN_LOG_ERROR(std::string("Fragment shader compilation failed: ") + infoLog);
+				glGetProgramInfoLog(m_RendererID, sizeof(infoLog), nullptr, infoLog);
+				AINAN_LOG_ERROR(std::string("Shader program linking failed: ") + infoLog);
+			}
+
+			// delete the shaders as they're linked into our program now and no longer necessery
+			glDeleteShader(m_PendingVertexShader);
+			glDeleteShader(m_PendingFragmentShader);
+			m_PendingVertexShader = 0;
+			m_PendingFragmentShader = 0;
 		}
 
 		OpenGLShaderProgram::~OpenGLShaderProgram()
 		{
-			glDeleteProgram(m_RendererID);
+			OpenGLDeletionQueue::Push(OpenGLResourceType::Program, m_RendererID);
 		}
 
 		void OpenGLShaderProgram::BindUniformBuffer(std::shared_ptr<UniformBuffer>& buffer, uint32_t slot, RenderingStage stage)
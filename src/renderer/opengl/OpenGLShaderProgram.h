@@ -12,8 +12,13 @@ namespace Ainan {
 			OpenGLShaderProgram(const std::string& vertPath, const std::string& fragPath);
 			OpenGLShaderProgram() { m_RendererID = 0; }
 			static std::shared_ptr<OpenGLShaderProgram> CreateRaw(const std::string& vertSrc, const std::string& fragSrc);
+			//issues every compile before waiting on any of them so the driver can compile them in parallel,
+			//each pair is a vertex and fragment shader path (without extension)
+			static std::vector<std::shared_ptr<OpenGLShaderProgram>> CreateMultiple(const std::vector<std::pair<std::string, std::string>>& paths);
 			~OpenGLShaderProgram();
 
+			virtual bool IsValid() const override { return m_Linked; }
+
 			virtual void BindUniformBuffer(std::shared_ptr<UniformBuffer>& buffer, uint32_t slot, RenderingStage stage) override;
 			virtual void BindUniformBufferUnsafe(std::shared_ptr<UniformBuffer>& buffer, uint32_t slot, RenderingStage stage) override;
 
@@ -22,8 +27,20 @@ namespace Ainan {
 
 			virtual void BindTexture(std::shared_ptr<FrameBuffer>& framebuffer, uint32_t slot, RenderingStage stage) override;
 			virtual void BindTextureUnsafe(std::shared_ptr<FrameBuffer>& framebuffer, uint32_t slot, RenderingStage stage) override;
+		private:
+			//links from the shader cache if possible, otherwise submits the compile and link without waiting on the result
+			void BeginCompile(const std::string& vertSrc, const std::string& fragSrc);
+			//waits for the link to finish, reports errors and stores the program in the shader cache
+			void EndCompile();
+
 		public:
 			uint32_t m_RendererID;
+
+		private:
+			uint32_t m_PendingVertexShader = 0;
+			uint32_t m_PendingFragmentShader = 0;
+			uint64_t m_SourceHash = 0;
+			bool m_Linked = false;
 		};
 	}
 }
\ No newline at end of file
@@ -1,7 +1,9 @@
 #include <glad/glad.h>
 
 #include "OpenGLTexture.h"
+#include "OpenGLDeletionQueue.h"
 #include "renderer/Renderer.h"
+#include "renderer/TextureDiskCache.h"
 
 namespace Ainan {
 	namespace OpenGL {
@@ -15,7 +17,7 @@ namespace Ainan {
 
 		OpenGLTexture::~OpenGLTexture()
 		{
-			glDeleteTextures(1, &m_RendererID);
+			OpenGLDeletionQueue::Push(OpenGLResourceType::Texture, m_RendererID);
 		}
 
 		inline void OpenGLTexture::AllocateTexture(const glm::vec2& size, TextureFormat format, uint8_t* data)
@@ -69,5 +71,56 @@ namespace Ainan {
 		{
 			AllocateTexture({ image->m_Width, image->m_Height }, image->Format, image->m_Data);
 		}
+
+		void OpenGLTexture::SetMipChainUnsafe(std::shared_ptr<TextureMipChain> chain)
+		{
+			uint32_t internalFormat = 0;
+			uint32_t dataFormat = 0;
+			switch (chain->Format)
+			{
+			case TextureFormat::RGBA:
+				internalFormat = GL_RGBA8;
+				dataFormat = GL_RGBA;
+				break;
+
+			case TextureFormat::RGB:
+				internalFormat = GL_RGB8;
+				dataFormat = GL_RGB;
+				break;
+
+			case TextureFormat::RG:
+				internalFormat = GL_RG8;
+				dataFormat = GL_RG;
+				break;
+
+			case TextureFormat::R:
+				internalFormat = GL_R8;
+				dataFormat = GL_RED;
+				break;
+
+			case TextureFormat::Unspecified:
+				assert(false);
+			}
+
+			glBindTexture(GL_TEXTURE_2D, m_RendererID);
+
+			//rows of the smaller levels aren't 4 byte aligned
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+			for (size_t i = 0; i < chain->Levels.size(); i++)
+			{
+				auto& level = chain->Levels[i];
+				glTexImage2D(GL_TEXTURE_2D, (int32_t)i, internalFormat, level.Width, level.Height, 0, dataFormat, GL_UNSIGNED_BYTE, level.Data);
+			}
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (int32_t)chain->Levels.size() - 1);
+			m_AllocatedGPUMem = (uint32_t)chain->GetSize();
+
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		}
 	}
 }
\ No newline at end of file
@@ -14,6 +14,7 @@ namespace Ainan {
 
 			virtual void SetImage(std::shared_ptr<Image> image) override;
 			virtual void SetImageUnsafe(std::shared_ptr<Image> image) override;
+			virtual void SetMipChainUnsafe(std::shared_ptr<TextureMipChain> chain) override;
 
 			virtual uint32_t GetMemorySize() const override { return m_AllocatedGPUMem; };
 			virtual void* GetTextureID() override           { return (void*)(uintptr_t)m_RendererID; };
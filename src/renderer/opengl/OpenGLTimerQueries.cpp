@@ -0,0 +1,80 @@
+#include "OpenGLTimerQueries.h"
+
+namespace Ainan {
+	namespace OpenGL {
+
+		void OpenGLTimerQueries::Begin(RenderPass pass)
+		{
+			//only one GL_TIME_ELAPSED query can be active at a time
+			assert(!m_QueryActive);
+
+			FrameQueries& frame = m_Frames[m_CurrentFrame];
+			if (frame.UsedCount == frame.Queries.size())
+			{
+				uint32_t query = 0;
+				glGenQueries(1, &query);
+				frame.Queries.push_back(query);
+				frame.Passes.push_back(pass);
+			}
+
+			frame.Passes[frame.UsedCount] = pass;
+			glBeginQuery(GL_TIME_ELAPSED, frame.Queries[frame.UsedCount]);
+			frame.UsedCount++;
+			m_QueryActive = true;
+		}
+
+		void OpenGLTimerQueries::End()
+		{
+			assert(m_QueryActive);
+			glEndQuery(GL_TIME_ELAPSED);
+			m_QueryActive = false;
+		}
+
+		bool OpenGLTimerQueries::Resolve(RenderPassTimes& passTimesMs)
+		{
+			if (m_QueryActive)
+				End();
+
+			//the other set has the previous frame, which has had a whole frame to finish
+			m_CurrentFrame = (m_CurrentFrame + 1) % m_Frames.size();
+			FrameQueries& frame = m_Frames[m_CurrentFrame];
+
+			if (frame.UsedCount == 0)
+				return false;
+
+			//queries finish in order so if the last one is ready all of them are
+			int32_t available = 0;
+			glGetQueryObjectiv(frame.Queries[frame.UsedCount - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+			{
+				//reusing the queries is still fine, the driver discards the old results
+				frame.UsedCount = 0;
+				return false;
+			}
+
+			passTimesMs.fill(0.0);
+			for (uint32_t i = 0; i < frame.UsedCount; i++)
+			{
+				uint64_t nanoseconds = 0;
+				glGetQueryObjectui64v(frame.Queries[i], GL_QUERY_RESULT, &nanoseconds);
+				passTimesMs[(size_t)frame.Passes[i]] += nanoseconds / 1000000.0;
+			}
+
+			frame.UsedCount = 0;
+			return true;
+		}
+
+		void OpenGLTimerQueries::Release()
+		{
+			for (auto& frame : m_Frames)
+			{
+				if (frame.Queries.size() > 0)
+					glDeleteQueries((GLsizei)frame.Queries.size(), frame.Queries.data());
+				frame.Queries.clear();
+				frame.Passes.clear();
+				frame.UsedCount = 0;
+			}
+			m_QueryActive = false;
+		}
+	}
+}
\ No newline at end of file
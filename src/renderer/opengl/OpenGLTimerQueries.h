@@ -0,0 +1,39 @@
+#pragma once
+
+#include "renderer/RendererAPI.h"
+
+#include <glad/glad.h>
+
+namespace Ainan {
+	namespace OpenGL {
+
+		//times render passes on the gpu with GL_TIME_ELAPSED queries,
+		//the queries are double buffered by frame so results are read a frame later when they are already available
+		//instead of stalling the pipeline waiting for them
+		class OpenGLTimerQueries
+		{
+		public:
+			void Begin(RenderPass pass);
+			void End();
+
+			//ends the current frame and reads the results of the previous one,
+			//returns false if they aren't ready yet, in that case they are dropped
+			bool Resolve(RenderPassTimes& passTimesMs);
+
+			//deletes the query objects, must be called while the context is still current
+			void Release();
+
+		private:
+			struct FrameQueries
+			{
+				std::vector<uint32_t> Queries;
+				std::vector<RenderPass> Passes;
+				uint32_t UsedCount = 0;
+			};
+
+			std::array<FrameQueries, 2> m_Frames;
+			uint32_t m_CurrentFrame = 0;
+			bool m_QueryActive = false;
+		};
+	}
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <glad/glad.h>
 
 #include "OpenGLUniformBuffer.h"
+#include "OpenGLDeletionQueue.h"
 
 #include <numeric>
 
@@ -84,12 +85,7 @@ namespace Ainan {
 
 		OpenGLUniformBuffer::~OpenGLUniformBuffer()
 		{
-			auto rendererID = m_RendererID;
-			auto func = [rendererID]()
-			{
-				glDeleteBuffers(1, &rendererID);
-			};
-			Renderer::PushCommand(func);
+			OpenGLDeletionQueue::Push(OpenGLResourceType::Buffer, m_RendererID);
 			delete[] m_BufferMemory;
 		}
 
@@ -1,6 +1,7 @@
 #include <glad/glad.h>
 
 #include "OpenGLVertexBuffer.h"
+#include "OpenGLDeletionQueue.h"
 
 namespace Ainan {
 	namespace OpenGL {
@@ -68,13 +69,8 @@ namespace Ainan {
 
 		OpenGLVertexBuffer::~OpenGLVertexBuffer()
 		{
-			uint32_t rendererID = m_RendererID;
-			auto func = [rendererID]()
-			{
-				glDeleteBuffers(1, &rendererID);
-			};
-
-			Renderer::PushCommand(func);
+			OpenGLDeletionQueue::Push(OpenGLResourceType::Buffer, m_RendererID);
+			OpenGLDeletionQueue::Push(OpenGLResourceType::VertexArray, m_VertexArray);
 		}
 
 		void OpenGLVertexBuffer::Bind() const
@@ -0,0 +1,146 @@
+#include "SoftwareFrameBuffer.h"
+#include "SoftwareRendererAPI.h"
+
+#include "renderer/Renderer.h"
+
+namespace Ainan {
+	namespace Software {
+
+		SoftwareFrameBuffer::SoftwareFrameBuffer(const glm::vec2& size) :
+			m_Pixels(std::make_shared<PixelBuffer>()),
+			m_Size(size)
+		{
+			m_Pixels->Resize((int32_t)size.x, (int32_t)size.y);
+		}
+
+		void SoftwareFrameBuffer::Bind() const
+		{
+			auto func = [this]()
+			{
+				BindUnsafe();
+			};
+			Renderer::PushCommand(func);
+		}
+
+		void SoftwareFrameBuffer::BindUnsafe() const
+		{
+			SoftwareRendererAPI::Singleton().BoundRenderTarget = m_Pixels;
+		}
+
+		void SoftwareFrameBuffer::Resize(const glm::vec2& newSize)
+		{
+			auto func = [this, newSize]()
+			{
+				ResizeUnsafe(newSize);
+			};
+			Renderer::PushCommand(func);
+		}
+
+		void SoftwareFrameBuffer::ResizeUnsafe(const glm::vec2& newSize)
+		{
+			m_Size = newSize;
+			//resized in place so it stays bound wherever it is bound, just like a GL texture
+			if (m_Pixels->Width != (int32_t)newSize.x || m_Pixels->Height != (int32_t)newSize.y)
+				m_Pixels->Resize((int32_t)newSize.x, (int32_t)newSize.y);
+		}
+
+		Image SoftwareFrameBuffer::ReadPixels(glm::vec2 bottomLeftPixel, glm::vec2 topRightPixel)
+		{
+			Image image;
+			auto func = [this, &image, bottomLeftPixel, topRightPixel]
+			{
+				//same parameters and row order as glReadPixels in the OpenGL backend
+				int32_t x = std::clamp((int32_t)bottomLeftPixel.x, 0, m_Pixels->Width);
+				int32_t y = std::clamp((int32_t)bottomLeftPixel.y, 0, m_Pixels->Height);
+				int32_t width = topRightPixel.x == 0 ? m_Pixels->Width : (int32_t)topRightPixel.x;
+				int32_t height = topRightPixel.y == 0 ? m_Pixels->Height : (int32_t)topRightPixel.y;
+				width = std::clamp(width, 0, m_Pixels->Width - x);
+				height = std::clamp(height, 0, m_Pixels->Height - y);
+
+				//the image is only as big as the rectangle that was read
+				image.m_Width = width;
+				image.m_Height = height;
+				image.m_Data = new uint8_t[(size_t)width * height * 4];
+				image.Format = TextureFormat::RGBA;
+
+				for (int32_t row = 0; row < height; row++)
+					memcpy(&image.m_Data[(size_t)row * width * 4],
+						&m_Pixels->Data[((size_t)(y + row) * m_Pixels->Width + x) * 4],
+						(size_t)width * 4);
+			};
+
+			Renderer::PushCommand(func);
+			Renderer::WaitUntilRendererIdle();
+			return image;
+		}
+
+		void SoftwareFrameBuffer::ReadPixelsAsyncUnsafe(ReadbackRequest request)
+		{
+			//only what is left of the framebuffer after the origin can be read, the rest of target is untouched
+			int32_t width = std::min(request.Width, m_Pixels->Width - request.X);
+			int32_t height = std::min(request.Height, m_Pixels->Height - request.Y);
+			for (int32_t row = 0; row < height; row++)
+				memcpy(&request.Target[(size_t)row * request.Width * 4],
+					&m_Pixels->Data[((size_t)(request.Y + row) * m_Pixels->Width + request.X) * 4],
+					(size_t)std::max(width, 0) * 4);
+
+			request.OnComplete(true);
+		}
+
+		void SoftwareFrameBuffer::FlushReadbacksUnsafe()
+		{}
+
+		void SoftwareFrameBuffer::Blit(FrameBuffer* otherBuffer, const glm::vec2& sourceSize, const glm::vec2& targetSize)
+		{
+			SoftwareRendererAPI& api = SoftwareRendererAPI::Singleton();
+			PixelBuffer& target = otherBuffer ? *((SoftwareFrameBuffer*)otherBuffer)->m_Pixels : api.GetWindowBuffer();
+			const PixelBuffer& source = *m_Pixels;
+
+			int32_t sourceWidth = std::min((int32_t)sourceSize.x, source.Width);
+			int32_t sourceHeight = std::min((int32_t)sourceSize.y, source.Height);
+			int32_t targetWidth = std::min((int32_t)targetSize.x, target.Width);
+			int32_t targetHeight = std::min((int32_t)targetSize.y, target.Height);
+			if (sourceWidth <= 0 || sourceHeight <= 0 || targetWidth <= 0 || targetHeight <= 0)
+				return;
+
+			//same size is by far the common case, it is just a copy
+			if (sourceWidth == (int32_t)targetSize.x && sourceHeight == (int32_t)targetSize.y)
+			{
+				for (int32_t y = 0; y < targetHeight; y++)
+					memcpy(&target.Data[(size_t)y * target.Width * 4], &source.Data[(size_t)y * source.Width * 4], (size_t)targetWidth * 4);
+				return;
+			}
+
+			//linear filtering with the edges clamped, like glBlitFramebuffer with GL_LINEAR
+			float scaleX = (float)sourceWidth / targetSize.x;
+			float scaleY = (float)sourceHeight / targetSize.y;
+			for (int32_t y = 0; y < targetHeight; y++)
+			{
+				float sourceY = std::clamp((y + 0.5f) * scaleY - 0.5f, 0.0f, (float)(sourceHeight - 1));
+				int32_t y0 = (int32_t)sourceY;
+				int32_t y1 = std::min(y0 + 1, sourceHeight - 1);
+				float fractionY = sourceY - y0;
+
+				for (int32_t x = 0; x < targetWidth; x++)
+				{
+					float sourceX = std::clamp((x + 0.5f) * scaleX - 0.5f, 0.0f, (float)(sourceWidth - 1));
+					int32_t x0 = (int32_t)sourceX;
+					int32_t x1 = std::min(x0 + 1, sourceWidth - 1);
+					float fractionX = sourceX - x0;
+
+					const uint8_t* p00 = &source.Data[((size_t)y0 * source.Width + x0) * 4];
+					const uint8_t* p10 = &source.Data[((size_t)y0 * source.Width + x1) * 4];
+					const uint8_t* p01 = &source.Data[((size_t)y1 * source.Width + x0) * 4];
+					const uint8_t* p11 = &source.Data[((size_t)y1 * source.Width + x1) * 4];
+					uint8_t* pixel = &target.Data[((size_t)y * target.Width + x) * 4];
+					for (int32_t i = 0; i < 4; i++)
+					{
+						float bottom = p00[i] + (p10[i] - p00[i]) * fractionX;
+						float top = p01[i] + (p11[i] - p01[i]) * fractionX;
+						pixel[i] = (uint8_t)(bottom + (top - bottom) * fractionY + 0.5f);
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "renderer/Texture.h"
+#include "renderer/FrameBuffer.h"
+#include "SoftwareRasterizer.h"
+
+namespace Ainan {
+	namespace Software {
+
+		class SoftwareFrameBuffer : public FrameBuffer
+		{
+		public:
+			SoftwareFrameBuffer(const glm::vec2& size);
+
+			virtual void Blit(FrameBuffer* otherBuffer, const glm::vec2& sourceSize, const glm::vec2& targetSize) override;
+			virtual Image ReadPixels(glm::vec2 bottomLeftPixel = { 0,0 }, glm::vec2 topRightPixel = { 0,0 }) override;
+
+			virtual glm::vec2 GetSize() const override { return m_Size; }
+			virtual void Resize(const glm::vec2& newSize) override;
+			virtual void ResizeUnsafe(const glm::vec2& newSize) override;
+			virtual void* GetTextureID() override { return m_Pixels.get(); };
+
+			virtual void Bind() const override;
+			virtual void BindUnsafe() const override;
+
+			//drawing finishes inside the draw calls, so there is never anything in flight
+			virtual void ReadPixelsAsyncUnsafe(ReadbackRequest request) override;
+			virtual void FlushReadbacksUnsafe() override;
+
+		public:
+			//the color attachment, also sampled directly when the framebuffer is bound as a texture
+			std::shared_ptr<PixelBuffer> m_Pixels;
+			glm::vec2 m_Size = { 0.0f, 0.0f };
+		};
+	}
+}
@@ -0,0 +1,14 @@
+#include "SoftwareIndexBuffer.h"
+
+namespace Ainan {
+	namespace Software {
+
+		SoftwareIndexBuffer::SoftwareIndexBuffer(uint32_t* data, uint32_t count)
+		{
+			if (data)
+				m_Indices.assign(data, data + count);
+			else
+				m_Indices.resize(count);
+		}
+	}
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "renderer/IndexBuffer.h"
+
+namespace Ainan {
+	namespace Software {
+
+		class SoftwareIndexBuffer : public IndexBuffer
+		{
+		public:
+			SoftwareIndexBuffer(uint32_t* data, uint32_t count);
+
+			// Inherited via IndexBuffer
+			virtual uint32_t GetCount() const override { return (uint32_t)m_Indices.size(); };
+			virtual uint32_t GetUsedMemory() const override { return (uint32_t)(m_Indices.size() * sizeof(uint32_t)); };
+			//the index buffer is passed directly to the draw call so there is nothing to bind
+			virtual void Bind() const override {};
+			virtual void Unbind() const override {};
+
+		public:
+			std::vector<uint32_t> m_Indices;
+		};
+	}
+}
@@ -0,0 +1,531 @@
+#include "SoftwareRasterizer.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AINAN_SOFTWARE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Ainan {
+	namespace Software {
+
+		constexpr int32_t c_TileSize = 64;
+		//window coordinates are snapped to 1/256 of a pixel so edge functions can be evaluated exactly with integers
+		constexpr int32_t c_SubPixelBits = 8;
+		constexpr int32_t c_SubPixelScale = 1 << c_SubPixelBits;
+
+		//everything needed to rasterize one triangle, computed once before binning
+		struct TriangleSetup
+		{
+			//vertices in fixed point, counter clockwise
+			int64_t X[3];
+			int64_t Y[3];
+			//which of the edges (v1 v2), (v2 v0), (v0 v1) own the pixels exactly on them
+			bool TopLeft[3];
+			float InverseArea;
+			//pixel bounds already clipped to the clip rectangle, max is exclusive
+			int32_t MinX, MinY, MaxX, MaxY;
+			uint32_t Vertices[3];
+		};
+
+		static inline int64_t ToFixed(float value)
+		{
+			//keeps the edge function products far away from overflowing
+			value = std::clamp(value, -1000000.0f, 1000000.0f);
+			return (int64_t)std::lround(value * c_SubPixelScale);
+		}
+
+		static inline int64_t EdgeFunction(int64_t ax, int64_t ay, int64_t bx, int64_t by, int64_t px, int64_t py)
+		{
+			return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+		}
+
+		static inline int32_t Wrap(int32_t value, int32_t size)
+		{
+			value %= size;
+			return value < 0 ? value + size : value;
+		}
+
+		//bilinear filtering with repeat wrapping, same as the texture parameters used by the other backends
+		static glm::vec4 Sample(const PixelBuffer* texture, const glm::vec2& uv)
+		{
+			//GL returns black for incomplete textures
+			if (!texture || texture->Width == 0 || texture->Height == 0)
+				return glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+
+			float x = uv.x * texture->Width - 0.5f;
+			float y = uv.y * texture->Height - 0.5f;
+			float floorX = std::floor(x);
+			float floorY = std::floor(y);
+			float fractionX = x - floorX;
+			float fractionY = y - floorY;
+
+			int32_t x0 = Wrap((int32_t)floorX, texture->Width);
+			int32_t y0 = Wrap((int32_t)floorY, texture->Height);
+			int32_t x1 = x0 + 1 == texture->Width ? 0 : x0 + 1;
+			int32_t y1 = y0 + 1 == texture->Height ? 0 : y0 + 1;
+
+			auto texel = [texture](int32_t x, int32_t y)
+			{
+				const uint8_t* pixel = &texture->Data[((size_t)y * texture->Width + x) * 4];
+				return glm::vec4(pixel[0], pixel[1], pixel[2], pixel[3]);
+			};
+
+			glm::vec4 bottom = glm::mix(texel(x0, y0), texel(x1, y0), fractionX);
+			glm::vec4 top = glm::mix(texel(x0, y1), texel(x1, y1), fractionX);
+			return glm::mix(bottom, top, fractionY) * (1.0f / 255.0f);
+		}
+
+		//C++ versions of the fragment shaders
+		static inline glm::vec4 ShadeFragment(const FragmentState& state, const glm::vec4& color, const glm::vec2& uv, float textureSlot)
+		{
+			switch (state.Shader)
+			{
+			case ShaderType::QuadBatch:
+			{
+				int32_t slot = (int32_t)textureSlot;
+				if (slot < 0 || slot >= c_MaxSoftwareTextureSlots)
+					return glm::vec4(0.0f);
+				return Sample(state.Textures[slot], uv) * color;
+			}
+
+			case ShaderType::FlatColor:
+				return state.FlatColor;
+
+			case ShaderType::Image:
+				return Sample(state.Textures[0], uv);
+
+			case ShaderType::Blur:
+			{
+				const float weights[5] = { 0.227204f, 0.193829f, 0.120338f, 0.054364f, 0.017867f };
+				glm::vec2 step = state.BlurRadius / state.BlurResolution * state.BlurDirection;
+
+				glm::vec4 result = Sample(state.Textures[0], uv) * weights[0];
+				for (int32_t i = 1; i < 5; i++)
+				{
+					result += Sample(state.Textures[0], uv - step * (float)i) * weights[i];
+					result += Sample(state.Textures[0], uv + step * (float)i) * weights[i];
+				}
+				return glm::vec4(result.x, result.y, result.z, 1.0f);
+			}
+
+			default:
+				return glm::vec4(0.0f);
+			}
+		}
+
+		//same blend functions as OpenGLRendererAPI::SetBlendMode
+		template<RenderingBlendMode BlendMode>
+		static inline void BlendPixel(uint8_t* target, const glm::vec4& source)
+		{
+#ifdef AINAN_SOFTWARE_SSE2
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.0f);
+
+			__m128 src = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&source.x), zero), one);
+
+			int32_t packedTarget;
+			memcpy(&packedTarget, target, sizeof(int32_t));
+			__m128i targetInt = _mm_cvtsi32_si128(packedTarget);
+			targetInt = _mm_unpacklo_epi8(targetInt, _mm_setzero_si128());
+			targetInt = _mm_unpacklo_epi16(targetInt, _mm_setzero_si128());
+			__m128 dst = _mm_mul_ps(_mm_cvtepi32_ps(targetInt), _mm_set1_ps(1.0f / 255.0f));
+
+			__m128 result;
+			if constexpr (BlendMode == RenderingBlendMode::Additive)
+			{
+				__m128 srcAlpha = _mm_shuffle_ps(src, src, _MM_SHUFFLE(3, 3, 3, 3));
+				__m128 dstAlpha = _mm_shuffle_ps(dst, dst, _MM_SHUFFLE(3, 3, 3, 3));
+				result = _mm_add_ps(_mm_mul_ps(src, srcAlpha), _mm_mul_ps(dst, dstAlpha));
+			}
+			else if constexpr (BlendMode == RenderingBlendMode::Screen)
+				result = _mm_add_ps(src, _mm_mul_ps(dst, _mm_sub_ps(one, src)));
+			else
+				result = src;
+
+			result = _mm_min_ps(_mm_max_ps(result, zero), one);
+			__m128i resultInt = _mm_cvtps_epi32(_mm_mul_ps(result, _mm_set1_ps(255.0f)));
+			resultInt = _mm_packs_epi32(resultInt, resultInt);
+			resultInt = _mm_packus_epi16(resultInt, resultInt);
+			packedTarget = _mm_cvtsi128_si32(resultInt);
+			memcpy(target, &packedTarget, sizeof(int32_t));
+#else
+			glm::vec4 src = glm::clamp(source, 0.0f, 1.0f);
+			glm::vec4 dst = glm::vec4(target[0], target[1], target[2], target[3]) * (1.0f / 255.0f);
+
+			glm::vec4 result;
+			if constexpr (BlendMode == RenderingBlendMode::Additive)
+				result = src * src.w + dst * dst.w;
+			else if constexpr (BlendMode == RenderingBlendMode::Screen)
+				result = src + dst * (1.0f - src);
+			else
+				result = src;
+
+			result = glm::clamp(result, 0.0f, 1.0f) * 255.0f;
+			for (int32_t i = 0; i < 4; i++)
+				target[i] = (uint8_t)std::lround(result[i]);
+#endif // AINAN_SOFTWARE_SSE2
+		}
+
+		template<RenderingBlendMode BlendMode>
+		static void RasterizeTriangle(PixelBuffer& target, const TriangleSetup& triangle,
+			int32_t minX, int32_t minY, int32_t maxX, int32_t maxY,
+			const std::vector<RasterVertex>& vertices, const FragmentState& state)
+		{
+			const RasterVertex& v0 = vertices[triangle.Vertices[0]];
+			const RasterVertex& v1 = vertices[triangle.Vertices[1]];
+			const RasterVertex& v2 = vertices[triangle.Vertices[2]];
+
+			//how much each edge function changes when moving one pixel in x or y
+			int64_t stepX[3], stepY[3];
+			for (int32_t i = 0; i < 3; i++)
+			{
+				int32_t a = (i + 1) % 3;
+				int32_t b = (i + 2) % 3;
+				stepX[i] = -(triangle.Y[b] - triangle.Y[a]) * c_SubPixelScale;
+				stepY[i] = (triangle.X[b] - triangle.X[a]) * c_SubPixelScale;
+			}
+
+			//evaluate at the center of the first pixel
+			int64_t startX = (int64_t)minX * c_SubPixelScale + c_SubPixelScale / 2;
+			int64_t startY = (int64_t)minY * c_SubPixelScale + c_SubPixelScale / 2;
+			int64_t rowWeights[3];
+			for (int32_t i = 0; i < 3; i++)
+			{
+				int32_t a = (i + 1) % 3;
+				int32_t b = (i + 2) % 3;
+				rowWeights[i] = EdgeFunction(triangle.X[a], triangle.Y[a], triangle.X[b], triangle.Y[b], startX, startY);
+				//pixels exactly on an edge only belong to the triangle if it is a top or left edge
+				if (!triangle.TopLeft[i])
+					rowWeights[i] -= 1;
+			}
+
+			for (int32_t y = minY; y < maxY; y++)
+			{
+				int64_t w0 = rowWeights[0];
+				int64_t w1 = rowWeights[1];
+				int64_t w2 = rowWeights[2];
+				uint8_t* pixel = &target.Data[((size_t)y * target.Width + minX) * 4];
+
+				for (int32_t x = minX; x < maxX; x++, pixel += 4)
+				{
+					if ((w0 | w1 | w2) >= 0)
+					{
+						float l0 = (float)w0 * triangle.InverseArea;
+						float l1 = (float)w1 * triangle.InverseArea;
+						float l2 = 1.0f - l0 - l1;
+
+						glm::vec4 color = v0.Color * l0 + v1.Color * l1 + v2.Color * l2;
+						glm::vec2 uv = v0.TextureCoordinates * l0 + v1.TextureCoordinates * l1 + v2.TextureCoordinates * l2;
+
+						//the texture index is flat in practice, take it from the provoking vertex
+						BlendPixel<BlendMode>(pixel, ShadeFragment(state, color, uv, v2.TextureSlot));
+					}
+
+					w0 += stepX[0];
+					w1 += stepX[1];
+					w2 += stepX[2];
+				}
+
+				for (int32_t i = 0; i < 3; i++)
+					rowWeights[i] += stepY[i];
+			}
+		}
+
+		template<RenderingBlendMode BlendMode>
+		static void RasterizeLine(PixelBuffer& target, const Rectangle& clip, const RasterVertex& start, const RasterVertex& end, const FragmentState& state)
+		{
+			glm::vec2 delta = end.Position - start.Position;
+			int32_t steps = (int32_t)std::ceil(std::max(std::abs(delta.x), std::abs(delta.y)));
+			if (steps == 0)
+				steps = 1;
+
+			for (int32_t i = 0; i <= steps; i++)
+			{
+				float t = (float)i / steps;
+				glm::vec2 position = start.Position + delta * t;
+				int32_t x = (int32_t)std::floor(position.x);
+				int32_t y = (int32_t)std::floor(position.y);
+				if (x < clip.X || y < clip.Y || x >= clip.X + clip.Width || y >= clip.Y + clip.Height)
+					continue;
+
+				glm::vec4 color = glm::mix(start.Color, end.Color, t);
+				glm::vec2 uv = glm::mix(start.TextureCoordinates, end.TextureCoordinates, t);
+				BlendPixel<BlendMode>(&target.Data[((size_t)y * target.Width + x) * 4], ShadeFragment(state, color, uv, end.TextureSlot));
+			}
+		}
+
+		//the clip rectangle is the viewport limited to the target size
+		static Rectangle GetTargetClip(const PixelBuffer& target, const Rectangle& clipRect)
+		{
+			Rectangle clip;
+			clip.X = std::max(clipRect.X, 0);
+			clip.Y = std::max(clipRect.Y, 0);
+			clip.Width = std::min(clipRect.X + clipRect.Width, target.Width) - clip.X;
+			clip.Height = std::min(clipRect.Y + clipRect.Height, target.Height) - clip.Y;
+			return clip;
+		}
+
+		SoftwareRasterizer::SoftwareRasterizer(uint32_t threadCount)
+		{
+			//the calling thread takes part in the work, so we need one less worker
+			for (uint32_t i = 1; i < threadCount; i++)
+				m_Workers.push_back(std::thread(&SoftwareRasterizer::WorkerLoop, this));
+		}
+
+		SoftwareRasterizer::~SoftwareRasterizer()
+		{
+			{
+				std::lock_guard lock(m_Mutex);
+				m_Destroy = true;
+			}
+			m_JobCV.notify_all();
+
+			for (auto& worker : m_Workers)
+				worker.join();
+		}
+
+		void SoftwareRasterizer::DrawTriangles(PixelBuffer& target, const Rectangle& clipRect,
+			const std::vector<RasterVertex>& vertices, const std::vector<uint32_t>& indices,
+			const FragmentState& state, RenderingBlendMode blendMode)
+		{
+			Rectangle clip = GetTargetClip(target, clipRect);
+			if (clip.Width <= 0 || clip.Height <= 0)
+				return;
+
+			//setup every triangle once
+			std::vector<TriangleSetup> triangles;
+			triangles.reserve(indices.size() / 3);
+			for (size_t i = 0; i + 2 < indices.size(); i += 3)
+			{
+				TriangleSetup triangle;
+				triangle.Vertices[0] = indices[i + 0];
+				triangle.Vertices[1] = indices[i + 1];
+				triangle.Vertices[2] = indices[i + 2];
+				if (triangle.Vertices[0] >= vertices.size() || triangle.Vertices[1] >= vertices.size() || triangle.Vertices[2] >= vertices.size())
+					continue;
+
+				for (int32_t j = 0; j < 3; j++)
+				{
+					triangle.X[j] = ToFixed(vertices[triangle.Vertices[j]].Position.x);
+					triangle.Y[j] = ToFixed(vertices[triangle.Vertices[j]].Position.y);
+				}
+
+				int64_t area = EdgeFunction(triangle.X[0], triangle.Y[0], triangle.X[1], triangle.Y[1], triangle.X[2], triangle.Y[2]);
+				if (area == 0)
+					continue;
+
+				//we don't cull, so clockwise triangles are flipped to counter clockwise
+				if (area < 0)
+				{
+					std::swap(triangle.X[1], triangle.X[2]);
+					std::swap(triangle.Y[1], triangle.Y[2]);
+					std::swap(triangle.Vertices[1], triangle.Vertices[2]);
+					area = -area;
+				}
+				triangle.InverseArea = 1.0f / (float)area;
+
+				for (int32_t j = 0; j < 3; j++)
+				{
+					int32_t a = (j + 1) % 3;
+					int32_t b = (j + 2) % 3;
+					int64_t dx = triangle.X[b] - triangle.X[a];
+					int64_t dy = triangle.Y[b] - triangle.Y[a];
+					//rows go up, so in a counter clockwise triangle left edges go down and top edges go left
+					triangle.TopLeft[j] = dy < 0 || (dy == 0 && dx < 0);
+				}
+
+				int64_t minX = std::min({ triangle.X[0], triangle.X[1], triangle.X[2] });
+				int64_t minY = std::min({ triangle.Y[0], triangle.Y[1], triangle.Y[2] });
+				int64_t maxX = std::max({ triangle.X[0], triangle.X[1], triangle.X[2] });
+				int64_t maxY = std::max({ triangle.Y[0], triangle.Y[1], triangle.Y[2] });
+
+				//pixels whose centers can be inside the triangle
+				triangle.MinX = (int32_t)std::max<int64_t>((minX - c_SubPixelScale / 2 + c_SubPixelScale - 1) >> c_SubPixelBits, clip.X);
+				triangle.MinY = (int32_t)std::max<int64_t>((minY - c_SubPixelScale / 2 + c_SubPixelScale - 1) >> c_SubPixelBits, clip.Y);
+				triangle.MaxX = (int32_t)std::min<int64_t>(((maxX - c_SubPixelScale / 2) >> c_SubPixelBits) + 1, clip.X + clip.Width);
+				triangle.MaxY = (int32_t)std::min<int64_t>(((maxY - c_SubPixelScale / 2) >> c_SubPixelBits) + 1, clip.Y + clip.Height);
+				if (triangle.MinX >= triangle.MaxX || triangle.MinY >= triangle.MaxY)
+					continue;
+
+				triangles.push_back(triangle);
+			}
+
+			if (triangles.size() == 0)
+				return;
+
+			//bin the triangles into the tiles they overlap, in submission order
+			int32_t tilesX = (target.Width + c_TileSize - 1) / c_TileSize;
+			int32_t tilesY = (target.Height + c_TileSize - 1) / c_TileSize;
+			m_TileBins.resize((size_t)tilesX * tilesY);
+			for (auto& bin : m_TileBins)
+				bin.clear();
+
+			for (uint32_t i = 0; i < triangles.size(); i++)
+			{
+				auto& triangle = triangles[i];
+				for (int32_t tileY = triangle.MinY / c_TileSize; tileY <= (triangle.MaxY - 1) / c_TileSize; tileY++)
+					for (int32_t tileX = triangle.MinX / c_TileSize; tileX <= (triangle.MaxX - 1) / c_TileSize; tileX++)
+						m_TileBins[(size_t)tileY * tilesX + tileX].push_back(i);
+			}
+
+			std::vector<uint32_t> activeTiles;
+			for (uint32_t i = 0; i < m_TileBins.size(); i++)
+				if (m_TileBins[i].size() > 0)
+					activeTiles.push_back(i);
+
+			auto rasterizeTiles = [&](auto blendModeConstant)
+			{
+				constexpr RenderingBlendMode mode = decltype(blendModeConstant)::value;
+				std::function<void(uint32_t)> job = [&](uint32_t jobIndex)
+				{
+					uint32_t tile = activeTiles[jobIndex];
+					int32_t tileMinX = (int32_t)(tile % tilesX) * c_TileSize;
+					int32_t tileMinY = (int32_t)(tile / tilesX) * c_TileSize;
+					int32_t tileMaxX = tileMinX + c_TileSize;
+					int32_t tileMaxY = tileMinY + c_TileSize;
+
+					//each tile is owned by one thread, so no two threads ever touch the same pixel
+					for (uint32_t triangleIndex : m_TileBins[tile])
+					{
+						auto& triangle = triangles[triangleIndex];
+						RasterizeTriangle<mode>(target, triangle,
+							std::max(triangle.MinX, tileMinX), std::max(triangle.MinY, tileMinY),
+							std::min(triangle.MaxX, tileMaxX), std::min(triangle.MaxY, tileMaxY),
+							vertices, state);
+					}
+				};
+				RunParallel((uint32_t)activeTiles.size(), job);
+			};
+
+			switch (blendMode)
+			{
+			case RenderingBlendMode::Additive:
+				rasterizeTiles(std::integral_constant<RenderingBlendMode, RenderingBlendMode::Additive>());
+				break;
+
+			case RenderingBlendMode::Screen:
+				rasterizeTiles(std::integral_constant<RenderingBlendMode, RenderingBlendMode::Screen>());
+				break;
+
+			default:
+				rasterizeTiles(std::integral_constant<RenderingBlendMode, RenderingBlendMode::Overlay>());
+				break;
+			}
+		}
+
+		void SoftwareRasterizer::DrawLines(PixelBuffer& target, const Rectangle& clipRect,
+			const std::vector<RasterVertex>& vertices, const std::vector<uint32_t>& indices,
+			const FragmentState& state, RenderingBlendMode blendMode)
+		{
+			Rectangle clip = GetTargetClip(target, clipRect);
+			if (clip.Width <= 0 || clip.Height <= 0)
+				return;
+
+			//lines are thin and few, so they are drawn on the calling thread
+			for (size_t i = 0; i + 1 < indices.size(); i += 2)
+			{
+				if (indices[i] >= vertices.size() || indices[i + 1] >= vertices.size())
+					continue;
+
+				auto& start = vertices[indices[i]];
+				auto& end = vertices[indices[i + 1]];
+				switch (blendMode)
+				{
+				case RenderingBlendMode::Additive:
+					RasterizeLine<RenderingBlendMode::Additive>(target, clip, start, end, state);
+					break;
+
+				case RenderingBlendMode::Screen:
+					RasterizeLine<RenderingBlendMode::Screen>(target, clip, start, end, state);
+					break;
+
+				default:
+					RasterizeLine<RenderingBlendMode::Overlay>(target, clip, start, end, state);
+					break;
+				}
+			}
+		}
+
+		void SoftwareRasterizer::Clear(PixelBuffer& target, const glm::vec4& color)
+		{
+			uint8_t clearColor[4];
+			for (int32_t i = 0; i < 4; i++)
+				clearColor[i] = (uint8_t)std::lround(std::clamp(color[i], 0.0f, 1.0f) * 255.0f);
+
+			uint32_t packedColor;
+			memcpy(&packedColor, clearColor, sizeof(uint32_t));
+
+			uint32_t* pixels = (uint32_t*)target.Data.data();
+			std::fill(pixels, pixels + (size_t)target.Width * target.Height, packedColor);
+		}
+
+		void SoftwareRasterizer::RunParallel(uint32_t jobCount, const std::function<void(uint32_t)>& job)
+		{
+			if (jobCount == 0)
+				return;
+
+			//not worth waking up the workers
+			if (jobCount == 1 || m_Workers.size() == 0)
+			{
+				for (uint32_t i = 0; i < jobCount; i++)
+					job(i);
+				return;
+			}
+
+			{
+				std::unique_lock lock(m_Mutex);
+				//a worker that woke up late for the previous batch might still be leaving
+				m_DoneCV.wait(lock, [this]() { return m_ActiveWorkers == 0; });
+
+				m_Job = &job;
+				m_JobCount = jobCount;
+				m_NextJob = 0;
+				m_FinishedJobs = 0;
+				m_Generation++;
+			}
+			m_JobCV.notify_all();
+
+			ExecuteJobs();
+
+			std::unique_lock lock(m_Mutex);
+			m_DoneCV.wait(lock, [this, jobCount]() { return m_FinishedJobs == jobCount && m_ActiveWorkers == 0; });
+			m_Job = nullptr;
+		}
+
+		void SoftwareRasterizer::WorkerLoop()
+		{
+			uint64_t lastGeneration = 0;
+			while (true)
+			{
+				std::unique_lock lock(m_Mutex);
+				m_JobCV.wait(lock, [this, lastGeneration]() { return m_Destroy || m_Generation != lastGeneration; });
+				if (m_Destroy)
+					return;
+
+				lastGeneration = m_Generation;
+				m_ActiveWorkers++;
+				lock.unlock();
+
+				ExecuteJobs();
+
+				lock.lock();
+				m_ActiveWorkers--;
+				if (m_ActiveWorkers == 0)
+					m_DoneCV.notify_all();
+			}
+		}
+
+		void SoftwareRasterizer::ExecuteJobs()
+		{
+			while (true)
+			{
+				uint32_t jobIndex = m_NextJob.fetch_add(1);
+				if (jobIndex >= m_JobCount)
+					return;
+
+				(*m_Job)(jobIndex);
+				m_FinishedJobs++;
+			}
+		}
+	}
+}
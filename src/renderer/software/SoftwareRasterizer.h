@@ -0,0 +1,108 @@
+#pragma once
+
+#include "renderer/RendererAPI.h"
+#include "renderer/Rectangle.h"
+
+#include <thread>
+#include <condition_variable>
+
+namespace Ainan {
+	namespace Software {
+
+		//same as the number of samplers in QuadBatch.frag
+		constexpr int32_t c_MaxSoftwareTextureSlots = 16;
+		constexpr int32_t c_MaxSoftwareUniformBufferSlots = 16;
+
+		//RGBA8 pixels with the first row being the bottom of the image, same as OpenGL
+		struct PixelBuffer
+		{
+			int32_t Width = 0;
+			int32_t Height = 0;
+			std::vector<uint8_t> Data;
+
+			void Resize(int32_t width, int32_t height)
+			{
+				Width = width;
+				Height = height;
+				Data.assign((size_t)width * height * 4, 0);
+			}
+		};
+
+		//C++ equivalents of the GLSL shaders in the shaders folder
+		enum class ShaderType
+		{
+			QuadBatch,
+			FlatColor,
+			Image,
+			Blur,
+			Unsupported
+		};
+
+		//a vertex after the vertex shader, position is in window coordinates
+		struct RasterVertex
+		{
+			glm::vec2 Position = { 0.0f, 0.0f };
+			glm::vec4 Color = { 1.0f, 1.0f, 1.0f, 1.0f };
+			glm::vec2 TextureCoordinates = { 0.0f, 0.0f };
+			float TextureSlot = 0.0f;
+		};
+
+		//everything the fragment shader needs to know
+		struct FragmentState
+		{
+			ShaderType Shader = ShaderType::Unsupported;
+			std::array<const PixelBuffer*, c_MaxSoftwareTextureSlots> Textures = {};
+			glm::vec4 FlatColor = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+			//blur parameters
+			glm::vec2 BlurResolution = { 1.0f, 1.0f };
+			glm::vec2 BlurDirection = { 1.0f, 0.0f };
+			float BlurRadius = 0.0f;
+		};
+
+		//splits the render target into tiles, bins triangles into the tiles they touch
+		//and rasterizes the tiles in parallel, triangles inside a tile are drawn in submission order
+		class SoftwareRasterizer
+		{
+		public:
+			SoftwareRasterizer(uint32_t threadCount);
+			~SoftwareRasterizer();
+
+			//indices are triplets of vertex indices
+			void DrawTriangles(PixelBuffer& target, const Rectangle& clipRect,
+				const std::vector<RasterVertex>& vertices, const std::vector<uint32_t>& indices,
+				const FragmentState& state, RenderingBlendMode blendMode);
+
+			//indices are pairs of vertex indices
+			void DrawLines(PixelBuffer& target, const Rectangle& clipRect,
+				const std::vector<RasterVertex>& vertices, const std::vector<uint32_t>& indices,
+				const FragmentState& state, RenderingBlendMode blendMode);
+
+			void Clear(PixelBuffer& target, const glm::vec4& color);
+
+			uint32_t GetThreadCount() const { return (uint32_t)m_Workers.size() + 1; }
+
+		private:
+			//runs job(0) to job(jobCount - 1) on the worker threads and the calling thread, returns when all of them finish
+			void RunParallel(uint32_t jobCount, const std::function<void(uint32_t)>& job);
+			void WorkerLoop();
+			void ExecuteJobs();
+
+		private:
+			std::vector<std::thread> m_Workers;
+			std::mutex m_Mutex;
+			std::condition_variable m_JobCV;
+			std::condition_variable m_DoneCV;
+			const std::function<void(uint32_t)>* m_Job = nullptr;
+			uint32_t m_JobCount = 0;
+			uint64_t m_Generation = 0;
+			uint32_t m_ActiveWorkers = 0;
+			std::atomic<uint32_t> m_NextJob = 0;
+			std::atomic<uint32_t> m_FinishedJobs = 0;
+			bool m_Destroy = false;
+
+			//reused between draws to avoid allocations
+			std::vector<std::vector<uint32_t>> m_TileBins;
+		};
+	}
+}
@@ -0,0 +1,228 @@
+#include "SoftwareRendererAPI.h"
+#include "SoftwareShaderProgram.h"
+#include "SoftwareVertexBuffer.h"
+#include "SoftwareIndexBuffer.h"
+#include "SoftwareUniformBuffer.h"
+
+namespace Ainan {
+	namespace Software {
+
+		SoftwareRendererAPI* SoftwareRendererAPI::SingletonInstance = nullptr;
+
+		static uint32_t GetRasterizerThreadCount()
+		{
+			uint32_t threadCount = std::thread::hardware_concurrency();
+			return threadCount == 0 ? 1 : threadCount;
+		}
+
+		SoftwareRendererAPI::SoftwareRendererAPI(const glm::vec2& windowBufferSize) :
+			Rasterizer(GetRasterizerThreadCount()),
+			WindowBuffer(std::make_shared<PixelBuffer>())
+		{
+			SingletonInstance = this;
+			Context.ThreadCount = Rasterizer.GetThreadCount();
+
+			WindowBuffer->Resize((int32_t)windowBufferSize.x, (int32_t)windowBufferSize.y);
+			Viewport.Width = WindowBuffer->Width;
+			Viewport.Height = WindowBuffer->Height;
+		}
+
+		SoftwareRendererAPI::~SoftwareRendererAPI()
+		{
+			SingletonInstance = nullptr;
+		}
+
+		void SoftwareRendererAPI::Draw(ShaderProgram& shader, Primitive primitive, uint32_t vertexCount)
+		{
+			if (SequentialIndices.size() < vertexCount)
+			{
+				SequentialIndices.resize(vertexCount);
+				for (uint32_t i = 0; i < vertexCount; i++)
+					SequentialIndices[i] = i;
+			}
+
+			DrawIndexed(shader, primitive, SequentialIndices.data(), vertexCount);
+		}
+
+		void SoftwareRendererAPI::Draw(ShaderProgram& shader, Primitive primitive, const IndexBuffer& indexBuffer)
+		{
+			auto& indices = ((const SoftwareIndexBuffer&)indexBuffer).m_Indices;
+			DrawIndexed(shader, primitive, indices.data(), (uint32_t)indices.size());
+		}
+
+		void SoftwareRendererAPI::Draw(ShaderProgram& shader, Primitive primitive, const IndexBuffer& indexBuffer, uint32_t vertexCount)
+		{
+			auto& indices = ((const SoftwareIndexBuffer&)indexBuffer).m_Indices;
+			DrawIndexed(shader, primitive, indices.data(), std::min(vertexCount, (uint32_t)indices.size()));
+		}
+
+		void SoftwareRendererAPI::DrawIndexed(ShaderProgram& shader, Primitive primitive, const uint32_t* indices, uint32_t indexCount)
+		{
+			auto& program = (SoftwareShaderProgram&)shader;
+			if (program.Type == ShaderType::Unsupported)
+			{
+				if (!program.ReportedUnsupported)
+				{
+					AINAN_LOG_WARNING("Shader " + program.Name + " is not supported by the software renderer, its draws are skipped");
+					program.ReportedUnsupported = true;
+				}
+				return;
+			}
+
+			if (!BoundVertexBuffer || indexCount == 0)
+				return;
+			const SoftwareVertexData& vertexData = *BoundVertexBuffer;
+			PixelBuffer& target = BoundRenderTarget ? *BoundRenderTarget : *WindowBuffer;
+
+			FragmentState state;
+			state.Shader = program.Type;
+			for (size_t i = 0; i < BoundTextures.size(); i++)
+				state.Textures[i] = BoundTextures[i].get();
+
+			//read the uniforms the shaders use, using the same packed layouts the Renderer fills them with
+			glm::mat4 viewProjection = glm::mat4(1.0f);
+			bool usesViewProjection = program.Type == ShaderType::QuadBatch || program.Type == ShaderType::FlatColor;
+			if (usesViewProjection && BoundUniformBuffers[0])
+				BoundUniformBuffers[0]->Read(0, viewProjection);
+
+			if (program.Type == ShaderType::FlatColor && BoundUniformBuffers[1])
+				BoundUniformBuffers[1]->Read(0, state.FlatColor);
+
+			if (program.Type == ShaderType::Blur && BoundUniformBuffers[1])
+			{
+				BoundUniformBuffers[1]->Read(0, state.BlurResolution);
+				BoundUniformBuffers[1]->Read(8, state.BlurDirection);
+				BoundUniformBuffers[1]->Read(16, state.BlurRadius);
+			}
+
+			//only run the vertex shader on the vertices this draw can reference,
+			//the batch renderer's vertex buffer is much bigger than what it usually uses
+			uint32_t vertexCount = 0;
+			for (uint32_t i = 0; i < indexCount; i++)
+				vertexCount = std::max(vertexCount, indices[i] + 1);
+			vertexCount = std::min(vertexCount, vertexData.GetVertexCount());
+
+			TransformedVertices.resize(vertexCount);
+			for (uint32_t i = 0; i < vertexCount; i++)
+			{
+				RasterVertex& vertex = TransformedVertices[i];
+				glm::vec4 position = vertexData.ReadAttribute(i, 0);
+				glm::vec4 clipPosition = glm::vec4(position.x, position.y, 0.0f, 1.0f);
+				if (usesViewProjection)
+					clipPosition = viewProjection * clipPosition;
+
+				glm::vec2 ndc = glm::vec2(clipPosition) / clipPosition.w;
+				vertex.Position.x = Viewport.X + (ndc.x + 1.0f) * 0.5f * Viewport.Width;
+				vertex.Position.y = Viewport.Y + (ndc.y + 1.0f) * 0.5f * Viewport.Height;
+
+				switch (program.Type)
+				{
+				case ShaderType::QuadBatch:
+					vertex.Color = vertexData.ReadAttribute(i, 1);
+					vertex.TextureSlot = vertexData.ReadAttribute(i, 2).x;
+					vertex.TextureCoordinates = glm::vec2(vertexData.ReadAttribute(i, 3));
+					break;
+
+				case ShaderType::Image:
+				case ShaderType::Blur:
+					vertex.TextureCoordinates = glm::vec2(vertexData.ReadAttribute(i, 1));
+					break;
+
+				default:
+					break;
+				}
+			}
+
+			//primitive assembly
+			AssembledIndices.clear();
+			switch (primitive)
+			{
+			case Primitive::Triangles:
+			case Primitive::Lines:
+				AssembledIndices.assign(indices, indices + indexCount);
+				break;
+
+			case Primitive::TriangleFan:
+				for (uint32_t i = 1; i + 1 < indexCount; i++)
+				{
+					AssembledIndices.push_back(indices[0]);
+					AssembledIndices.push_back(indices[i]);
+					AssembledIndices.push_back(indices[i + 1]);
+				}
+				break;
+			}
+
+			if (primitive == Primitive::Lines)
+				Rasterizer.DrawLines(target, Viewport, TransformedVertices, AssembledIndices, state, BlendMode);
+			else
+				Rasterizer.DrawTriangles(target, Viewport, TransformedVertices, AssembledIndices, state, BlendMode);
+		}
+
+		//there is no ImGui without a window
+		void SoftwareRendererAPI::InitImGui()
+		{}
+
+		void SoftwareRendererAPI::ImGuiNewFrame()
+		{}
+
+		void SoftwareRendererAPI::ImGuiEndFrame()
+		{}
+
+		void SoftwareRendererAPI::DrawImGui(ImDrawData* drawData)
+		{}
+
+		void SoftwareRendererAPI::ClearScreen()
+		{
+			//same as the default GL clear color
+			PixelBuffer& target = BoundRenderTarget ? *BoundRenderTarget : *WindowBuffer;
+			Rasterizer.Clear(target, glm::vec4(0.0f, 0.0f, 0.0f, 0.0f));
+		}
+
+		void SoftwareRendererAPI::Present()
+		{}
+
+		void SoftwareRendererAPI::SetVSync(bool enabled)
+		{}
+
+		void SoftwareRendererAPI::RecreateSwapchain(const glm::vec2& newSwapchainSize)
+		{
+			WindowBuffer->Resize((int32_t)newSwapchainSize.x, (int32_t)newSwapchainSize.y);
+		}
+
+		void SoftwareRendererAPI::SetRenderTargetApplicationWindow()
+		{
+			BoundRenderTarget.reset();
+		}
+
+		void SoftwareRendererAPI::SetViewport(const Rectangle& viewport)
+		{
+			Viewport = viewport;
+		}
+
+		void SoftwareRendererAPI::SetBlendMode(RenderingBlendMode blendMode)
+		{
+			if (blendMode != RenderingBlendMode::NotSpecified)
+				BlendMode = blendMode;
+		}
+
+		void SoftwareRendererAPI::BeginGPUTimer(RenderPass pass)
+		{
+			TimedPass = pass;
+			TimedPassStart = std::chrono::high_resolution_clock::now();
+		}
+
+		void SoftwareRendererAPI::EndGPUTimer()
+		{
+			auto now = std::chrono::high_resolution_clock::now();
+			CurrentPassTimes[(size_t)TimedPass] += std::chrono::duration<double, std::milli>(now - TimedPassStart).count();
+			TimedPass = RenderPass::Count;
+		}
+
+		bool SoftwareRendererAPI::ResolveGPUTimers(RenderPassTimes& passTimesMs)
+		{
+			passTimesMs = CurrentPassTimes;
+			CurrentPassTimes.fill(0.0);
+			return true;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "renderer/RendererAPI.h"
+#include "renderer/ShaderProgram.h"
+#include "renderer/IndexBuffer.h"
+#include "renderer/VertexBuffer.h"
+#include "renderer/Rectangle.h"
+
+#include "SoftwareRendererContext.h"
+#include "SoftwareRasterizer.h"
+
+namespace Ainan {
+	namespace Software {
+
+		struct SoftwareVertexData;
+		class SoftwareUniformBuffer;
+
+		//renders on the cpu with a tiled rasterizer that runs on every core,
+		//only the shaders used by the batch renderer, lines and postprocessing are implemented (see ShaderType),
+		//there is no window surface so it is always used headless and everything has to be drawn to a FrameBuffer
+		class SoftwareRendererAPI : public RendererAPI
+		{
+		public:
+			//the window buffer stands in for the window, so it is made the size of the output
+			SoftwareRendererAPI(const glm::vec2& windowBufferSize);
+			virtual ~SoftwareRendererAPI();
+
+			// Inherited via RendererAPI
+			virtual void Draw(ShaderProgram& shader, Primitive primitive, uint32_t vertexCount) override;
+			virtual void Draw(ShaderProgram& shader, Primitive primitive, const IndexBuffer& indexBuffer) override;
+			virtual void Draw(ShaderProgram& shader, Primitive primitive, const IndexBuffer& indexBuffer, uint32_t vertexCount) override;
+			virtual void InitImGui() override;
+			virtual void ImGuiNewFrame() override;
+			virtual void ImGuiEndFrame() override;
+			virtual void DrawImGui(ImDrawData* drawData) override;
+			virtual void ClearScreen() override;
+			virtual void Present() override;
+			virtual void SetVSync(bool enabled) override;
+			virtual void RecreateSwapchain(const glm::vec2& newSwapchainSize) override;
+			virtual void SetRenderTargetApplicationWindow() override;
+
+			virtual void SetViewport(const Rectangle& viewport) override;
+
+			virtual RendererContext* GetContext() override { return &Context; };
+
+			virtual void SetBlendMode(RenderingBlendMode blendMode) override;
+
+			//rasterization runs synchronously inside the draw calls, so the "gpu" time of a pass is just its wall time
+			virtual void BeginGPUTimer(RenderPass pass) override;
+			virtual void EndGPUTimer() override;
+			virtual bool ResolveGPUTimers(RenderPassTimes& passTimesMs) override;
+
+			SoftwareRendererContext Context;
+
+			static SoftwareRendererAPI& Singleton() { assert(SingletonInstance); return *SingletonInstance; };
+
+			PixelBuffer& GetWindowBuffer() { return *WindowBuffer; };
+
+		private:
+			void DrawIndexed(ShaderProgram& shader, Primitive primitive, const uint32_t* indices, uint32_t indexCount);
+
+		public:
+			//bound state, set by the resource classes the same way they would bind themselves in OpenGL
+			std::shared_ptr<const SoftwareVertexData> BoundVertexBuffer;
+			//nullptr means the application window
+			std::shared_ptr<PixelBuffer> BoundRenderTarget;
+			std::array<std::shared_ptr<PixelBuffer>, c_MaxSoftwareTextureSlots> BoundTextures;
+			std::array<std::shared_ptr<SoftwareUniformBuffer>, c_MaxSoftwareUniformBufferSlots> BoundUniformBuffers;
+
+		private:
+			static SoftwareRendererAPI* SingletonInstance;
+			SoftwareRasterizer Rasterizer;
+			//stands in for the swapchain so drawing to the window still works, nothing ever displays it
+			std::shared_ptr<PixelBuffer> WindowBuffer;
+			RenderingBlendMode BlendMode = RenderingBlendMode::Additive;
+			Rectangle Viewport;
+
+			//reused between draws to avoid allocations
+			std::vector<RasterVertex> TransformedVertices;
+			std::vector<uint32_t> SequentialIndices;
+			std::vector<uint32_t> AssembledIndices;
+
+			//timer data
+			RenderPass TimedPass = RenderPass::Count;
+			std::chrono::high_resolution_clock::time_point TimedPassStart;
+			RenderPassTimes CurrentPassTimes = {};
+		};
+	}
+}
@@ -0,0 +1,20 @@
+#include "SoftwareRendererContext.h"
+
+namespace Ainan {
+	namespace Software {
+		RendererType SoftwareRendererContext::GetType() const
+		{
+			return RendererType::Software;
+		}
+
+		std::string SoftwareRendererContext::GetVersionString()
+		{
+			return "1.0";
+		}
+
+		std::string SoftwareRendererContext::GetPhysicalDeviceName()
+		{
+			return "CPU (" + std::to_string(ThreadCount) + " threads)";
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "renderer/RendererContext.h"
+
+namespace Ainan {
+	namespace Software {
+		class SoftwareRendererContext : public RendererContext
+		{
+			virtual RendererType GetType() const override;
+			virtual std::string GetVersionString() override;
+			virtual std::string GetPhysicalDeviceName() override;
+
+		private:
+			uint32_t ThreadCount = 1;
+
+			friend class SoftwareRendererAPI;
+		};
+	}
+}
\ No newline at end of file
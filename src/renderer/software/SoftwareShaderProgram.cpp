@@ -0,0 +1,72 @@
+#include "SoftwareShaderProgram.h"
+#include "SoftwareRendererAPI.h"
+#include "SoftwareUniformBuffer.h"
+#include "SoftwareTexture.h"
+#include "SoftwareFrameBuffer.h"
+
+#include "renderer/Renderer.h"
+
+namespace Ainan {
+	namespace Software {
+
+		SoftwareShaderProgram::SoftwareShaderProgram(const std::string& vertPath, const std::string& fragPath)
+		{
+			//the fragment shader decides what we draw, the vertex shaders only differ in their inputs
+			Name = std::filesystem::path(fragPath).filename().string();
+
+			if (Name == "QuadBatch")
+				Type = ShaderType::QuadBatch;
+			else if (Name == "FlatColor")
+				Type = ShaderType::FlatColor;
+			else if (Name == "Image")
+				Type = ShaderType::Image;
+			else if (Name == "Blur")
+				Type = ShaderType::Blur;
+		}
+
+		void SoftwareShaderProgram::BindUniformBuffer(std::shared_ptr<UniformBuffer>& buffer, uint32_t slot, RenderingStage stage)
+		{
+			auto func = [this, &buffer, slot, stage]()
+			{
+				BindUniformBufferUnsafe(buffer, slot, stage);
+			};
+			Renderer::PushCommand(func);
+		}
+
+		void SoftwareShaderProgram::BindUniformBufferUnsafe(std::shared_ptr<UniformBuffer>& buffer, uint32_t slot, RenderingStage stage)
+		{
+			assert(slot < c_MaxSoftwareUniformBufferSlots);
+			SoftwareRendererAPI::Singleton().BoundUniformBuffers[slot] = std::static_pointer_cast<SoftwareUniformBuffer>(buffer);
+		}
+
+		void SoftwareShaderProgram::BindTexture(std::shared_ptr<Texture>& texture, uint32_t slot, RenderingStage stage)
+		{
+			auto func = [this, slot, stage, &texture]()
+			{
+				BindTextureUnsafe(texture, slot, stage);
+			};
+			Renderer::PushCommand(func);
+		}
+
+		void SoftwareShaderProgram::BindTextureUnsafe(std::shared_ptr<Texture>& texture, uint32_t slot, RenderingStage stage)
+		{
+			assert(slot < c_MaxSoftwareTextureSlots);
+			SoftwareRendererAPI::Singleton().BoundTextures[slot] = std::static_pointer_cast<SoftwareTexture>(texture)->m_Pixels;
+		}
+
+		void SoftwareShaderProgram::BindTexture(std::shared_ptr<FrameBuffer>& framebuffer, uint32_t slot, RenderingStage stage)
+		{
+			auto func = [this, slot, stage, &framebuffer]()
+			{
+				BindTextureUnsafe(framebuffer, slot, stage);
+			};
+			Renderer::PushCommand(func);
+		}
+
+		void SoftwareShaderProgram::BindTextureUnsafe(std::shared_ptr<FrameBuffer>& framebuffer, uint32_t slot, RenderingStage stage)
+		{
+			assert(slot < c_MaxSoftwareTextureSlots);
+			SoftwareRendererAPI::Singleton().BoundTextures[slot] = std::static_pointer_cast<SoftwareFrameBuffer>(framebuffer)->m_Pixels;
+		}
+	}
+}
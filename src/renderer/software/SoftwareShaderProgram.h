@@ -0,0 +1,36 @@
+#pragma once
+
+#include "renderer/ShaderProgram.h"
+#include "renderer/UniformBuffer.h"
+#include "SoftwareRasterizer.h"
+
+namespace Ainan {
+	namespace Software {
+
+		//there is nothing to compile, the shader name picks one of the fragment shaders built into the rasterizer
+		class SoftwareShaderProgram : public ShaderProgram
+		{
+		public:
+			SoftwareShaderProgram(const std::string& vertPath, const std::string& fragPath);
+			SoftwareShaderProgram() {}
+
+			//unsupported shaders are still valid, draws with them are skipped
+			virtual bool IsValid() const override { return true; }
+
+			virtual void BindUniformBuffer(std::shared_ptr<UniformBuffer>& buffer, uint32_t slot, RenderingStage stage) override;
+			virtual void BindUniformBufferUnsafe(std::shared_ptr<UniformBuffer>& buffer, uint32_t slot, RenderingStage stage) override;
+
+			virtual void BindTexture(std::shared_ptr<Texture>& texture, uint32_t slot, RenderingStage stage) override;
+			virtual void BindTextureUnsafe(std::shared_ptr<Texture>& texture, uint32_t slot, RenderingStage stage) override;
+
+			virtual void BindTexture(std::shared_ptr<FrameBuffer>& framebuffer, uint32_t slot, RenderingStage stage) override;
+			virtual void BindTextureUnsafe(std::shared_ptr<FrameBuffer>& framebuffer, uint32_t slot, RenderingStage stage) override;
+
+		public:
+			ShaderType Type = ShaderType::Unsupported;
+			std::string Name;
+			//so unsupported shaders are only reported once
+			bool ReportedUnsupported = false;
+		};
+	}
+}
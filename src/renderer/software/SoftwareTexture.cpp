@@ -0,0 +1,63 @@
+#include "SoftwareTexture.h"
+#include "renderer/Renderer.h"
+#include "renderer/TextureDiskCache.h"
+
+namespace Ainan {
+	namespace Software {
+
+		SoftwareTexture::SoftwareTexture(const glm::vec2& size, TextureFormat format, uint8_t* data) :
+			m_Pixels(std::make_shared<PixelBuffer>())
+		{
+			AllocateTexture(size, format, data);
+		}
+
+		void SoftwareTexture::AllocateTexture(const glm::vec2& size, TextureFormat format, uint8_t* data)
+		{
+			assert(format != TextureFormat::Unspecified);
+
+			m_Pixels->Resize((int32_t)size.x, (int32_t)size.y);
+			if (!data)
+				return;
+
+			//expand to RGBA the same way GL does, missing colors are 0 and missing alpha is 1
+			uint32_t bytesPerPixel = GetBytesPerPixel(format);
+			size_t pixelCount = (size_t)m_Pixels->Width * m_Pixels->Height;
+			if (bytesPerPixel == 4)
+			{
+				memcpy(m_Pixels->Data.data(), data, pixelCount * 4);
+				return;
+			}
+
+			for (size_t i = 0; i < pixelCount; i++)
+			{
+				uint8_t* target = &m_Pixels->Data[i * 4];
+				const uint8_t* source = &data[i * bytesPerPixel];
+				target[0] = source[0];
+				target[1] = bytesPerPixel > 1 ? source[1] : 0;
+				target[2] = bytesPerPixel > 2 ? source[2] : 0;
+				target[3] = 255;
+			}
+		}
+
+		void SoftwareTexture::SetImage(std::shared_ptr<Image> image)
+		{
+			auto func = [this, image]()
+			{
+				SetImageUnsafe(image);
+			};
+			Renderer::PushCommand(func);
+		}
+
+		void SoftwareTexture::SetImageUnsafe(std::shared_ptr<Image> image)
+		{
+			AllocateTexture({ image->m_Width, image->m_Height }, image->Format, image->m_Data);
+		}
+
+		//the rasterizer doesn't sample mips, so only the full size level is used
+		void SoftwareTexture::SetMipChainUnsafe(std::shared_ptr<TextureMipChain> chain)
+		{
+			auto& level = chain->Levels[0];
+			AllocateTexture({ level.Width, level.Height }, chain->Format, (uint8_t*)level.Data);
+		}
+	}
+}
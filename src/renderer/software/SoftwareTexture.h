@@ -0,0 +1,30 @@
+#pragma once
+
+#include "renderer/Texture.h"
+#include "renderer/Image.h"
+#include "SoftwareRasterizer.h"
+
+namespace Ainan {
+	namespace Software {
+
+		class SoftwareTexture : public Texture
+		{
+		public:
+			SoftwareTexture(const glm::vec2& size, TextureFormat format, uint8_t* data = nullptr);
+
+			virtual void SetImage(std::shared_ptr<Image> image) override;
+			virtual void SetImageUnsafe(std::shared_ptr<Image> image) override;
+			virtual void SetMipChainUnsafe(std::shared_ptr<TextureMipChain> chain) override;
+
+			virtual uint32_t GetMemorySize() const override { return (uint32_t)m_Pixels->Data.size(); };
+			virtual void* GetTextureID() override           { return m_Pixels.get(); };
+
+		private:
+			void AllocateTexture(const glm::vec2& size, TextureFormat format, uint8_t* data = nullptr);
+
+		public:
+			//always stored as RGBA so the rasterizer only has to deal with one format
+			std::shared_ptr<PixelBuffer> m_Pixels;
+		};
+	}
+}
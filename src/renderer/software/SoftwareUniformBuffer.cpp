@@ -0,0 +1,40 @@
+#include "SoftwareUniformBuffer.h"
+
+#include <numeric>
+
+namespace Ainan {
+	namespace Software {
+
+		SoftwareUniformBuffer::SoftwareUniformBuffer(const std::string& name, const VertexLayout& layout, void* data) :
+			m_Name(name)
+		{
+			uint32_t packedSize = std::accumulate(layout.begin(), layout.end(), 0,
+				[](const uint32_t& a, const VertexLayoutElement& b)
+				{
+					return a + b.GetSize();
+				});
+
+			m_Data.resize(packedSize);
+			if (data)
+				memcpy(m_Data.data(), data, packedSize);
+		}
+
+		void SoftwareUniformBuffer::UpdateData(void* data)
+		{
+			void* dataCpy = new uint8_t[m_Data.size()];
+			memcpy(dataCpy, data, m_Data.size());
+
+			auto func = [this, dataCpy]()
+			{
+				UpdateDataUnsafe(dataCpy);
+				delete[](uint8_t*)dataCpy;
+			};
+			Renderer::PushCommand(func);
+		}
+
+		void SoftwareUniformBuffer::UpdateDataUnsafe(void* data)
+		{
+			memcpy(m_Data.data(), data, m_Data.size());
+		}
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "renderer/UniformBuffer.h"
+#include "renderer/VertexBuffer.h"//for VertexLayout
+#include "renderer/Renderer.h"
+
+namespace Ainan {
+	namespace Software {
+
+		class SoftwareUniformBuffer : public UniformBuffer
+		{
+		public:
+			SoftwareUniformBuffer(const std::string& name, const VertexLayout& layout, void* data);
+
+			virtual void UpdateData(void* data) override;
+			virtual void UpdateDataUnsafe(void* data) override;
+
+			virtual std::string GetName() const override { return m_Name; };
+			virtual uint32_t GetPackedSize() const override { return (uint32_t)m_Data.size(); };
+			//the shaders are C++ so they read the packed data directly
+			virtual uint32_t GetAlignedSize() const override { return (uint32_t)m_Data.size(); };
+
+			//returns false if the buffer is too small
+			template<typename T>
+			bool Read(uint32_t offset, T& value) const
+			{
+				if (offset + sizeof(T) > m_Data.size())
+					return false;
+				memcpy(&value, &m_Data[offset], sizeof(T));
+				return true;
+			}
+
+		public:
+			std::vector<uint8_t> m_Data;
+			std::string m_Name = "";
+		};
+	}
+}
@@ -0,0 +1,51 @@
+#include "SoftwareVertexBuffer.h"
+#include "SoftwareRendererAPI.h"
+
+namespace Ainan {
+	namespace Software {
+
+		SoftwareVertexBuffer::SoftwareVertexBuffer(void* data, uint32_t size, const VertexLayout& layout) :
+			m_Data(std::make_shared<SoftwareVertexData>())
+		{
+			if (data)
+				m_Data->Bytes.assign((uint8_t*)data, (uint8_t*)data + size);
+			else
+				m_Data->Bytes.resize(size);
+
+			//attributes are tightly packed in the order of the layout, same as the OpenGL vertex buffer
+			for (auto& layoutPart : layout)
+			{
+				m_Data->AttributeOffsets.push_back(m_Data->Stride);
+				m_Data->AttributeComponents.push_back(GetShaderVariableComponentCount(layoutPart.Type));
+				m_Data->Stride += layoutPart.GetSize();
+			}
+		}
+
+		void SoftwareVertexBuffer::Bind() const
+		{
+			SoftwareRendererAPI::Singleton().BoundVertexBuffer = m_Data;
+		}
+
+		void SoftwareVertexBuffer::Unbind() const
+		{
+			SoftwareRendererAPI::Singleton().BoundVertexBuffer.reset();
+		}
+
+		void SoftwareVertexBuffer::UpdateData(int32_t offset, int32_t size, void* data)
+		{
+			auto func = [this, offset, size, data]()
+			{
+				UpdateDataUnsafe(offset, size, data);
+			};
+
+			Renderer::PushCommand(func);
+			Renderer::WaitUntilRendererIdle();
+		}
+
+		void SoftwareVertexBuffer::UpdateDataUnsafe(int32_t offset, int32_t size, void* data)
+		{
+			assert(offset + size <= (int32_t)m_Data->Bytes.size());
+			memcpy(m_Data->Bytes.data() + offset, data, size);
+		}
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "renderer/VertexBuffer.h"
+#include "renderer/ShaderProgram.h"
+#include "renderer/Renderer.h"
+
+namespace Ainan
+{
+	namespace Software {
+
+		//the vertex memory is shared with the renderer api while bound so it can't be freed in the middle of a draw
+		struct SoftwareVertexData
+		{
+			std::vector<uint8_t> Bytes;
+			std::vector<uint32_t> AttributeOffsets;
+			std::vector<uint32_t> AttributeComponents;
+			uint32_t Stride = 0;
+
+			uint32_t GetVertexCount() const { return Stride == 0 ? 0 : (uint32_t)(Bytes.size() / Stride); }
+
+			//missing components are filled the same way as GLSL does (0, 0, 0, 1)
+			glm::vec4 ReadAttribute(uint32_t vertex, uint32_t attribute) const
+			{
+				glm::vec4 result = { 0.0f, 0.0f, 0.0f, 1.0f };
+				if (attribute >= AttributeOffsets.size())
+					return result;
+
+				const uint8_t* source = &Bytes[(size_t)vertex * Stride + AttributeOffsets[attribute]];
+				memcpy(&result.x, source, std::min<uint32_t>(AttributeComponents[attribute], 4) * sizeof(float));
+				return result;
+			}
+		};
+
+		class SoftwareVertexBuffer : public VertexBuffer
+		{
+		public:
+			//size is in bytes
+			SoftwareVertexBuffer(void* data, uint32_t size, const VertexLayout& layout);
+
+			virtual void UpdateData(int32_t offset, int32_t size, void* data) override;
+			virtual void UpdateDataUnsafe(int32_t offset, int32_t size, void* data) override;
+			virtual uint32_t GetUsedMemory() const override { return (uint32_t)m_Data->Bytes.size(); };
+			virtual void Bind() const override;
+			virtual void Unbind() const override;
+
+		private:
+			std::shared_ptr<SoftwareVertexData> m_Data;
+		};
+	}
+}
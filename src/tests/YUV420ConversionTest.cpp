@@ -0,0 +1,141 @@
+#include "editor/Window.h"
+#include "editor/VideoEncoder.h"
+#include "renderer/Renderer.h"
+
+extern "C"
+{
+#include <libswscale/swscale.h>
+}
+
+//checks that the gpu yuv420 conversion (Renderer::ConvertToYUV420) is bit-exact with the swscale conversion of VideoEncoder,
+//both convert the same rendered frames and every byte of the y, u and v planes has to match,
+//registered with ctest, it needs a gpu (and a window) because that is where the conversion runs
+//usage: YUV420ConversionTest [opengl|d3d11]
+
+using namespace Ainan;
+
+struct PlaneDifference
+{
+	uint64_t MismatchedBytes = 0;
+	int32_t MaxDifference = 0;
+};
+
+static PlaneDifference ComparePlane(const uint8_t* gpu, int32_t gpuStride, const uint8_t* cpu, int32_t cpuStride, int32_t width, int32_t height)
+{
+	PlaneDifference result;
+	for (int32_t y = 0; y < height; y++)
+	{
+		for (int32_t x = 0; x < width; x++)
+		{
+			int32_t difference = std::abs((int32_t)gpu[(size_t)y * gpuStride + x] - (int32_t)cpu[(size_t)y * cpuStride + x]);
+			if (difference != 0)
+			{
+				result.MismatchedBytes++;
+				result.MaxDifference = std::max(result.MaxDifference, difference);
+			}
+		}
+	}
+	return result;
+}
+
+static bool TestConversion(RendererType api, glm::ivec2 frameSize, uint32_t seed)
+{
+	auto source = Renderer::CreateFrameBuffer(glm::vec2(frameSize));
+	auto yuvFrameBuffer = Renderer::CreateFrameBuffer(glm::vec2(YUV420Layout(frameSize).TargetSize));
+
+	Rectangle viewport = { 0, 0, frameSize.x, frameSize.y };
+	Renderer::SetViewport(viewport);
+	SceneDescription desc;
+	desc.SceneCamera.Update(0.0f, viewport);
+	desc.SceneDrawTarget = &source;
+	desc.Blur = false;
+
+	//overlapping quads of every color give hard edges and smooth blends for the chroma subsampling
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> positionDist(-500.0f, 500.0f);
+	std::uniform_real_distribution<float> unitDist(0.0f, 1.0f);
+
+	Renderer::BeginScene(desc);
+	source->Bind();
+	Renderer::ClearScreen();
+	for (int32_t i = 0; i < 2000; i++)
+	{
+		glm::vec2 position = glm::vec2(positionDist(rng), positionDist(rng));
+		glm::vec4 color = glm::vec4(unitDist(rng), unitDist(rng), unitDist(rng), unitDist(rng));
+		Renderer::DrawQuad(position, color, 5.0f + unitDist(rng) * 40.0f, unitDist(rng) * 6.28318f);
+	}
+	Renderer::EndScene();
+
+	bool flipVertically = api == RendererType::OpenGL;
+	Image rgba = source->ReadPixels();
+	Renderer::ConvertToYUV420(source, yuvFrameBuffer, flipVertically);
+	Image packed = yuvFrameBuffer->ReadPixels();
+
+	//convert the same pixels the way the encoder does, with a negative stride for bottom to top rows
+	YUV420Layout layout(frameSize);
+	const int32_t rowSize = frameSize.x * 4;
+	const uint8_t* rgbaData = rgba.m_Data;
+	int32_t rgbaStride = rowSize;
+	if (flipVertically)
+	{
+		rgbaData = rgba.m_Data + (size_t)(frameSize.y - 1) * rowSize;
+		rgbaStride = -rowSize;
+	}
+
+	std::vector<uint8_t> yPlane((size_t)layout.VideoSize.x * layout.VideoSize.y);
+	std::vector<uint8_t> uPlane((size_t)layout.VideoSize.x / 2 * layout.VideoSize.y / 2);
+	std::vector<uint8_t> vPlane(uPlane.size());
+	uint8_t* planes[3] = { yPlane.data(), uPlane.data(), vPlane.data() };
+	int32_t strides[3] = { layout.VideoSize.x, layout.VideoSize.x / 2, layout.VideoSize.x / 2 };
+
+	SwsContext* converter = VideoEncoder::CreateRGBAConverter(layout.VideoSize.x, layout.VideoSize.y);
+	if (!converter)
+	{
+		printf("could not create the swscale converter\n");
+		return false;
+	}
+	sws_scale(converter, &rgbaData, &rgbaStride, 0, layout.VideoSize.y, planes, strides);
+	sws_freeContext(converter);
+
+	PlaneDifference differences[3] =
+	{
+		ComparePlane(packed.m_Data, layout.LumaStride, yPlane.data(), strides[0], layout.VideoSize.x, layout.VideoSize.y),
+		ComparePlane(packed.m_Data + layout.UOffset, layout.ChromaStride, uPlane.data(), strides[1], layout.VideoSize.x / 2, layout.VideoSize.y / 2),
+		ComparePlane(packed.m_Data + layout.VOffset, layout.ChromaStride, vPlane.data(), strides[2], layout.VideoSize.x / 2, layout.VideoSize.y / 2)
+	};
+
+	bool passed = true;
+	const char* planeNames[3] = { "y", "u", "v" };
+	for (int32_t i = 0; i < 3; i++)
+	{
+		printf("%dx%d %s plane: %llu mismatched bytes, max difference %d\n", frameSize.x, frameSize.y, planeNames[i],
+			(unsigned long long)differences[i].MismatchedBytes, differences[i].MaxDifference);
+		passed = passed && differences[i].MismatchedBytes == 0;
+	}
+	return passed;
+}
+
+int main(int argc, char* argv[])
+{
+	RendererType api = RendererType::OpenGL;
+#ifdef PLATFORM_WINDOWS
+	if (argc > 1 && std::string(argv[1]) == "d3d11")
+		api = RendererType::D3D11;
+#endif // PLATFORM_WINDOWS
+
+	Window::Init(api);
+	Renderer::Init(api);
+
+	//a width that isn't a multiple of 8 covers the padding at the end of the packed rows,
+	//odd sizes cover the row and column the video drops, the smallest size has the shortest full chroma filter
+	bool passed = true;
+	passed = TestConversion(api, glm::ivec2(318, 180), 1234) && passed;
+	passed = TestConversion(api, glm::ivec2(1281, 721), 5678) && passed;
+	passed = TestConversion(api, glm::ivec2(c_MinGPUYUVConversionHeight * 2, c_MinGPUYUVConversionHeight), 91011) && passed;
+	printf(passed ? "PASSED\n" : "FAILED\n");
+
+	Renderer::Terminate();
+	Window::Terminate();
+
+	return passed ? 0 : 1;
+}
@@ -1,6 +1,6 @@
 #include <Windows.h>
 
-extern int main();
+extern int main(int argc, char* argv[]);
 
 int WinMain(
 	HINSTANCE hInstance,
@@ -14,8 +14,11 @@ int WinMain(
 	AllocConsole();
 	FILE* file;
 	freopen_s(&file, "CONOUT$", "w", stdout);
+	//the log writes to stderr
+	freopen_s(&file, "CONOUT$", "w", stderr);
 
 #endif // DEBUG
 
-	return main();
+	//msvc keeps the parsed command line in __argc and __argv for WIN32 apps too
+	return main(__argc, __argv);
 }
\ No newline at end of file